@@ -0,0 +1,78 @@
+#include "bench.h"
+#include "bench_archives.h"
+
+#include <cstdio>
+
+#include "io/terrain/adt_tile.h"
+
+using namespace wow;
+
+namespace {
+    constexpr size_t MAX_TILES = 64;
+
+    struct adt_source {
+        uint32_t x;
+        uint32_t y;
+        utils::binary_reader_ptr reader;
+    };
+}
+
+WOW_BENCH(adt_parse) {
+    const auto data = bench::data_path();
+    if (!data) {
+        bench::skip("set WOW_UNIX_DATA to a client folder containing Data/*.MPQ");
+        return;
+    }
+
+    const bench::bench_archives archives{*data};
+    const auto wdt_file = archives.open(R"(World\Maps\Azeroth\Azeroth.wdt)");
+    if (!wdt_file) {
+        bench::skip("Azeroth.wdt not found");
+        return;
+    }
+
+    const auto wdt = io::terrain::make_wdt(wdt_file->to_binary_reader());
+
+    std::vector<adt_source> sources{};
+    size_t total_bytes = 0;
+    for (const auto &name: archives.find(R"(World\Maps\Azeroth\Azeroth_*.adt)", MAX_TILES)) {
+        uint32_t x = 0, y = 0;
+        const auto stem = name.substr(name.find_last_of('\\') + 1);
+        if (std::sscanf(stem.c_str(), "Azeroth_%u_%u.adt", &x, &y) != 2) {
+            continue;
+        }
+
+        if (const auto file = archives.open(name)) {
+            total_bytes += file->size();
+            sources.push_back({x, y, file->to_binary_reader()});
+        }
+    }
+
+    if (sources.empty()) {
+        bench::skip("no Azeroth ADT files found");
+        return;
+    }
+
+    utils::work_pool pool{};
+    size_t parsed = 0;
+    const auto parse_all = [&] {
+        parsed = 0;
+        for (const auto &[x, y, reader]: sources) {
+            const auto tile = std::make_shared<io::terrain::adt_tile>(wdt, x, y, reader, nullptr);
+            parsed += tile->parse(pool) ? 1 : 0;
+        }
+    };
+
+    const auto allocations_before = bench::allocation_count();
+    parse_all();
+    const auto allocations = bench::allocation_count() - allocations_before;
+
+    const auto result = bench::measure(parse_all);
+    const auto seconds = result.per_iteration();
+    const auto tiles = static_cast<double>(sources.size());
+
+    bench::report("tiles parsed", static_cast<double>(parsed), "tiles");
+    bench::report("parse throughput", static_cast<double>(total_bytes) / seconds / (1024.0 * 1024.0), "MB/s");
+    bench::report("parse time per tile", seconds / tiles * 1e3, "ms");
+    bench::report("allocations per tile", static_cast<double>(allocations) / tiles, "allocs");
+}
@@ -0,0 +1,171 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <array>
+#include <random>
+
+#include "io/terrain/alpha_map.h"
+#include "utils/io.h"
+
+using namespace wow;
+using namespace wow::io::terrain;
+
+namespace {
+    constexpr size_t CHUNKS_PER_BATCH = 256;
+    constexpr size_t FOUR_BIT_SIZE = 63 * 32;
+    constexpr size_t SHADOW_SIZE = ALPHA_MAP_TEXELS / 8;
+
+    struct chunk_source {
+        std::vector<uint8_t> first_layer{};
+        std::vector<uint8_t> second_layer{};
+        std::vector<uint8_t> third_layer{};
+        std::vector<uint8_t> shadow{};
+    };
+
+    chunk_source make_chunk(std::mt19937 &rng) {
+        std::uniform_int_distribution<int> byte{0, 255};
+        std::uniform_int_distribution<int> run{1, 0x7F};
+
+        chunk_source chunk{};
+        for (auto *layer: {&chunk.first_layer, &chunk.second_layer}) {
+            layer->resize(FOUR_BIT_SIZE);
+            std::ranges::generate(*layer, [&] { return static_cast<uint8_t>(byte(rng)); });
+        }
+
+        size_t written = 0;
+        while (written < ALPHA_MAP_TEXELS) {
+            const auto length = std::min<size_t>(run(rng), ALPHA_MAP_TEXELS - written);
+            if (byte(rng) < 192) {
+                chunk.third_layer.push_back(static_cast<uint8_t>(0x80 | length));
+                chunk.third_layer.push_back(static_cast<uint8_t>(byte(rng)));
+            } else {
+                chunk.third_layer.push_back(static_cast<uint8_t>(length));
+                for (auto i = 0u; i < length; ++i) {
+                    chunk.third_layer.push_back(static_cast<uint8_t>(byte(rng)));
+                }
+            }
+
+            written += length;
+        }
+
+        chunk.shadow.resize(SHADOW_SIZE);
+        std::ranges::generate(chunk.shadow, [&] { return static_cast<uint8_t>(byte(rng)); });
+        return chunk;
+    }
+
+    void legacy_4bit(utils::binary_reader &reader, const uint32_t layer, uint32_t *texels) {
+        auto out = texels;
+        for (auto k = 0; k < 63; ++k) {
+            for (auto j = 0; j < 32; ++j) {
+                const auto value = reader.read<uint8_t>();
+                auto low = static_cast<uint8_t>(value & 0x0F);
+                auto high = static_cast<uint8_t>(j == 31 ? low : value >> 4);
+                low = static_cast<uint8_t>(low * 17);
+                high = static_cast<uint8_t>(high * 17);
+                *out++ |= static_cast<uint32_t>(low) << (layer * 8);
+                *out++ |= static_cast<uint32_t>(high) << (layer * 8);
+            }
+        }
+
+        for (auto j = 0; j < 64; ++j) {
+            texels[63 * 64 + j] |= ((texels[62 * 64 + j] >> (layer * 8)) & 0xFF) << (layer * 8);
+        }
+    }
+
+    void legacy_rle(utils::binary_reader &reader, const uint32_t layer, uint32_t *texels) {
+        auto read = 0u;
+        while (read < ALPHA_MAP_TEXELS) {
+            const auto indicator = reader.read<uint8_t>();
+            const auto repeat = indicator & 0x7F;
+            if ((indicator & 0x80) != 0) {
+                const auto value = static_cast<uint32_t>(reader.read<uint8_t>());
+                for (auto i = 0; i < repeat && read < ALPHA_MAP_TEXELS; ++i) {
+                    texels[read++] |= value << (layer * 8);
+                }
+            } else {
+                for (auto i = 0; i < repeat && read < ALPHA_MAP_TEXELS; ++i) {
+                    texels[read++] |= static_cast<uint32_t>(reader.read<uint8_t>()) << (layer * 8);
+                }
+            }
+        }
+    }
+
+    void legacy_shadows(utils::binary_reader &reader, uint32_t *texels) {
+        for (auto i = 0u; i < ALPHA_MAP_TEXELS; ++i) {
+            texels[i] &= 0x00FFFFFF;
+        }
+
+        for (auto i = 0; i < 64; ++i) {
+            auto value = reader.read<uint64_t>();
+            for (auto j = 0; j < 64; ++j) {
+                texels[i * 64 + j] |= ((value & 0x1) ? 0xFFu : 0x00u) << 24;
+                value >>= 1;
+            }
+        }
+    }
+
+    void legacy_chunk(const chunk_source &chunk, std::vector<uint32_t> &texels) {
+        texels.assign(ALPHA_MAP_TEXELS, 0);
+
+        utils::binary_reader first{std::span<const uint8_t>{chunk.first_layer}};
+        legacy_4bit(first, 0, texels.data());
+        utils::binary_reader second{std::span<const uint8_t>{chunk.second_layer}};
+        legacy_4bit(second, 1, texels.data());
+        utils::binary_reader third{std::span<const uint8_t>{chunk.third_layer}};
+        legacy_rle(third, 2, texels.data());
+        utils::binary_reader shadow{std::span<const uint8_t>{chunk.shadow}};
+        legacy_shadows(shadow, texels.data());
+    }
+
+    void fused_chunk(const alpha_kernel kernel, const chunk_source &chunk, uint32_t *texels) {
+        std::array<std::array<uint8_t, ALPHA_MAP_TEXELS>, 3> planes{};
+        decode_alpha_4bit(kernel, chunk.first_layer, false, planes[0].data());
+        decode_alpha_4bit(kernel, chunk.second_layer, false, planes[1].data());
+        decode_alpha_rle(chunk.third_layer, planes[2].data());
+
+        alpha_shadow_source source{};
+        for (auto i = 0u; i < planes.size(); ++i) {
+            source.alpha[i] = planes[i].data();
+        }
+
+        source.shadow = chunk.shadow.data();
+        pack_alpha_shadow(kernel, source, texels);
+    }
+
+    void report(const std::string &label, const bench::measurement &result) {
+        const auto chunks = static_cast<double>(result.iterations * CHUNKS_PER_BATCH);
+        bench::report(label, result.seconds / chunks * 1e9, "ns/chunk");
+        bench::report(label, chunks * ALPHA_MAP_TEXELS / result.seconds / 1e6, "Mtexel/s");
+    }
+}
+
+WOW_BENCH(alpha_shadow_pack) {
+    std::mt19937 rng{0x4D43414C};
+    std::vector<chunk_source> chunks{};
+    for (auto i = 0u; i < CHUNKS_PER_BATCH; ++i) {
+        chunks.push_back(make_chunk(rng));
+    }
+
+    std::vector<uint32_t> legacy_texels{};
+    report("multi-pass (binary_reader, per-bit shadow)", bench::measure([&] {
+        for (const auto &chunk: chunks) {
+            legacy_chunk(chunk, legacy_texels);
+            bench::do_not_optimize(legacy_texels.data());
+        }
+    }));
+
+    std::vector<uint32_t> staging(ALPHA_MAP_TEXELS * CHUNKS_PER_BATCH);
+    for (const auto kernel: {alpha_kernel::scalar, alpha_kernel::sse2, alpha_kernel::avx2}) {
+        if (!is_alpha_kernel_supported(kernel)) {
+            continue;
+        }
+
+        report("fused " + std::string(alpha_kernel_name(kernel)), bench::measure([&] {
+            for (auto i = 0u; i < chunks.size(); ++i) {
+                fused_chunk(kernel, chunks[i], staging.data() + i * ALPHA_MAP_TEXELS);
+            }
+
+            bench::do_not_optimize(staging.data());
+        }));
+    }
+}
@@ -0,0 +1,46 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <random>
+
+#include "io/blp/bc_decoder.h"
+
+using namespace wow::io::blp;
+
+namespace {
+    struct bc_format {
+        const char *name;
+        size_t block_size;
+        void (*decode)(std::span<const uint8_t>, uint32_t, uint32_t, uint8_t *);
+    };
+
+    constexpr bc_format FORMATS[] = {
+        {"BC1", 8, decode_bc1},
+        {"BC2", 16, decode_bc2},
+        {"BC3", 16, decode_bc3}
+    };
+
+    constexpr uint32_t SIZES[] = {64, 256, 1024};
+}
+
+WOW_BENCH(bc_decode) {
+    std::mt19937 rng{0x42433144};
+    std::uniform_int_distribution<int> byte{0, 255};
+
+    for (const auto &[name, block_size, decode]: FORMATS) {
+        for (const auto size: SIZES) {
+            std::vector<uint8_t> blocks((size / 4) * (size / 4) * block_size);
+            std::ranges::generate(blocks, [&] { return static_cast<uint8_t>(byte(rng)); });
+            std::vector<uint8_t> rgba(static_cast<size_t>(size) * size * 4);
+
+            const auto result = wow::bench::measure([&] {
+                decode(blocks, size, size, rgba.data());
+                wow::bench::do_not_optimize(rgba.data());
+            });
+
+            const auto pixels = static_cast<double>(size) * size;
+            wow::bench::report(std::string(name) + " " + std::to_string(size) + "x" + std::to_string(size),
+                               pixels / result.per_iteration() / 1e6, "MPixel/s");
+        }
+    }
+}
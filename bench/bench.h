@@ -0,0 +1,63 @@
+#ifndef WOW_UNIX_BENCH_H
+#define WOW_UNIX_BENCH_H
+
+#include <chrono>
+#include <filesystem>
+#include <functional>
+#include <optional>
+#include <string>
+#include <vector>
+
+namespace wow::bench {
+    struct bench_case {
+        std::string name{};
+        std::function<void()> body{};
+    };
+
+    struct measurement {
+        double seconds{};
+        size_t iterations{};
+
+        [[nodiscard]] double per_iteration() const {
+            return iterations > 0 ? seconds / static_cast<double>(iterations) : 0.0;
+        }
+    };
+
+    std::vector<bench_case> &registry();
+
+    measurement measure(const std::function<void()> &body,
+                        std::chrono::milliseconds min_time = std::chrono::milliseconds{500});
+
+    void report(const std::string &label, double value, const std::string &unit);
+
+    void note(const std::string &text);
+
+    void skip(const std::string &reason);
+
+    std::optional<std::filesystem::path> data_path();
+
+    size_t peak_rss();
+
+    size_t allocation_count();
+
+    size_t live_allocation_bytes();
+
+    size_t peak_allocation_bytes();
+
+    void reset_peak_allocation_bytes();
+
+    void do_not_optimize(const void *value);
+
+    struct bench_registrar {
+        bench_registrar(const std::string &name, std::function<void()> body) {
+            registry().push_back({name, std::move(body)});
+        }
+    };
+}
+
+#define WOW_BENCH(name) \
+    static void name(); \
+    static const wow::bench::bench_registrar name##_registrar{#name, name}; \
+    static void name()
+
+#endif //WOW_UNIX_BENCH_H
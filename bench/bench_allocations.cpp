@@ -0,0 +1,66 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdlib>
+#include <new>
+
+namespace wow::bench {
+    namespace {
+        constexpr size_t ALLOCATION_HEADER = alignof(std::max_align_t);
+
+        std::atomic_size_t allocations = 0;
+        std::atomic_size_t live_bytes = 0;
+        std::atomic_size_t peak_bytes = 0;
+
+        void track_allocation(const size_t size) {
+            allocations.fetch_add(1, std::memory_order_relaxed);
+            const auto live = live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+            auto peak = peak_bytes.load(std::memory_order_relaxed);
+            while (live > peak && !peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+            }
+        }
+    }
+
+    size_t allocation_count() {
+        return allocations.load(std::memory_order_relaxed);
+    }
+
+    size_t live_allocation_bytes() {
+        return live_bytes.load(std::memory_order_relaxed);
+    }
+
+    size_t peak_allocation_bytes() {
+        return peak_bytes.load(std::memory_order_relaxed);
+    }
+
+    void reset_peak_allocation_bytes() {
+        peak_bytes.store(live_bytes.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    }
+}
+
+void *operator new(const std::size_t size) {
+    const auto block = static_cast<std::byte *>(std::malloc(size + wow::bench::ALLOCATION_HEADER));
+    if (!block) {
+        throw std::bad_alloc{};
+    }
+
+    *reinterpret_cast<std::size_t *>(block) = size;
+    wow::bench::track_allocation(size);
+    return block + wow::bench::ALLOCATION_HEADER;
+}
+
+void operator delete(void *pointer) noexcept {
+    if (!pointer) {
+        return;
+    }
+
+    const auto block = static_cast<std::byte *>(pointer) - wow::bench::ALLOCATION_HEADER;
+    wow::bench::live_bytes.fetch_sub(*reinterpret_cast<std::size_t *>(block), std::memory_order_relaxed);
+    std::free(block);
+}
+
+void operator delete(void *pointer, std::size_t) noexcept {
+    operator delete(pointer);
+}
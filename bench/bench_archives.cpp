@@ -0,0 +1,68 @@
+#include "bench_archives.h"
+
+#include <algorithm>
+#include <set>
+
+#include "StormLib.h"
+#include "utils/string_utils.h"
+
+namespace wow::bench {
+    bench_archives::bench_archives(const std::filesystem::path &data_path) {
+        std::vector<std::filesystem::path> files{};
+        for (const auto &entry: std::filesystem::recursive_directory_iterator(data_path / "Data")) {
+            if (entry.is_regular_file() && utils::to_lower(entry.path().extension().string()) == ".mpq") {
+                files.push_back(entry.path());
+            }
+        }
+
+        std::ranges::sort(files, [](const auto &a, const auto &b) {
+            return utils::to_lower(a.stem().string()) > utils::to_lower(b.stem().string());
+        });
+
+        for (const auto &file: files) {
+            HANDLE handle{};
+            if (SFileOpenArchive(file.string().c_str(), 0, MPQ_OPEN_READ_ONLY, &handle)) {
+                _archives.push_back(handle);
+            }
+        }
+    }
+
+    bench_archives::~bench_archives() {
+        for (const auto handle: _archives) {
+            SFileCloseArchive(handle);
+        }
+    }
+
+    io::mpq_file_ptr bench_archives::open(const std::string &path, const size_t offset, const size_t size) const {
+        for (const auto archive: _archives) {
+            HANDLE file{};
+            if (SFileOpenFileEx(archive, path.c_str(), 0, &file)) {
+                return std::make_shared<io::mpq_file>(file, nullptr, 0, offset, size);
+            }
+        }
+
+        return nullptr;
+    }
+
+    std::vector<std::string> bench_archives::find(const std::string &mask, const size_t limit) const {
+        std::set<std::string> found{};
+        for (const auto archive: _archives) {
+            SFILE_FIND_DATA find_data{};
+            const auto find_handle = SFileFindFirstFile(archive, mask.c_str(), &find_data, nullptr);
+            if (!find_handle) {
+                continue;
+            }
+
+            do {
+                found.insert(find_data.cFileName);
+            } while (found.size() < limit && SFileFindNextFile(find_handle, &find_data));
+
+            SFileFindClose(find_handle);
+            if (found.size() >= limit) {
+                break;
+            }
+        }
+
+        return {found.begin(), found.end()};
+    }
+}
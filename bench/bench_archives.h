@@ -0,0 +1,36 @@
+#ifndef WOW_UNIX_BENCH_ARCHIVES_H
+#define WOW_UNIX_BENCH_ARCHIVES_H
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "StormPort.h"
+#include "io/mpq_file.h"
+
+namespace wow::bench {
+    class bench_archives {
+        std::vector<HANDLE> _archives{};
+
+    public:
+        explicit bench_archives(const std::filesystem::path &data_path);
+
+        ~bench_archives();
+
+        bench_archives(const bench_archives &) = delete;
+
+        bench_archives &operator=(const bench_archives &) = delete;
+
+        [[nodiscard]] bool empty() const {
+            return _archives.empty();
+        }
+
+        [[nodiscard]] io::mpq_file_ptr open(const std::string &path, size_t offset = 0,
+                                            size_t size = io::MPQ_FILE_TO_END) const;
+
+        [[nodiscard]] std::vector<std::string> find(const std::string &mask, size_t limit) const;
+    };
+}
+
+#endif //WOW_UNIX_BENCH_ARCHIVES_H
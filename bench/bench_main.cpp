@@ -0,0 +1,103 @@
+#include "bench.h"
+
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+
+#include "spdlog/spdlog.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#include <psapi.h>
+#else
+#include <sys/resource.h>
+#endif
+
+namespace wow::bench {
+    namespace {
+        volatile const void *optimization_sink = nullptr;
+    }
+
+    std::vector<bench_case> &registry() {
+        static std::vector<bench_case> benches{};
+        return benches;
+    }
+
+    measurement measure(const std::function<void()> &body, const std::chrono::milliseconds min_time) {
+        body();
+
+        measurement result{};
+        const auto start = std::chrono::steady_clock::now();
+        auto elapsed = std::chrono::steady_clock::duration{};
+        while (elapsed < min_time) {
+            body();
+            ++result.iterations;
+            elapsed = std::chrono::steady_clock::now() - start;
+        }
+
+        result.seconds = std::chrono::duration<double>(elapsed).count();
+        return result;
+    }
+
+    void report(const std::string &label, const double value, const std::string &unit) {
+        std::cout << "    " << std::left << std::setw(56) << label << std::right << std::setw(14) << std::fixed
+                << std::setprecision(2) << value << " " << unit << std::endl;
+    }
+
+    void note(const std::string &text) {
+        std::cout << "    " << text << std::endl;
+    }
+
+    void skip(const std::string &reason) {
+        std::cout << "    skipped: " << reason << std::endl;
+    }
+
+    std::optional<std::filesystem::path> data_path() {
+        const auto path = std::getenv("WOW_UNIX_DATA");
+        if (!path || !std::filesystem::is_directory(std::filesystem::path{path} / "Data")) {
+            return std::nullopt;
+        }
+
+        return std::filesystem::path{path};
+    }
+
+    size_t peak_rss() {
+#ifdef _WIN32
+        PROCESS_MEMORY_COUNTERS counters{};
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return 0;
+        }
+
+        return counters.PeakWorkingSetSize;
+#else
+        rusage usage{};
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return 0;
+        }
+
+        return static_cast<size_t>(usage.ru_maxrss) * 1024;
+#endif
+    }
+
+    void do_not_optimize(const void *value) {
+        optimization_sink = value;
+    }
+}
+
+int main(const int argc, char *argv[]) {
+    using namespace wow::bench;
+
+    spdlog::set_level(spdlog::level::warn);
+
+    const std::string filter = argc > 1 ? argv[1] : "";
+    for (const auto &[name, body]: registry()) {
+        if (!filter.empty() && name.find(filter) == std::string::npos) {
+            continue;
+        }
+
+        std::cout << "[ BENCH ] " << name << std::endl;
+        body();
+    }
+
+    return 0;
+}
@@ -0,0 +1,99 @@
+#include "bench.h"
+#include "bench_archives.h"
+
+#include <algorithm>
+
+#include "io/blp/blp_file.h"
+
+using namespace wow;
+
+namespace {
+    constexpr size_t MAX_TEXTURES = 64;
+    constexpr uint32_t MINIMAP_DIMENSION = 64;
+
+    struct decode_stats {
+        size_t peak_bytes = 0;
+        size_t allocations = 0;
+        size_t decoded_bytes = 0;
+    };
+
+    template<typename Decode>
+    decode_stats run(const std::vector<std::string> &textures, const Decode &decode) {
+        decode_stats stats{};
+        for (const auto &name: textures) {
+            const auto live_before = bench::live_allocation_bytes();
+            const auto allocations_before = bench::allocation_count();
+            bench::reset_peak_allocation_bytes();
+
+            const auto pixels = decode(name);
+            bench::do_not_optimize(pixels.data());
+
+            stats.peak_bytes = std::max(stats.peak_bytes, bench::peak_allocation_bytes() - live_before);
+            stats.allocations += bench::allocation_count() - allocations_before;
+            stats.decoded_bytes += pixels.size();
+        }
+
+        return stats;
+    }
+
+    void report(const std::string &label, const decode_stats &stats, const size_t textures,
+                const bench::measurement &timing) {
+        const auto count = static_cast<double>(textures);
+        bench::report(label + " peak heap", static_cast<double>(stats.peak_bytes) / 1024.0, "KB");
+        bench::report(label + " allocations", static_cast<double>(stats.allocations) / count, "allocs/texture");
+        bench::report(label + " RGBA output", static_cast<double>(stats.decoded_bytes) / count / 1024.0,
+                      "KB/texture");
+        bench::report(label + " decode", timing.per_iteration() / count * 1e6, "us/texture");
+    }
+}
+
+WOW_BENCH(blp_decode_memory) {
+    const auto data = bench::data_path();
+    if (!data) {
+        bench::skip("set WOW_UNIX_DATA to a client folder containing Data/*.MPQ");
+        return;
+    }
+
+    const bench::bench_archives archives{*data};
+    std::vector<std::string> textures{};
+    for (const auto &mask: {R"(Tileset\*.blp)", R"(Textures\Minimap\*.blp)"}) {
+        for (auto &name: archives.find(mask, MAX_TEXTURES / 2)) {
+            textures.push_back(std::move(name));
+        }
+    }
+
+    if (textures.empty()) {
+        bench::skip("no tileset or minimap BLP files found");
+        return;
+    }
+
+    const auto eager_full = [&](const std::string &name) {
+        const io::blp::blp_file blp{archives.open(name)};
+        return blp.convert_to_rgba();
+    };
+
+    const auto lazy_full = [&](const std::string &name) {
+        const io::blp::blp_file blp{[&](const size_t offset, const size_t size) {
+            return archives.open(name, offset, size);
+        }};
+        return blp.convert_to_rgba();
+    };
+
+    const auto lazy_minimap = [&](const std::string &name) {
+        const io::blp::blp_file blp{[&](const size_t offset, const size_t size) {
+            return archives.open(name, offset, size);
+        }};
+
+        uint32_t w = 0, h = 0;
+        return blp.convert_to_rgba(MINIMAP_DIMENSION, w, h);
+    };
+
+    bench::note("textures: " + std::to_string(textures.size()));
+
+    report("whole entry, level 0", run(textures, eager_full), textures.size(),
+           bench::measure([&] { run(textures, eager_full); }));
+    report("ranged mips, level 0", run(textures, lazy_full), textures.size(),
+           bench::measure([&] { run(textures, lazy_full); }));
+    report("ranged mips, " + std::to_string(MINIMAP_DIMENSION) + "px", run(textures, lazy_minimap),
+           textures.size(), bench::measure([&] { run(textures, lazy_minimap); }));
+}
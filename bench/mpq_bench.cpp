@@ -0,0 +1,134 @@
+#include "bench.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <thread>
+
+#include "StormLib.h"
+#include "io/mpq_directory.h"
+#include "io/mpq_file.h"
+#include "io/mpq_handle_pool.h"
+#include "utils/mapped_file.h"
+
+using namespace wow;
+
+namespace {
+    constexpr size_t MAX_FILES = 512;
+
+    std::optional<std::filesystem::path> largest_archive(const std::filesystem::path &data) {
+        std::optional<std::filesystem::path> largest{};
+        uintmax_t largest_size = 0;
+        for (const auto &entry: std::filesystem::directory_iterator(data / "Data")) {
+            auto extension = entry.path().extension().string();
+            std::ranges::transform(extension, extension.begin(), [](const char c) { return std::tolower(c); });
+            if (!entry.is_regular_file() || extension != ".mpq") {
+                continue;
+            }
+
+            if (entry.file_size() > largest_size) {
+                largest_size = entry.file_size();
+                largest = entry.path();
+            }
+        }
+
+        return largest;
+    }
+
+    std::vector<std::string> sample_files(const HANDLE archive) {
+        const auto listing = io::mpq_directory::list_archive(archive);
+        std::vector<std::string> files{listing.files.begin(), listing.files.end()};
+        std::erase_if(files, [](const std::string &file) {
+            return !file.ends_with(".blp") && !file.ends_with(".adt") && !file.ends_with(".m2");
+        });
+
+        std::ranges::sort(files);
+        if (files.size() > MAX_FILES) {
+            std::vector<std::string> sampled{};
+            const auto stride = files.size() / MAX_FILES;
+            for (auto i = 0u; i < MAX_FILES; ++i) {
+                sampled.push_back(files[i * stride]);
+            }
+
+            files = std::move(sampled);
+        }
+
+        return files;
+    }
+
+    size_t read_all(io::mpq_handle_pool &pool, const utils::mapped_file_ptr &mapping, const uint64_t header_offset,
+                    const std::vector<std::string> &files, const size_t thread_count) {
+        std::atomic_size_t next_file = 0;
+        std::atomic_size_t total_bytes = 0;
+
+        std::vector<std::thread> threads{};
+        for (auto i = 0u; i < thread_count; ++i) {
+            threads.emplace_back([&] {
+                size_t bytes = 0;
+                for (auto index = next_file++; index < files.size(); index = next_file++) {
+                    const auto handle = pool.acquire();
+                    HANDLE file_handle{};
+                    if (!SFileOpenFileEx(handle.get(), files[index].c_str(), 0, &file_handle)) {
+                        continue;
+                    }
+
+                    const io::mpq_file file{file_handle, mapping, header_offset};
+                    bytes += file.size();
+                }
+
+                total_bytes += bytes;
+            });
+        }
+
+        std::ranges::for_each(threads, [](auto &thread) { thread.join(); });
+        return total_bytes;
+    }
+}
+
+WOW_BENCH(mpq_concurrent_open) {
+    const auto data = bench::data_path();
+    if (!data) {
+        bench::skip("set WOW_UNIX_DATA to a client folder containing Data/*.MPQ");
+        return;
+    }
+
+    const auto archive_path = largest_archive(*data);
+    if (!archive_path) {
+        bench::skip("no MPQ archives found in " + (*data / "Data").string());
+        return;
+    }
+
+    const auto hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (const auto pool_size: {size_t{1}, static_cast<size_t>(hardware_threads)}) {
+        HANDLE primary{};
+        if (!SFileOpenArchive(archive_path->string().c_str(), 0, MPQ_OPEN_READ_ONLY, &primary)) {
+            bench::skip("cannot open " + archive_path->string());
+            return;
+        }
+
+        ULONGLONG header_offset = 0;
+        SFileGetFileInfo(primary, SFileMpqHeaderOffset, &header_offset, sizeof(header_offset), nullptr);
+
+        const auto files = sample_files(primary);
+        if (files.empty()) {
+            SFileCloseArchive(primary);
+            bench::skip(archive_path->filename().string() + " has no listfile");
+            return;
+        }
+
+        io::mpq_handle_pool pool{archive_path->string(), primary, pool_size};
+        const auto mapping = utils::make_mapped_file(archive_path->string());
+
+        for (auto threads = 1u; threads <= hardware_threads; threads *= 2) {
+            size_t bytes = 0;
+            const auto result = bench::measure([&] {
+                bytes = read_all(pool, mapping, header_offset, files, threads);
+            });
+
+            const auto seconds = result.per_iteration();
+            const auto label = std::to_string(pool_size) + " handle(s), " + std::to_string(threads) + " thread(s)";
+            bench::report(label, static_cast<double>(bytes) / seconds / (1024.0 * 1024.0), "MB/s");
+            bench::report(label, static_cast<double>(files.size()) / seconds, "open/s");
+        }
+    }
+}
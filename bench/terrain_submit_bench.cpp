@@ -0,0 +1,210 @@
+#include "bench.h"
+
+#include <functional>
+#include <numeric>
+
+#include "gl/egl_context.h"
+#include "gl/indirect_buffer.h"
+#include "io/terrain/adt_chunk.h"
+#include "io/terrain/terrain_lod.h"
+
+using namespace wow;
+
+namespace {
+    constexpr uint32_t TILE_RADIUS = 3;
+    constexpr uint32_t TILE_COUNT = (TILE_RADIUS * 2 + 1) * (TILE_RADIUS * 2 + 1);
+    constexpr uint32_t CHUNKS_PER_TILE = 256;
+    constexpr uint32_t VERTICES_PER_CHUNK = 145;
+    constexpr GLsizei TARGET_SIZE = 256;
+    constexpr uint32_t SUBMIT_LOD = io::terrain::TERRAIN_LOD_COUNT - 1;
+
+    constexpr auto VERTEX_SHADER = R"(#version 430
+in float height0;
+uniform vec2 tile_origin;
+const float CHUNK_SIZE = (533.0 + 1.0 / 3.0) / 16.0;
+const float VERTEX_SIZE = CHUNK_SIZE / 8.0;
+void main() {
+    int chunk = gl_VertexID / 145;
+    int vertex = gl_VertexID % 145;
+    int row = vertex / 17;
+    int column = vertex % 17;
+    vec2 grid = column < 9 ? vec2(column, row) : vec2(float(column - 9) + 0.5, float(row) + 0.5);
+    vec2 position = tile_origin + vec2(chunk % 16, chunk / 16) * CHUNK_SIZE + grid * VERTEX_SIZE;
+    gl_Position = vec4(position / (CHUNK_SIZE * 16.0 * 7.0) - 0.5, height0, 1.0);
+}
+)";
+
+    constexpr auto FRAGMENT_SHADER = R"(#version 430
+out vec4 color;
+void main() {
+    color = vec4(1.0);
+}
+)";
+
+    GLuint compile(const GLenum type, const char *source) {
+        const auto shader = glCreateShader(type);
+        glShaderSource(shader, 1, &source, nullptr);
+        glCompileShader(shader);
+        return shader;
+    }
+
+    struct terrain_scene {
+        GLuint program{};
+        GLint origin_uniform{};
+        GLuint vertex_array{};
+        GLuint index_buffer{};
+        GLuint framebuffer{};
+        GLuint color{};
+        std::vector<GLuint> vertex_buffers{};
+        std::vector<gl::indirect_buffer_ptr> indirect_buffers{};
+        io::terrain::terrain_lod_table lod_table{};
+
+        terrain_scene() {
+            program = glCreateProgram();
+            const auto vertex = compile(GL_VERTEX_SHADER, VERTEX_SHADER);
+            const auto fragment = compile(GL_FRAGMENT_SHADER, FRAGMENT_SHADER);
+            glAttachShader(program, vertex);
+            glAttachShader(program, fragment);
+            glBindAttribLocation(program, 0, "height0");
+            glLinkProgram(program);
+            glDeleteShader(vertex);
+            glDeleteShader(fragment);
+            origin_uniform = glGetUniformLocation(program, "tile_origin");
+
+            glGenRenderbuffers(1, &color);
+            glBindRenderbuffer(GL_RENDERBUFFER, color);
+            glRenderbufferStorage(GL_RENDERBUFFER, GL_RGBA8, TARGET_SIZE, TARGET_SIZE);
+            glGenFramebuffers(1, &framebuffer);
+            glBindFramebuffer(GL_FRAMEBUFFER, framebuffer);
+            glFramebufferRenderbuffer(GL_FRAMEBUFFER, GL_COLOR_ATTACHMENT0, GL_RENDERBUFFER, color);
+            glViewport(0, 0, TARGET_SIZE, TARGET_SIZE);
+
+            glGenVertexArrays(1, &vertex_array);
+            glBindVertexArray(vertex_array);
+
+            const auto indices = io::terrain::build_terrain_lod_indices(lod_table);
+            glGenBuffers(1, &index_buffer);
+            glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, index_buffer);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, static_cast<GLsizeiptr>(indices.size() * sizeof(uint16_t)),
+                         indices.data(), GL_STATIC_DRAW);
+
+            const std::vector<io::terrain::adt_packed_vector> vectors(CHUNKS_PER_TILE * VERTICES_PER_CHUNK);
+            vertex_buffers.resize(TILE_COUNT);
+            glGenBuffers(static_cast<GLsizei>(vertex_buffers.size()), vertex_buffers.data());
+            for (const auto buffer: vertex_buffers) {
+                glBindBuffer(GL_ARRAY_BUFFER, buffer);
+                glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(vectors.size() * sizeof(vectors[0])),
+                             vectors.data(), GL_STATIC_DRAW);
+                indirect_buffers.push_back(gl::make_indirect_buffer());
+            }
+
+            glUseProgram(program);
+            glEnableVertexAttribArray(0);
+        }
+
+        ~terrain_scene() {
+            indirect_buffers.clear();
+            glDeleteBuffers(static_cast<GLsizei>(vertex_buffers.size()), vertex_buffers.data());
+            glDeleteBuffers(1, &index_buffer);
+            glDeleteVertexArrays(1, &vertex_array);
+            glDeleteFramebuffers(1, &framebuffer);
+            glDeleteRenderbuffers(1, &color);
+            glDeleteProgram(program);
+        }
+
+        void bind_tile(const uint32_t tile) const {
+            glBindBuffer(GL_ARRAY_BUFFER, vertex_buffers[tile]);
+            glVertexAttribPointer(0, 1, GL_FLOAT, GL_FALSE, sizeof(io::terrain::adt_packed_vector), nullptr);
+            glUniform2f(origin_uniform, static_cast<float>(tile % 7) * 533.33f, static_cast<float>(tile / 7) * 533.33f);
+        }
+
+        void draw_per_chunk() const {
+            const auto &range = lod_table[SUBMIT_LOD][0];
+            for (auto tile = 0u; tile < TILE_COUNT; ++tile) {
+                bind_tile(tile);
+                for (auto chunk = 0u; chunk < CHUNKS_PER_TILE; ++chunk) {
+                    glDrawElementsBaseVertex(GL_TRIANGLES, static_cast<GLsizei>(range.count), GL_UNSIGNED_SHORT,
+                                             reinterpret_cast<const void *>(range.first_index * sizeof(uint16_t)),
+                                             static_cast<GLint>(chunk * VERTICES_PER_CHUNK));
+                }
+            }
+        }
+
+        void draw_indirect(std::vector<gl::draw_elements_indirect_command> &commands,
+                           const std::vector<uint32_t> &visible_chunks) const {
+            const auto &range = lod_table[SUBMIT_LOD][0];
+            for (auto tile = 0u; tile < TILE_COUNT; ++tile) {
+                commands.clear();
+                for (const auto chunk: visible_chunks) {
+                    commands.push_back({
+                        .count = range.count,
+                        .instance_count = 1,
+                        .first_index = range.first_index,
+                        .base_vertex = static_cast<int32_t>(chunk * VERTICES_PER_CHUNK),
+                        .base_instance = chunk
+                    });
+                }
+
+                bind_tile(tile);
+                indirect_buffers[tile]->set_data(commands);
+                glMultiDrawElementsIndirect(GL_TRIANGLES, GL_UNSIGNED_SHORT, nullptr,
+                                            static_cast<GLsizei>(commands.size()), 0);
+            }
+        }
+    };
+
+    struct frame_timer {
+        double submit_seconds = 0.0;
+        size_t frames = 0;
+
+        void frame(const std::function<void()> &submit) {
+            glClear(GL_COLOR_BUFFER_BIT);
+            const auto start = std::chrono::steady_clock::now();
+            submit();
+            submit_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            ++frames;
+            glFinish();
+        }
+
+        void report(const std::string &label, const bench::measurement &result) const {
+            bench::report(label + " CPU submit", submit_seconds / static_cast<double>(frames) * 1e3, "ms/frame");
+            bench::report(label + " frame incl. glFinish", result.per_iteration() * 1e3, "ms/frame");
+        }
+    };
+}
+
+WOW_BENCH(terrain_submission) {
+    const auto context = gl::egl_context::create_headless();
+    if (!context || !context->make_current() || !gl::egl_context::load_gl()) {
+        bench::skip("no surfaceless EGL context (needs EGL_MESA_platform_surfaceless)");
+        return;
+    }
+
+    bench::note(std::string{"renderer: "} + reinterpret_cast<const char *>(glGetString(GL_RENDERER)));
+
+    {
+        terrain_scene scene{};
+
+        frame_timer per_chunk_timer{};
+        const auto per_chunk = bench::measure([&] {
+            per_chunk_timer.frame([&] { scene.draw_per_chunk(); });
+        }, std::chrono::milliseconds{2000});
+
+        std::vector<uint32_t> visible_chunks(CHUNKS_PER_TILE);
+        std::iota(visible_chunks.begin(), visible_chunks.end(), 0u);
+        std::vector<gl::draw_elements_indirect_command> commands{};
+        commands.reserve(CHUNKS_PER_TILE);
+
+        frame_timer indirect_timer{};
+        const auto indirect = bench::measure([&] {
+            indirect_timer.frame([&] { scene.draw_indirect(commands, visible_chunks); });
+        }, std::chrono::milliseconds{2000});
+
+        bench::report("draw calls per frame, per chunk", TILE_COUNT * CHUNKS_PER_TILE, "calls");
+        per_chunk_timer.report("per-chunk glDrawElementsBaseVertex", per_chunk);
+        bench::report("draw calls per frame, indirect", TILE_COUNT, "calls");
+        indirect_timer.report("per-tile glMultiDrawElementsIndirect", indirect);
+    }
+
+    context->release_current();
+}
@@ -0,0 +1,149 @@
+#include "bench.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <list>
+#include <mutex>
+#include <random>
+#include <thread>
+
+#include "scene/tile_registry.h"
+
+using namespace wow;
+
+namespace {
+    constexpr int32_t STREAM_RADIUS = 3;
+    constexpr size_t LOOKUPS_PER_BATCH = 1 << 16;
+
+    using tile_grid = std::vector<io::terrain::adt_tile_ptr>;
+
+    tile_grid make_tiles() {
+        tile_grid tiles{};
+        for (auto y = 0; y < scene::tile_registry::GRID_SIZE; ++y) {
+            for (auto x = 0; x < scene::tile_registry::GRID_SIZE; ++x) {
+                if (std::abs(x - 32) <= STREAM_RADIUS + 1 && std::abs(y - 32) <= STREAM_RADIUS + 1) {
+                    tiles.push_back(std::make_shared<io::terrain::adt_tile>(nullptr, x, y, nullptr, nullptr));
+                }
+            }
+        }
+
+        return tiles;
+    }
+
+    std::vector<io::terrain::adt_tile_ptr> window(const tile_grid &tiles, const int32_t center_x) {
+        std::vector<io::terrain::adt_tile_ptr> visible{};
+        for (const auto &tile: tiles) {
+            if (std::abs(static_cast<int32_t>(tile->x()) - center_x) <= STREAM_RADIUS &&
+                std::abs(static_cast<int32_t>(tile->y()) - 32) <= STREAM_RADIUS) {
+                visible.push_back(tile);
+            }
+        }
+
+        return visible;
+    }
+
+    class list_registry {
+        std::list<io::terrain::adt_tile_ptr> _tiles{};
+        std::mutex _lock{};
+
+    public:
+        io::terrain::adt_tile_ptr at(const int32_t x, const int32_t y) {
+            std::list<io::terrain::adt_tile_ptr> tiles{};
+            {
+                std::lock_guard lock(_lock);
+                tiles = _tiles;
+            }
+
+            for (const auto &tile: tiles) {
+                if (static_cast<int32_t>(tile->x()) == x && static_cast<int32_t>(tile->y()) == y) {
+                    return tile;
+                }
+            }
+
+            return nullptr;
+        }
+
+        void replace(const std::vector<io::terrain::adt_tile_ptr> &tiles) {
+            std::lock_guard lock(_lock);
+            _tiles.assign(tiles.begin(), tiles.end());
+        }
+    };
+
+    class grid_registry {
+        scene::tile_registry _registry{};
+        std::vector<io::terrain::adt_tile_ptr> _current{};
+
+    public:
+        io::terrain::adt_tile_ptr at(const int32_t x, const int32_t y) const {
+            return _registry.at(x, y);
+        }
+
+        void replace(const std::vector<io::terrain::adt_tile_ptr> &tiles) {
+            _registry.remove({_current.begin(), _current.end()});
+            _registry.insert(tiles);
+            _current = tiles;
+        }
+    };
+
+    template<typename Registry>
+    void run(const std::string &name, const tile_grid &tiles, const unsigned reader_count) {
+        Registry registry{};
+        registry.replace(window(tiles, 32));
+
+        std::atomic_bool running = true;
+        std::atomic_size_t swaps = 0;
+        const auto start = std::chrono::steady_clock::now();
+        std::thread streamer{[&] {
+            auto center = 32;
+            auto step = 1;
+            while (running.load(std::memory_order_relaxed)) {
+                if (std::abs(center + step - 32) > 1) {
+                    step = -step;
+                }
+
+                center += step;
+                registry.replace(window(tiles, center));
+                ++swaps;
+            }
+        }};
+
+        const auto result = bench::measure([&] {
+            std::vector<std::thread> readers{};
+            for (auto i = 0u; i < reader_count; ++i) {
+                readers.emplace_back([&, i] {
+                    std::mt19937 rng{i};
+                    std::uniform_real_distribution<float> position{-1.0f, 1.0f};
+                    for (auto n = 0u; n < LOOKUPS_PER_BATCH; ++n) {
+                        const auto x = 32 + static_cast<int32_t>(position(rng) * STREAM_RADIUS);
+                        const auto y = 32 + static_cast<int32_t>(position(rng) * STREAM_RADIUS);
+                        if (const auto tile = registry.at(x, y)) {
+                            bench::do_not_optimize(tile->chunk(n % 256).get());
+                        }
+                    }
+                });
+            }
+
+            for (auto &reader: readers) {
+                reader.join();
+            }
+        });
+
+        running = false;
+        streamer.join();
+        const auto elapsed = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+
+        const auto lookups = static_cast<double>(result.iterations * reader_count * LOOKUPS_PER_BATCH);
+        const auto label = name + ", " + std::to_string(reader_count) + " reader(s)";
+        bench::report(label, lookups / result.seconds / 1e6, "M lookups/s");
+        bench::report(label + " streamer", static_cast<double>(swaps) / elapsed, "swaps/s");
+    }
+}
+
+WOW_BENCH(tile_lookup_while_streaming) {
+    const auto tiles = make_tiles();
+    const auto hardware_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (auto readers = 1u; readers <= hardware_threads; readers *= 2) {
+        run<list_registry>("std::list copy + scan", tiles, readers);
+        run<grid_registry>("tile_registry grid", tiles, readers);
+    }
+}
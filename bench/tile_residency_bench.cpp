@@ -0,0 +1,86 @@
+#include "bench.h"
+
+#include <algorithm>
+
+#include "scene/tile_residency.h"
+
+using namespace wow;
+
+namespace {
+    constexpr int32_t FLIGHT_MIN = 8;
+    constexpr int32_t FLIGHT_MAX = 56;
+    constexpr float FLIGHT_STEP = 0.25f;
+    constexpr int32_t FLIGHT_SWEEPS = 4;
+
+    struct flight_point {
+        int32_t x;
+        int32_t y;
+    };
+
+    std::vector<flight_point> scripted_flight() {
+        std::vector<flight_point> path{};
+        for (auto sweep = 0; sweep < FLIGHT_SWEEPS; ++sweep) {
+            for (auto row = FLIGHT_MIN; row <= FLIGHT_MAX; row += 4) {
+                const auto forward = (row / 4 + sweep) % 2 == 0;
+                for (auto x = static_cast<float>(FLIGHT_MIN); x <= static_cast<float>(FLIGHT_MAX); x += FLIGHT_STEP) {
+                    const auto tx = forward ? x : static_cast<float>(FLIGHT_MAX + FLIGHT_MIN) - x;
+                    path.push_back({static_cast<int32_t>(tx), row});
+                }
+            }
+        }
+
+        return path;
+    }
+}
+
+WOW_BENCH(tile_residency_soak) {
+    const auto config_manager = std::make_shared<config::config_manager>();
+    const auto radius = config_manager->map().load_radius;
+
+    scene::tile_registry registry{};
+    scene::tile_residency residency{config_manager};
+
+    const auto path = scripted_flight();
+    size_t peak_tiles = 0;
+    size_t peak_vertex_bytes = 0;
+    size_t loaded_tiles = 0;
+    double eviction_seconds = 0.0;
+
+    for (const auto &[tx, ty]: path) {
+        std::unordered_set<int32_t> wanted{};
+        std::vector<io::terrain::adt_tile_ptr> loaded{};
+        for (auto y = ty - radius; y <= ty + radius; ++y) {
+            for (auto x = tx - radius; x <= tx + radius; ++x) {
+                if (x < 0 || y < 0 || x >= 64 || y >= 64) {
+                    continue;
+                }
+
+                wanted.insert(y * 64 + x);
+                if (!registry.at(x, y)) {
+                    loaded.push_back(std::make_shared<io::terrain::adt_tile>(nullptr, x, y, nullptr, nullptr));
+                }
+            }
+        }
+
+        loaded_tiles += loaded.size();
+        registry.insert(loaded);
+
+        const auto start = std::chrono::steady_clock::now();
+        const auto evicted = residency.select_evictions(*registry.tiles(), tx, ty, wanted);
+        eviction_seconds += std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+        registry.remove(evicted);
+
+        const auto usage = residency.usage();
+        peak_tiles = std::max(peak_tiles, usage.tiles);
+        peak_vertex_bytes = std::max(peak_vertex_bytes, usage.vertex_bytes);
+    }
+
+    bench::report("flight steps", static_cast<double>(path.size()), "steps");
+    bench::report("tiles loaded during flight", static_cast<double>(loaded_tiles), "tiles");
+    bench::report("peak resident tiles", static_cast<double>(peak_tiles), "tiles");
+    bench::report("resident tiles after flight", static_cast<double>(registry.tiles()->size()), "tiles");
+    bench::report("peak vertex VRAM (residency estimate)", static_cast<double>(peak_vertex_bytes) / (1024.0 * 1024.0),
+                  "MB");
+    bench::report("peak RSS", static_cast<double>(bench::peak_rss()) / (1024.0 * 1024.0), "MB");
+    bench::report("select_evictions per step", eviction_seconds / static_cast<double>(path.size()) * 1e6, "us");
+}
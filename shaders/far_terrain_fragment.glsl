@@ -0,0 +1,29 @@
+#version 430
+
+in vec2 frag_tex_coord;
+in vec3 world_position;
+
+uniform sampler2D minimap_texture;
+uniform sampler2D detail_mask;
+
+uniform vec4 camera_position;
+uniform vec4 fog_color = vec4(0.5, 0.7, 1.0, 1.0);
+uniform float fog_distance = 150.0f;
+
+out vec4 target_color;
+
+const float TILE_SIZE = 533.0 + 1.0 / 3.0;
+
+void main() {
+    float distance = length(camera_position.xyz - world_position);
+
+    ivec2 tile = clamp(ivec2(floor(world_position.xy / TILE_SIZE)), ivec2(0), ivec2(63));
+    if (distance < camera_position.w && texelFetch(detail_mask, tile, 0).r > 0.5) {
+        discard;
+    }
+
+    vec3 color = texture(minimap_texture, frag_tex_coord).rgb;
+
+    float factor = 1.0f - clamp((fog_distance - distance) / 150.0f, 0.0f, 1.0f);
+    target_color = vec4(mix(color, fog_color.bgr, factor), 1.0);
+}
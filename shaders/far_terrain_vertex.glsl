@@ -0,0 +1,16 @@
+#version 430
+
+in vec3 position0;
+in vec2 tex_coord0;
+
+out vec2 frag_tex_coord;
+out vec3 world_position;
+
+uniform mat4 view;
+uniform mat4 projection;
+
+void main() {
+    frag_tex_coord = tex_coord0;
+    world_position = position0;
+    gl_Position = projection * view * vec4(position0, 1.0);
+}
@@ -1,4 +1,4 @@
-#version 150
+#version 430
 
 in vec3 frag_normal;
 in vec2 frag_tex_coord;
@@ -6,13 +6,18 @@ in vec2 frag_alpha_coord;
 in vec3 frag_vertex_color;
 
 in vec3 world_position;
+flat in int frag_chunk_index;
+
+layout(std430) readonly buffer terrain_chunks {
+    ivec4 chunk_layers[];
+};
 
 uniform sampler2D shadow_texture;
+uniform sampler2DArray color_arrays[8];
 
-uniform sampler2D color_texture0;
-uniform sampler2D color_texture1;
-uniform sampler2D color_texture2;
-uniform sampler2D color_texture3;
+layout(std430) readonly buffer terrain_texture_residency {
+    float resident_levels[];
+};
 
 uniform vec4 camera_position;
 uniform vec3 sun_direction;
@@ -23,6 +28,34 @@ uniform float fog_distance = 150.0f;
 
 out vec4 target_color;
 
+vec3 sample_array(sampler2DArray color_array, vec3 coord, float resident) {
+    float min_lod = float(textureQueryLevels(color_array)) - resident;
+    float lod = max(textureQueryLod(color_array, coord.xy).y, min_lod);
+    return textureLod(color_array, coord, lod).rgb;
+}
+
+vec3 sample_layer(int packed_layer, vec2 tex_coord) {
+    if (packed_layer < 0) {
+        return vec3(0.0);
+    }
+
+    int residency_index = packed_layer & 0xFFFFFF;
+    vec3 coord = vec3(tex_coord, float(residency_index % 64));
+    float resident = resident_levels[residency_index];
+    switch (packed_layer >> 24) {
+        case 0: return sample_array(color_arrays[0], coord, resident);
+        case 1: return sample_array(color_arrays[1], coord, resident);
+        case 2: return sample_array(color_arrays[2], coord, resident);
+        case 3: return sample_array(color_arrays[3], coord, resident);
+        case 4: return sample_array(color_arrays[4], coord, resident);
+        case 5: return sample_array(color_arrays[5], coord, resident);
+        case 6: return sample_array(color_arrays[6], coord, resident);
+        case 7: return sample_array(color_arrays[7], coord, resident);
+    }
+
+    return vec3(0.0);
+}
+
 void main() {
     vec3 light_dir = normalize(sun_direction);
     float sun_factor = clamp(light_dir.z * 2.0, 0.0, 1.0);
@@ -32,10 +65,11 @@ void main() {
     light = 1.0 - (1.0 - light) * (1.0 - light);
     light *= 0.6 * sun_factor;
 
-    vec3 color0 = texture(color_texture0, frag_tex_coord).rgb;
-    vec3 color1 = texture(color_texture1, frag_tex_coord).rgb;
-    vec3 color2 = texture(color_texture2, frag_tex_coord).rgb;
-    vec3 color3 = texture(color_texture3, frag_tex_coord).rgb;
+    ivec4 layers = chunk_layers[frag_chunk_index];
+    vec3 color0 = layers.x < 0 ? vec3(0.5) : sample_layer(layers.x, frag_tex_coord);
+    vec3 color1 = sample_layer(layers.y, frag_tex_coord);
+    vec3 color2 = sample_layer(layers.z, frag_tex_coord);
+    vec3 color3 = sample_layer(layers.w, frag_tex_coord);
 
     vec4 alphas = texture(shadow_texture, frag_alpha_coord);
     float alpha = alphas.b;
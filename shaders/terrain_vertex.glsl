@@ -1,26 +1,40 @@
-#version 150
+#version 430
 
-in vec3 position0;
+in float height0;
 in vec3 normal0;
-in vec2 tex_coord0;
-in vec2 alpha_coord0;
-in vec3 vertex_color0;
+in vec4 vertex_color0;
 
 out vec3 frag_normal;
 out vec2 frag_tex_coord;
 out vec2 frag_alpha_coord;
 out vec3 frag_vertex_color;
 out vec3 world_position;
+flat out int frag_chunk_index;
 
 uniform mat4 view;
 uniform mat4 projection;
+uniform vec2 tile_origin;
+
+const float CHUNK_SIZE = (533.0 + 1.0 / 3.0) / 16.0;
+const float VERTEX_SIZE = CHUNK_SIZE / 8.0;
 
 void main() {
+    frag_chunk_index = gl_VertexID / 145;
+
+    int vertex = gl_VertexID % 145;
+    int row = vertex / 17;
+    int column = vertex % 17;
+    vec2 grid = column < 9 ? vec2(column, row) : vec2(float(column - 9) + 0.5, float(row) + 0.5);
+
+    vec2 chunk_origin = vec2(frag_chunk_index % 16, frag_chunk_index / 16);
+    world_position = vec3(tile_origin + chunk_origin * CHUNK_SIZE + grid * VERTEX_SIZE, height0);
+
     frag_normal = normal0;
-    frag_tex_coord = tex_coord0;
-    frag_alpha_coord = alpha_coord0;
-    frag_vertex_color = vertex_color0;
-    world_position = position0;
+    frag_tex_coord = grid;
+    frag_vertex_color = vertex_color0.rgb;
+
+    vec2 alpha_coord = grid / 8.0;
+    frag_alpha_coord = (chunk_origin + (alpha_coord * 63.0 + 0.5) / 64.0) / 16.0;
 
-    gl_Position = projection * view * vec4(position0, 1.0);
-}
\ No newline at end of file
+    gl_Position = projection * view * vec4(world_position, 1.0);
+}
@@ -18,13 +18,46 @@ namespace wow::config {
     }
 
     int32_t config_manager::int_value(const std::string &section, const std::string &key, int32_t default_value) {
-        const auto child = _config[section];
-        return int_value(*child.as_table(), key, default_value);
+        const auto child = _config[section].as_table();
+        if (!child) {
+            SPDLOG_DEBUG("Config section '{}' not found, using default value: {}", section, default_value);
+            return default_value;
+        }
+
+        return int_value(*child, key, default_value);
+    }
+
+    bool config_manager::bool_value(const std::string &section, const std::string &key, bool default_value) {
+        if (const auto value = _config[section][key].value<bool>(); value.has_value()) {
+            return value.value();
+        }
+
+        SPDLOG_DEBUG("Config key '{}.{}' not found, using default value: {}", section, key, default_value);
+        return default_value;
+    }
+
+    std::string config_manager::string_value(const std::string &section, const std::string &key,
+                                             const std::string &default_value) {
+        if (const auto value = _config[section][key].value<std::string>(); value.has_value()) {
+            return value.value();
+        }
+
+        SPDLOG_DEBUG("Config key '{}.{}' not found, using default value: {}", section, key, default_value);
+        return default_value;
     }
 
     config_manager::config_manager() {
         std::ifstream file{"config.toml"};
         _config = toml::parse(file, std::string_view{"config.toml"});
         _map_config.load_radius = int_value("map", "loading-radius", 3);
+        _map_config.eviction_hysteresis = int_value("map", "eviction-hysteresis", 1);
+        _map_config.cpu_budget_mb = int_value("map", "cpu-budget-mb", 1024);
+        _map_config.gpu_budget_mb = int_value("map", "gpu-budget-mb", 1024);
+        _map_config.lod_pixel_error = int_value("map", "lod-pixel-error", 4);
+        _map_config.far_view_distance = int_value("map", "far-view-distance", 0);
+        _map_config.texture_budget_mb = int_value("map", "texture-budget-mb", 256);
+        _cache_config.enabled = bool_value("cache", "enabled", true);
+        _cache_config.directory = string_value("cache", "directory", "cache");
+        _render_config.upload_thread = bool_value("render", "upload-thread", false);
     }
 }
@@ -9,24 +9,53 @@
 namespace wow::config {
     struct map_config {
         int32_t load_radius{};
+        int32_t eviction_hysteresis{};
+        int32_t cpu_budget_mb{};
+        int32_t gpu_budget_mb{};
+        int32_t lod_pixel_error{};
+        int32_t far_view_distance{};
+        int32_t texture_budget_mb{};
+    };
+
+    struct cache_config {
+        bool enabled{};
+        std::string directory{};
+    };
+
+    struct render_config {
+        bool upload_thread{};
     };
 
     class config_manager {
         toml::table _config{};
 
         map_config _map_config{};
+        cache_config _cache_config{};
+        render_config _render_config{};
 
         static int32_t int_value(const toml::table& obj, const std::string &key, int32_t default_value);
 
         int32_t int_value(const std::string &key, int32_t default_value);
         int32_t int_value(const std::string& section, const std::string &key, int32_t default_value);
 
+        bool bool_value(const std::string &section, const std::string &key, bool default_value);
+
+        std::string string_value(const std::string &section, const std::string &key, const std::string &default_value);
+
     public:
         config_manager();
 
         [[nodiscard]] const map_config &map() const {
             return _map_config;
         }
+
+        [[nodiscard]] const cache_config &cache() const {
+            return _cache_config;
+        }
+
+        [[nodiscard]] const render_config &render() const {
+            return _render_config;
+        }
     };
 
     using config_manager_ptr = std::shared_ptr<config_manager>;
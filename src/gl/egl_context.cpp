@@ -0,0 +1,159 @@
+#include "egl_context.h"
+
+#include <cstring>
+
+extern "C" {
+#include <glad/gl.h>
+}
+
+#include "spdlog/spdlog.h"
+
+namespace wow::gl {
+    namespace {
+        bool has_extension(const char *extensions, const char *name) {
+            if (!extensions) {
+                return false;
+            }
+
+            const auto length = std::strlen(name);
+            for (auto current = std::strstr(extensions, name); current; current = std::strstr(current + 1, name)) {
+                const auto at_start = current == extensions || current[-1] == ' ';
+                const auto at_end = current[length] == '\0' || current[length] == ' ';
+                if (at_start && at_end) {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+    }
+
+    egl_context::egl_context(const EGLDisplay display, const EGLContext context, const bool owns_display,
+                             egl_context_ptr parent) : _display(display),
+                                                       _context(context),
+                                                       _owns_display(owns_display),
+                                                       _parent(std::move(parent)) {
+    }
+
+    egl_context::~egl_context() {
+        if (eglGetCurrentContext() == _context) {
+            release_current();
+        }
+
+        eglDestroyContext(_display, _context);
+        if (_owns_display) {
+            eglTerminate(_display);
+        }
+    }
+
+    bool egl_context::find_config(const EGLDisplay display, const EGLContext share, EGLConfig &config) {
+        EGLint count = 0;
+        if (share != EGL_NO_CONTEXT) {
+            EGLint config_id = 0;
+            if (eglQueryContext(display, share, EGL_CONFIG_ID, &config_id)) {
+                const EGLint attributes[] = {EGL_CONFIG_ID, config_id, EGL_NONE};
+                if (eglChooseConfig(display, attributes, &config, 1, &count) && count > 0) {
+                    return true;
+                }
+            }
+        }
+
+        if (has_extension(eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_no_config_context")) {
+            config = EGL_NO_CONFIG_KHR;
+            return true;
+        }
+
+        const EGLint attributes[] = {EGL_RENDERABLE_TYPE, EGL_OPENGL_BIT, EGL_NONE};
+        return eglChooseConfig(display, attributes, &config, 1, &count) && count > 0;
+    }
+
+    EGLContext egl_context::create_native(const EGLDisplay display, const EGLContext share) {
+        if (!has_extension(eglQueryString(display, EGL_EXTENSIONS), "EGL_KHR_surfaceless_context")) {
+            SPDLOG_WARN("EGL display does not support surfaceless contexts");
+            return EGL_NO_CONTEXT;
+        }
+
+        if (!eglBindAPI(EGL_OPENGL_API)) {
+            SPDLOG_WARN("EGL display does not support desktop OpenGL");
+            return EGL_NO_CONTEXT;
+        }
+
+        EGLConfig config{};
+        if (!find_config(display, share, config)) {
+            SPDLOG_WARN("No EGL config supports desktop OpenGL");
+            return EGL_NO_CONTEXT;
+        }
+
+        const EGLint attributes[] = {
+            EGL_CONTEXT_MAJOR_VERSION, 4,
+            EGL_CONTEXT_MINOR_VERSION, 3,
+            EGL_CONTEXT_OPENGL_PROFILE_MASK, EGL_CONTEXT_OPENGL_CORE_PROFILE_BIT,
+            EGL_NONE
+        };
+
+        const auto context = eglCreateContext(display, config, share, attributes);
+        if (context == EGL_NO_CONTEXT) {
+            SPDLOG_WARN("Cannot create EGL context: 0x{:X}", eglGetError());
+        }
+
+        return context;
+    }
+
+    egl_context_ptr egl_context::create_headless() {
+        if (!has_extension(eglQueryString(EGL_NO_DISPLAY, EGL_EXTENSIONS), "EGL_MESA_platform_surfaceless")) {
+            SPDLOG_WARN("EGL_MESA_platform_surfaceless is not available");
+            return nullptr;
+        }
+
+        const auto get_platform_display = reinterpret_cast<PFNEGLGETPLATFORMDISPLAYEXTPROC>(
+            eglGetProcAddress("eglGetPlatformDisplayEXT"));
+        if (!get_platform_display) {
+            return nullptr;
+        }
+
+        const auto display = get_platform_display(EGL_PLATFORM_SURFACELESS_MESA, EGL_DEFAULT_DISPLAY, nullptr);
+        if (display == EGL_NO_DISPLAY || !eglInitialize(display, nullptr, nullptr)) {
+            SPDLOG_WARN("Cannot initialize surfaceless EGL display");
+            return nullptr;
+        }
+
+        const auto context = create_native(display, EGL_NO_CONTEXT);
+        if (context == EGL_NO_CONTEXT) {
+            eglTerminate(display);
+            return nullptr;
+        }
+
+        return std::make_shared<egl_context>(display, context, true);
+    }
+
+    egl_context_ptr egl_context::create_shared(const EGLDisplay display, const EGLContext share) {
+        const auto context = create_native(display, share);
+        if (context == EGL_NO_CONTEXT) {
+            return nullptr;
+        }
+
+        return std::make_shared<egl_context>(display, context, false);
+    }
+
+    egl_context_ptr egl_context::create_shared() {
+        const auto context = create_native(_display, _context);
+        if (context == EGL_NO_CONTEXT) {
+            return nullptr;
+        }
+
+        return std::make_shared<egl_context>(_display, context, false, shared_from_this());
+    }
+
+    bool egl_context::make_current() const {
+        eglBindAPI(EGL_OPENGL_API);
+        return eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, _context) == EGL_TRUE;
+    }
+
+    void egl_context::release_current() const {
+        eglMakeCurrent(_display, EGL_NO_SURFACE, EGL_NO_SURFACE, EGL_NO_CONTEXT);
+    }
+
+    bool egl_context::load_gl() {
+        return gladLoadGL(eglGetProcAddress) != 0;
+    }
+}
@@ -0,0 +1,55 @@
+#ifndef WOW_UNIX_EGL_CONTEXT_H
+#define WOW_UNIX_EGL_CONTEXT_H
+
+#include <memory>
+
+#include <EGL/egl.h>
+#include <EGL/eglext.h>
+
+namespace wow::gl {
+    class egl_context;
+
+    using egl_context_ptr = std::shared_ptr<egl_context>;
+
+    class egl_context : public std::enable_shared_from_this<egl_context> {
+        EGLDisplay _display = EGL_NO_DISPLAY;
+        EGLContext _context = EGL_NO_CONTEXT;
+        bool _owns_display = false;
+        egl_context_ptr _parent{};
+
+        static bool find_config(EGLDisplay display, EGLContext share, EGLConfig &config);
+
+        static EGLContext create_native(EGLDisplay display, EGLContext share);
+
+    public:
+        egl_context(EGLDisplay display, EGLContext context, bool owns_display, egl_context_ptr parent = {});
+
+        ~egl_context();
+
+        egl_context(const egl_context &) = delete;
+
+        egl_context &operator=(const egl_context &) = delete;
+
+        static egl_context_ptr create_headless();
+
+        static egl_context_ptr create_shared(EGLDisplay display, EGLContext share);
+
+        [[nodiscard]] egl_context_ptr create_shared();
+
+        bool make_current() const;
+
+        void release_current() const;
+
+        static bool load_gl();
+
+        [[nodiscard]] EGLDisplay display() const {
+            return _display;
+        }
+
+        [[nodiscard]] EGLContext native() const {
+            return _context;
+        }
+    };
+}
+
+#endif //WOW_UNIX_EGL_CONTEXT_H
@@ -0,0 +1,27 @@
+#include "indirect_buffer.h"
+
+namespace wow::gl {
+    indirect_buffer::indirect_buffer() {
+        glGenBuffers(1, &_buffer);
+    }
+
+    indirect_buffer::~indirect_buffer() {
+        glDeleteBuffers(1, &_buffer);
+    }
+
+    void indirect_buffer::bind() const {
+        glBindBuffer(GL_DRAW_INDIRECT_BUFFER, _buffer);
+    }
+
+    void indirect_buffer::set_data(const void *data, const size_t size) {
+        bind();
+        if (size > _capacity) {
+            _capacity = size;
+            glBufferData(GL_DRAW_INDIRECT_BUFFER, static_cast<GLsizeiptr>(size), data, GL_STREAM_DRAW);
+            return;
+        }
+
+        glBufferData(GL_DRAW_INDIRECT_BUFFER, static_cast<GLsizeiptr>(_capacity), nullptr, GL_STREAM_DRAW);
+        glBufferSubData(GL_DRAW_INDIRECT_BUFFER, 0, static_cast<GLsizeiptr>(size), data);
+    }
+}
@@ -0,0 +1,52 @@
+#ifndef WOW_UNIX_INDIRECT_BUFFER_H
+#define WOW_UNIX_INDIRECT_BUFFER_H
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+extern "C" {
+#include <glad/gl.h>
+}
+
+namespace wow::gl {
+    struct draw_elements_indirect_command {
+        uint32_t count;
+        uint32_t instance_count;
+        uint32_t first_index;
+        int32_t base_vertex;
+        uint32_t base_instance;
+    };
+
+    static_assert(sizeof(draw_elements_indirect_command) == 20);
+
+    class indirect_buffer {
+        GLuint _buffer{};
+        size_t _capacity = 0;
+
+    public:
+        indirect_buffer();
+
+        ~indirect_buffer();
+
+        indirect_buffer(const indirect_buffer &) = delete;
+
+        indirect_buffer &operator=(const indirect_buffer &) = delete;
+
+        void bind() const;
+
+        void set_data(const void *data, size_t size);
+
+        void set_data(const std::vector<draw_elements_indirect_command> &commands) {
+            set_data(commands.data(), commands.size() * sizeof(draw_elements_indirect_command));
+        }
+    };
+
+    using indirect_buffer_ptr = std::shared_ptr<indirect_buffer>;
+
+    inline indirect_buffer_ptr make_indirect_buffer() {
+        return std::make_shared<indirect_buffer>();
+    }
+}
+
+#endif //WOW_UNIX_INDIRECT_BUFFER_H
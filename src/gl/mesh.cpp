@@ -5,6 +5,7 @@
 #include <vector>
 #include <cmath>
 
+#include "render_stats.h"
 #include "glm/ext/scalar_constants.hpp"
 #include "spdlog/spdlog.h"
 
@@ -144,6 +145,7 @@ namespace wow::gl {
             index++;
         }
 
+        render_stats::texture_bind(index);
         return *this;
     }
 
@@ -212,6 +214,7 @@ namespace wow::gl {
             bind();
         }
 
+        render_stats::draw_call();
         if (_index_buffer && _index_count > 0) {
             if (offset <= 0) {
                 glDrawElements(_primitive_type, static_cast<GLsizei>(_index_count), _index_buffer->type(), nullptr);
@@ -226,6 +229,7 @@ namespace wow::gl {
 
     void mesh::draw_instanced(const GLsizei instance_count) const {
         bind();
+        render_stats::draw_call();
 
         if (_index_buffer && _index_count > 0) {
             glDrawElementsInstanced(_primitive_type, static_cast<GLsizei>(_index_count),
@@ -235,6 +239,16 @@ namespace wow::gl {
         }
     }
 
+    void mesh::draw_indirect(const indirect_buffer_ptr &commands, const GLsizei command_count) const {
+        if (!_index_buffer || command_count <= 0) {
+            return;
+        }
+
+        commands->bind();
+        render_stats::draw_call();
+        glMultiDrawElementsIndirect(_primitive_type, _index_buffer->type(), nullptr, command_count, 0);
+    }
+
     mesh_ptr mesh::create_ui_quad() {
         auto quad_mesh = make_mesh();
 
@@ -286,15 +300,10 @@ namespace wow::gl {
             auto mesh = make_mesh();
 
             mesh->set_index_count(768)
-                    .add_vertex_attribute("position", 0, 3, GL_FLOAT, false, 13 * sizeof(float))
-                    .add_vertex_attribute("normal", 0, 3, GL_FLOAT, false, 13 * sizeof(float),
-                                          reinterpret_cast<void *>(3 * sizeof(float)))
-                    .add_vertex_attribute("tex_coord", 0, 2, GL_FLOAT, false, 13 * sizeof(float),
-                                          reinterpret_cast<void *>(6 * sizeof(float)))
-                    .add_vertex_attribute("alpha_coord", 0, 2, GL_FLOAT, false, 13 * sizeof(float),
-                                          reinterpret_cast<void *>(8 * sizeof(float)))
-                    .add_vertex_attribute("vertex_color", 0, 3, GL_FLOAT, false, 13 * sizeof(float),
-                                          reinterpret_cast<void *>(10 * sizeof(float)))
+                    .add_vertex_attribute("height", 0, 1, GL_FLOAT, false, 12)
+                    .add_vertex_attribute("normal", 0, 3, GL_BYTE, true, 12, reinterpret_cast<void *>(4))
+                    .add_vertex_attribute("vertex_color", 0, 4, GL_UNSIGNED_BYTE, true, 12,
+                                          reinterpret_cast<void *>(8))
                     .program(program);
 
             ret_mesh.mesh = std::move(mesh);
@@ -309,6 +318,34 @@ namespace wow::gl {
         return ret_mesh;
     }
 
+    terrain_mesh mesh::far_terrain_mesh() {
+        static struct terrain_mesh ret_mesh{};
+        static std::once_flag flag{};
+        std::call_once(flag, [] {
+            const auto program = std::make_shared<gl::program>();
+            program->compile_vertex_shader_from_file("shaders/far_terrain_vertex.glsl")
+                    .compile_fragment_shader_from_file("shaders/far_terrain_fragment.glsl")
+                    .link();
+
+            auto mesh = make_mesh();
+
+            mesh->add_vertex_attribute("position", 0, 3, GL_FLOAT, false, 5 * sizeof(float))
+                    .add_vertex_attribute("tex_coord", 0, 2, GL_FLOAT, false, 5 * sizeof(float),
+                                          reinterpret_cast<void *>(3 * sizeof(float)))
+                    .program(program);
+
+            ret_mesh.mesh = std::move(mesh);
+            ret_mesh.state.camera_position = ret_mesh.mesh->program()->uniform_location("camera_position");
+            ret_mesh.state.fog_color = ret_mesh.mesh->program()->uniform_location("fog_color");
+            ret_mesh.state.diffuse_color = -1;
+            ret_mesh.state.ambient_color = -1;
+            ret_mesh.state.sun_direction = -1;
+            ret_mesh.state.fog_distance = ret_mesh.mesh->program()->uniform_location("fog_distance");
+        });
+
+        return ret_mesh;
+    }
+
     mesh_ptr mesh::sky_sphere_mesh() {
         static auto mesh = std::make_shared<gl::mesh>();
         static std::once_flag flag{};
@@ -4,6 +4,7 @@
 #include <map>
 
 #include "index_buffer.h"
+#include "indirect_buffer.h"
 #include "program.h"
 #include "vertex_buffer.h"
 #include "texture.h"
@@ -133,6 +134,8 @@ namespace wow::gl {
 
         void draw_instanced(GLsizei instance_count) const;
 
+        void draw_indirect(const indirect_buffer_ptr &commands, GLsizei command_count) const;
+
         // Getters
         [[nodiscard]] const vertex_buffer_ptr &vertex_buffer() const { return _vertex_buffer; }
         [[nodiscard]] const index_buffer_ptr &index_buffer() const { return _index_buffer; }
@@ -144,6 +147,8 @@ namespace wow::gl {
 
         static struct terrain_mesh terrain_mesh();
 
+        static struct terrain_mesh far_terrain_mesh();
+
         static mesh_ptr sky_sphere_mesh();
 
     private:
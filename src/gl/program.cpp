@@ -123,6 +123,15 @@ namespace wow::gl {
         return *this;
     }
 
+    program &program::vec2(const glm::vec2 &vector, const std::string &name) {
+        return vec2(vector, uniform_location(name));
+    }
+
+    program &program::vec2(const glm::vec2 &vector, const int32_t location) {
+        glUniform2fv(location, 1, glm::value_ptr(vector));
+        return *this;
+    }
+
     program &program::vec3(const glm::vec3 &vector, const std::string &name) {
         return vec3(vector, uniform_location(name));
     }
@@ -178,4 +187,15 @@ namespace wow::gl {
         glUniform1i(location, index);
         return *this;
     }
+
+    program &program::storage_block(const std::string &name, const uint32_t binding) {
+        const auto index = glGetProgramResourceIndex(_program, GL_SHADER_STORAGE_BLOCK, name.c_str());
+        if (index == GL_INVALID_INDEX) {
+            SPDLOG_WARN("Storage block {} not found in program", name);
+            return *this;
+        }
+
+        glShaderStorageBlockBinding(_program, index, binding);
+        return *this;
+    }
 }
@@ -49,6 +49,10 @@ namespace wow::gl {
 
         program &mat4(const glm::mat4 &matrix, int32_t location);
 
+        program &vec2(const glm::vec2 &vector, const std::string &name);
+
+        program &vec2(const glm::vec2 &vector, int32_t location);
+
         program &vec3(const glm::vec3 &vector, const std::string &name);
 
         program &vec3(const glm::vec3 &vector, int32_t location);
@@ -72,6 +76,8 @@ namespace wow::gl {
         program &sampler2d(int index, const std::string &name);
 
         program &sampler2d(int index, int location);
+
+        program &storage_block(const std::string &name, uint32_t binding);
     };
 
     using program_ptr = std::shared_ptr<program>;
@@ -0,0 +1,11 @@
+#include "render_stats.h"
+
+namespace wow::gl {
+    render_counters render_stats::_current{};
+    render_counters render_stats::_last_frame{};
+
+    void render_stats::end_frame() {
+        _last_frame = _current;
+        _current = {};
+    }
+}
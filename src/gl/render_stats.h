@@ -0,0 +1,61 @@
+#ifndef WOW_UNIX_RENDER_STATS_H
+#define WOW_UNIX_RENDER_STATS_H
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+
+namespace wow::gl {
+    inline constexpr uint32_t RENDER_STATS_LOD_LEVELS = 5;
+
+    struct render_counters {
+        uint32_t draw_calls = 0;
+        uint32_t texture_binds = 0;
+        uint32_t buffer_binds = 0;
+        uint32_t visible_chunks = 0;
+        uint32_t culled_chunks = 0;
+        std::chrono::steady_clock::duration cull_time{};
+        std::array<uint32_t, RENDER_STATS_LOD_LEVELS> lod_triangles{};
+    };
+
+    class render_stats {
+        static render_counters _current;
+        static render_counters _last_frame;
+
+    public:
+        static void draw_call(const uint32_t count = 1) {
+            _current.draw_calls += count;
+        }
+
+        static void texture_bind(const uint32_t count = 1) {
+            _current.texture_binds += count;
+        }
+
+        static void buffer_bind(const uint32_t count = 1) {
+            _current.buffer_binds += count;
+        }
+
+        static void chunks_culled(const uint32_t visible, const uint32_t total) {
+            _current.visible_chunks += visible;
+            _current.culled_chunks += total - visible;
+        }
+
+        static void cull_time(const std::chrono::steady_clock::duration duration) {
+            _current.cull_time += duration;
+        }
+
+        static void lod_triangles(const uint32_t lod, const uint32_t count) {
+            if (lod < RENDER_STATS_LOD_LEVELS) {
+                _current.lod_triangles[lod] += count;
+            }
+        }
+
+        static void end_frame();
+
+        [[nodiscard]] static const render_counters &last_frame() {
+            return _last_frame;
+        }
+    };
+}
+
+#endif //WOW_UNIX_RENDER_STATS_H
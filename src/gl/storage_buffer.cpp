@@ -0,0 +1,21 @@
+#include "storage_buffer.h"
+
+namespace wow::gl {
+    storage_buffer::storage_buffer() {
+        glGenBuffers(1, &_buffer);
+    }
+
+    storage_buffer::~storage_buffer() {
+        glDeleteBuffers(1, &_buffer);
+    }
+
+    void storage_buffer::set_data(const void *data, const size_t size) {
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, _buffer);
+        glBufferData(GL_SHADER_STORAGE_BUFFER, static_cast<GLsizeiptr>(size), data, GL_STATIC_DRAW);
+        glBindBuffer(GL_SHADER_STORAGE_BUFFER, 0);
+    }
+
+    void storage_buffer::bind_base(const uint32_t index) const {
+        glBindBufferBase(GL_SHADER_STORAGE_BUFFER, index, _buffer);
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef WOW_UNIX_STORAGE_BUFFER_H
+#define WOW_UNIX_STORAGE_BUFFER_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+extern "C" {
+#include <glad/gl.h>
+}
+
+namespace wow::gl {
+    class storage_buffer {
+        GLuint _buffer{};
+
+    public:
+        storage_buffer();
+
+        ~storage_buffer();
+
+        storage_buffer(const storage_buffer &) = delete;
+
+        storage_buffer &operator=(const storage_buffer &) = delete;
+
+        void set_data(const void *data, size_t size);
+
+        template<typename T>
+        void set_data(const T &data) {
+            set_data(&data, sizeof(T));
+        }
+
+        void bind_base(uint32_t index) const;
+    };
+
+    using storage_buffer_ptr = std::shared_ptr<storage_buffer>;
+
+    inline storage_buffer_ptr make_storage_buffer() {
+        return std::make_shared<storage_buffer>();
+    }
+}
+
+#endif //WOW_UNIX_STORAGE_BUFFER_H
@@ -67,6 +67,37 @@ namespace wow::gl {
         unbind();
     }
 
+    void texture::bgra_mipmaps(const uint32_t width, const uint32_t height, const uint32_t levels,
+                               const uint32_t *data) {
+        if (_texture == default_texture) {
+            glGenTextures(1, &_texture);
+        }
+
+        bind();
+        auto w = width;
+        auto h = height;
+        for (auto i = 0u; i < levels; ++i) {
+            glTexImage2D(
+                GL_TEXTURE_2D,
+                static_cast<GLint>(i),
+                GL_RGBA8,
+                static_cast<GLsizei>(w),
+                static_cast<GLsizei>(h),
+                0,
+                GL_BGRA,
+                GL_UNSIGNED_BYTE,
+                data
+            );
+
+            data += static_cast<size_t>(w) * h;
+            w = std::max(w >> 1, 1u);
+            h = std::max(h >> 1, 1u);
+        }
+
+        glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(levels) - 1);
+        unbind();
+    }
+
     void texture::image(const uint32_t width, const uint32_t height, const GLint format, const void *data) {
         if (_texture == default_texture) {
             glGenTextures(1, &_texture);
@@ -27,6 +27,8 @@ namespace wow::gl {
 
         void bgra_image(uint32_t width, uint32_t height, const void *data);
 
+        void bgra_mipmaps(uint32_t width, uint32_t height, uint32_t levels, const uint32_t *data);
+
         void image(uint32_t width, uint32_t height, GLint format, const void *data);
 
         void load_blp(const io::blp::blp_file_ptr &blp);
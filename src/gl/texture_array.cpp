@@ -0,0 +1,199 @@
+#include "texture_array.h"
+
+#include <algorithm>
+
+#include "spdlog/spdlog.h"
+
+namespace wow::gl {
+    namespace {
+        GLenum internal_format(const io::blp::blp_format format) {
+            switch (format) {
+                case io::blp::blp_format::bc1:
+                    return GL_COMPRESSED_RGBA_S3TC_DXT1_EXT;
+                case io::blp::blp_format::bc2:
+                    return GL_COMPRESSED_RGBA_S3TC_DXT3_EXT;
+                case io::blp::blp_format::bc3:
+                    return GL_COMPRESSED_RGBA_S3TC_DXT5_EXT;
+                default:
+                    return GL_RGBA8;
+            }
+        }
+
+        size_t compressed_size(const io::blp::blp_format format, const uint32_t w, const uint32_t h) {
+            const auto blocks = static_cast<size_t>((w + 3) / 4) * ((h + 3) / 4);
+            return blocks * (format == io::blp::blp_format::bc1 ? 8 : 16);
+        }
+    }
+
+    texture_array::texture_array(const uint32_t width, const uint32_t height, const uint32_t levels,
+                                 const uint32_t layers, const io::blp::blp_format format,
+                                 const uint32_t first_level) : _first_level(first_level),
+                                                               _width(width),
+                                                               _height(height),
+                                                               _levels(levels),
+                                                               _layers(layers),
+                                                               _format(format) {
+    }
+
+    texture_array::~texture_array() {
+        if (_storage) {
+            glDeleteTextures(1, &_storage);
+        }
+
+        if (!_retired.empty()) {
+            glDeleteTextures(static_cast<GLsizei>(_retired.size()), _retired.data());
+        }
+    }
+
+    GLuint texture_array::allocate(const uint32_t first_level) const {
+        GLuint texture{};
+        glGenTextures(1, &texture);
+        glBindTexture(GL_TEXTURE_2D_ARRAY, texture);
+        glTexStorage3D(GL_TEXTURE_2D_ARRAY, static_cast<GLsizei>(_levels - first_level), internal_format(_format),
+                       static_cast<GLsizei>(std::max(_width >> first_level, 1u)),
+                       static_cast<GLsizei>(std::max(_height >> first_level, 1u)), static_cast<GLsizei>(_layers));
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MIN_FILTER, GL_LINEAR_MIPMAP_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_S, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_WRAP_T, GL_REPEAT);
+        glTexParameteri(GL_TEXTURE_2D_ARRAY, GL_TEXTURE_MAX_LEVEL, static_cast<GLint>(_levels - first_level) - 1);
+        return texture;
+    }
+
+    void texture_array::resize_storage(const uint32_t first_level) {
+        if (!_storage) {
+            _first_level = first_level;
+            return;
+        }
+
+        const auto storage = allocate(first_level);
+        for (auto level = std::max(first_level, _first_level); level < _levels; ++level) {
+            glCopyImageSubData(_storage, GL_TEXTURE_2D_ARRAY, static_cast<GLint>(level - _first_level), 0, 0, 0,
+                               storage, GL_TEXTURE_2D_ARRAY, static_cast<GLint>(level - first_level), 0, 0, 0,
+                               static_cast<GLsizei>(std::max(_width >> level, 1u)),
+                               static_cast<GLsizei>(std::max(_height >> level, 1u)), static_cast<GLsizei>(_layers));
+        }
+
+        _retired.push_back(_storage);
+        _storage = storage;
+        _first_level = first_level;
+    }
+
+    void texture_array::set_first_level(const uint32_t first_level) {
+        std::lock_guard lock(_storage_lock);
+        if (first_level != _first_level && first_level < _levels) {
+            resize_storage(first_level);
+        }
+    }
+
+    void texture_array::bind() {
+        glBindTexture(GL_TEXTURE_2D_ARRAY, _published.load(std::memory_order::acquire));
+    }
+
+    void texture_array::mark_ready() {
+        std::lock_guard lock(_storage_lock);
+        _published.store(_storage, std::memory_order::release);
+        if (!_retired.empty()) {
+            glDeleteTextures(static_cast<GLsizei>(_retired.size()), _retired.data());
+            _retired.clear();
+        }
+    }
+
+    size_t texture_array::level_size(const uint32_t level) const {
+        const auto w = std::max(_width >> level, 1u);
+        const auto h = std::max(_height >> level, 1u);
+        switch (_format) {
+            case io::blp::blp_format::bc1:
+            case io::blp::blp_format::bc2:
+            case io::blp::blp_format::bc3:
+                return compressed_size(_format, w, h);
+            default:
+                return static_cast<size_t>(w) * h * 4;
+        }
+    }
+
+    size_t texture_array::storage_size(const uint32_t first_level) const {
+        size_t size = 0;
+        for (auto level = first_level; level < _levels; ++level) {
+            size += level_size(level) * _layers;
+        }
+
+        return size;
+    }
+
+    void texture_array::load_blp(const uint32_t layer, const io::blp::blp_file_ptr &blp, const uint32_t first_level) {
+        for (auto i = first_level; i < _levels && i < blp->layer_count(); ++i) {
+            if (!load_blp_level(layer, blp, i)) {
+                return;
+            }
+        }
+    }
+
+    bool texture_array::load_blp_level(const uint32_t layer, const io::blp::blp_file_ptr &blp, const uint32_t level) {
+        if (layer >= _layers) {
+            SPDLOG_WARN("Texture array layer {} out of range ({})", layer, _layers);
+            return false;
+        }
+
+        if (level >= _levels || level >= blp->layer_count()) {
+            return false;
+        }
+
+        std::lock_guard lock(_storage_lock);
+        if (!_storage) {
+            _first_level = std::min(_first_level, level);
+            _storage = allocate(_first_level);
+        } else if (level < _first_level) {
+            resize_storage(level);
+        }
+
+        glBindTexture(GL_TEXTURE_2D_ARRAY, _storage);
+        const auto storage_level = static_cast<GLint>(level - _first_level);
+        const auto w = std::max(_width >> level, 1u);
+        const auto h = std::max(_height >> level, 1u);
+        const auto format = internal_format(_format);
+
+        const auto data = blp->get_layer(level);
+        switch (_format) {
+            case io::blp::blp_format::bc1:
+            case io::blp::blp_format::bc2:
+            case io::blp::blp_format::bc3: {
+                const auto size = compressed_size(_format, w, h);
+                if (data.size() < size) {
+                    SPDLOG_WARN("BLP mip level {} is truncated ({} < {})", level, data.size(), size);
+                    return false;
+                }
+
+                glCompressedTexSubImage3D(GL_TEXTURE_2D_ARRAY, storage_level, 0, 0,
+                                          static_cast<GLint>(layer), static_cast<GLsizei>(w),
+                                          static_cast<GLsizei>(h), 1, format, static_cast<GLsizei>(size),
+                                          data.data());
+                break;
+            }
+
+            case io::blp::blp_format::rgb:
+                if (data.size() < static_cast<size_t>(w) * h * 4) {
+                    SPDLOG_WARN("BLP mip level {} is truncated", level);
+                    return false;
+                }
+
+                glTexSubImage3D(GL_TEXTURE_2D_ARRAY, storage_level, 0, 0, static_cast<GLint>(layer),
+                                static_cast<GLsizei>(w), static_cast<GLsizei>(h), 1, GL_RGBA, GL_UNSIGNED_BYTE,
+                                data.data());
+                break;
+
+            case io::blp::blp_format::rgb_palette: {
+                const auto unwrapped = blp->palette_layer_to_rgba(level);
+                glTexSubImage3D(GL_TEXTURE_2D_ARRAY, storage_level, 0, 0, static_cast<GLint>(layer),
+                                static_cast<GLsizei>(w), static_cast<GLsizei>(h), 1, GL_RGBA, GL_UNSIGNED_BYTE,
+                                unwrapped.data());
+                break;
+            }
+
+            default:
+                throw std::runtime_error("Unsupported BLP format");
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,76 @@
+#ifndef WOW_UNIX_TEXTURE_ARRAY_H
+#define WOW_UNIX_TEXTURE_ARRAY_H
+
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+extern "C" {
+#include <glad/gl.h>
+}
+
+#include "bindable_texture.h"
+#include "io/blp/blp_file.h"
+
+namespace wow::gl {
+    class texture_array : public bindable_texture {
+        std::mutex _storage_lock{};
+        GLuint _storage{};
+        uint32_t _first_level;
+        std::vector<GLuint> _retired{};
+        std::atomic<GLuint> _published{};
+
+        uint32_t _width;
+        uint32_t _height;
+        uint32_t _levels;
+        uint32_t _layers;
+        io::blp::blp_format _format;
+
+        [[nodiscard]] GLuint allocate(uint32_t first_level) const;
+
+        void resize_storage(uint32_t first_level);
+
+    public:
+        texture_array(uint32_t width, uint32_t height, uint32_t levels, uint32_t layers, io::blp::blp_format format,
+                      uint32_t first_level = 0);
+
+        ~texture_array() override;
+
+        texture_array(const texture_array &) = delete;
+
+        texture_array &operator=(const texture_array &) = delete;
+
+        void bind() override;
+
+        void load_blp(uint32_t layer, const io::blp::blp_file_ptr &blp, uint32_t first_level = 0);
+
+        bool load_blp_level(uint32_t layer, const io::blp::blp_file_ptr &blp, uint32_t level);
+
+        void set_first_level(uint32_t first_level);
+
+        [[nodiscard]] size_t level_size(uint32_t level) const;
+
+        [[nodiscard]] size_t storage_size(uint32_t first_level) const;
+
+        void mark_ready();
+
+        [[nodiscard]] uint32_t levels() const {
+            return _levels;
+        }
+
+        [[nodiscard]] uint32_t layers() const {
+            return _layers;
+        }
+    };
+
+    using texture_array_ptr = std::shared_ptr<texture_array>;
+
+    inline texture_array_ptr make_texture_array(const uint32_t width, const uint32_t height, const uint32_t levels,
+                                                const uint32_t layers, const io::blp::blp_format format,
+                                                const uint32_t first_level = 0) {
+        return std::make_shared<texture_array>(width, height, levels, layers, format, first_level);
+    }
+}
+
+#endif //WOW_UNIX_TEXTURE_ARRAY_H
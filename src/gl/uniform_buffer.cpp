@@ -19,4 +19,8 @@ namespace wow::gl {
     void uniform_buffer::bind() const {
         glBindBuffer(GL_UNIFORM_BUFFER, _buffer);
     }
+
+    void uniform_buffer::bind_base(const uint32_t index) const {
+        glBindBufferBase(GL_UNIFORM_BUFFER, index, _buffer);
+    }
 }
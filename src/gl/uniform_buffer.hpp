@@ -35,6 +35,8 @@ namespace wow::gl {
         }
 
         void bind() const;
+
+        void bind_base(uint32_t index) const;
     };
 
     typedef std::shared_ptr<uniform_buffer> uniform_buffer_ptr;
@@ -0,0 +1,173 @@
+#include "upload_context.h"
+
+#ifndef _WIN32
+#define GLFW_EXPOSE_NATIVE_EGL
+#include <GLFW/glfw3native.h>
+#endif
+
+#include "spdlog/spdlog.h"
+
+namespace wow::gl {
+    upload_fence::upload_fence() {
+        _fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+        glFlush();
+    }
+
+    upload_fence::~upload_fence() {
+        glDeleteSync(_fence);
+    }
+
+    void upload_fence::wait() const {
+        glWaitSync(_fence, 0, GL_TIMEOUT_IGNORED);
+    }
+
+    upload_context::~upload_context() {
+        shutdown();
+    }
+
+    bool upload_context::initialize(GLFWwindow *shared_window) {
+        if (_thread.joinable()) {
+            return true;
+        }
+
+#ifndef _WIN32
+        if (glfwGetWindowAttrib(shared_window, GLFW_CONTEXT_CREATION_API) == GLFW_EGL_CONTEXT_API) {
+            if (auto context = egl_context::create_shared(glfwGetEGLDisplay(), glfwGetEGLContext(shared_window))) {
+                return initialize(std::move(context));
+            }
+
+            SPDLOG_WARN("Cannot create surfaceless EGL upload context, falling back to a hidden window");
+        }
+#endif
+
+        glfwWindowHint(GLFW_VISIBLE, GLFW_FALSE);
+        _window = glfwCreateWindow(1, 1, "wow-unix-upload", nullptr, shared_window);
+        glfwWindowHint(GLFW_VISIBLE, GLFW_TRUE);
+
+        if (!_window) {
+            SPDLOG_WARN("Cannot create shared upload context, uploads stay on the render thread");
+            return false;
+        }
+
+        start();
+        return true;
+    }
+
+#ifndef _WIN32
+    bool upload_context::initialize(egl_context_ptr context) {
+        if (_thread.joinable()) {
+            return true;
+        }
+
+        if (!context) {
+            return false;
+        }
+
+        _egl_context = std::move(context);
+        SPDLOG_INFO("Using a surfaceless EGL upload context");
+        start();
+        return true;
+    }
+#endif
+
+    void upload_context::start() {
+        {
+            std::lock_guard lock(_lock);
+            _running = true;
+        }
+
+        _thread = std::thread(&upload_context::upload_thread, this);
+        _active.store(true, std::memory_order::release);
+    }
+
+    void upload_context::shutdown() {
+        if (!_thread.joinable()) {
+            return;
+        }
+
+        _active.store(false, std::memory_order::release);
+        {
+            std::lock_guard lock(_lock);
+            _running = false;
+        }
+
+        _work_cv.notify_all();
+        _thread.join();
+
+#ifndef _WIN32
+        _egl_context.reset();
+#endif
+        if (_window) {
+            glfwDestroyWindow(_window);
+            _window = nullptr;
+        }
+    }
+
+    bool upload_context::submit(task_t &&task) {
+        {
+            std::lock_guard lock(_lock);
+            if (!_running) {
+                SPDLOG_WARN("Upload context is not running, rejecting upload task");
+                return false;
+            }
+
+            _work_queue.push_back(std::move(task));
+        }
+
+        _work_cv.notify_one();
+        return true;
+    }
+
+    void upload_context::make_current() const {
+#ifndef _WIN32
+        if (_egl_context) {
+            if (!_egl_context->make_current()) {
+                SPDLOG_ERROR("Cannot make the EGL upload context current: 0x{:X}", eglGetError());
+            }
+
+            return;
+        }
+#endif
+        glfwMakeContextCurrent(_window);
+    }
+
+    void upload_context::release_current() const {
+#ifndef _WIN32
+        if (_egl_context) {
+            _egl_context->release_current();
+            return;
+        }
+#endif
+        glfwMakeContextCurrent(nullptr);
+    }
+
+    void upload_context::upload_thread() {
+        make_current();
+        SPDLOG_INFO("Upload context started");
+
+        while (true) {
+            task_t task{};
+            {
+                std::unique_lock lock(_lock);
+                _work_cv.wait(lock, [this] { return !_running || !_work_queue.empty(); });
+                if (_work_queue.empty()) {
+                    break;
+                }
+
+                task = std::move(_work_queue.front());
+                _work_queue.pop_front();
+            }
+
+            task();
+        }
+
+        glFinish();
+        release_current();
+        SPDLOG_INFO("Upload context stopped");
+    }
+
+    upload_context &upload_context::instance() {
+        static upload_context context{};
+        return context;
+    }
+}
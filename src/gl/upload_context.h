@@ -0,0 +1,91 @@
+#ifndef WOW_UNIX_UPLOAD_CONTEXT_H
+#define WOW_UNIX_UPLOAD_CONTEXT_H
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+extern "C" {
+#include <glad/gl.h>
+#include <GLFW/glfw3.h>
+}
+
+#ifndef _WIN32
+#include "egl_context.h"
+#endif
+
+namespace wow::gl {
+    class upload_fence {
+        GLsync _fence{};
+
+    public:
+        upload_fence();
+
+        ~upload_fence();
+
+        upload_fence(const upload_fence &) = delete;
+
+        upload_fence &operator=(const upload_fence &) = delete;
+
+        void wait() const;
+    };
+
+    using upload_fence_ptr = std::shared_ptr<upload_fence>;
+
+    class upload_context {
+    public:
+        using task_t = std::function<void()>;
+
+    private:
+        GLFWwindow *_window = nullptr;
+#ifndef _WIN32
+        egl_context_ptr _egl_context{};
+#endif
+        std::thread _thread{};
+
+        std::mutex _lock{};
+        std::condition_variable _work_cv{};
+        std::deque<task_t> _work_queue{};
+        bool _running = false;
+        std::atomic_bool _active{false};
+
+        void start();
+
+        void make_current() const;
+
+        void release_current() const;
+
+        void upload_thread();
+
+    public:
+        upload_context() = default;
+
+        ~upload_context();
+
+        upload_context(const upload_context &) = delete;
+
+        upload_context &operator=(const upload_context &) = delete;
+
+        bool initialize(GLFWwindow *shared_window);
+
+#ifndef _WIN32
+        bool initialize(egl_context_ptr context);
+#endif
+
+        void shutdown();
+
+        [[nodiscard]] bool is_active() const {
+            return _active.load(std::memory_order::acquire);
+        }
+
+        bool submit(task_t &&task);
+
+        static upload_context &instance();
+    };
+}
+
+#endif //WOW_UNIX_UPLOAD_CONTEXT_H
@@ -0,0 +1,152 @@
+#include "upload_ring.h"
+
+#include "spdlog/spdlog.h"
+
+namespace wow::gl {
+    upload_ring::~upload_ring() {
+        if (_buffer != 0) {
+            glDeleteBuffers(1, &_buffer);
+        }
+    }
+
+    void upload_ring::initialize(const size_t capacity) {
+        if (_buffer != 0) {
+            return;
+        }
+
+        if (!GLAD_GL_VERSION_4_4) {
+            SPDLOG_WARN("GL_ARB_buffer_storage is not available, streaming uploads use glBufferData");
+            return;
+        }
+
+        constexpr GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_PERSISTENT_BIT | GL_MAP_COHERENT_BIT;
+
+        glGenBuffers(1, &_buffer);
+        glBindBuffer(GL_COPY_READ_BUFFER, _buffer);
+        glBufferStorage(GL_COPY_READ_BUFFER, static_cast<GLsizeiptr>(capacity), nullptr, flags);
+        _memory = static_cast<uint8_t *>(glMapBufferRange(GL_COPY_READ_BUFFER, 0,
+                                                          static_cast<GLsizeiptr>(capacity), flags));
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+
+        if (!_memory) {
+            SPDLOG_ERROR("Failed to map upload ring buffer of {} bytes", capacity);
+            glDeleteBuffers(1, &_buffer);
+            _buffer = 0;
+            return;
+        }
+
+        _capacity = capacity;
+        SPDLOG_INFO("Mapped {}MB persistent upload ring", capacity / (1024 * 1024));
+    }
+
+    std::optional<upload_allocation> upload_ring::try_reserve(const size_t size, const size_t alignment) {
+        auto offset = (_head + alignment - 1) / alignment * alignment;
+        if (offset + size > _capacity) {
+            offset = 0;
+        }
+
+        const auto end = offset + size;
+        const auto consumed = offset >= _head ? end - _head : _capacity - _head + end;
+        if (consumed > _capacity - _used) {
+            return std::nullopt;
+        }
+
+        upload_allocation allocation{};
+        allocation.sequence = _first_sequence + _regions.size();
+        allocation.offset = offset;
+        allocation.size = size;
+        allocation.data = _memory + offset;
+
+        _regions.push_back({end, consumed});
+        _head = end % _capacity;
+        _used += consumed;
+        return allocation;
+    }
+
+    std::optional<upload_allocation> upload_ring::allocate(const size_t size, const size_t alignment,
+                                                           const bool wait) {
+        if (!is_enabled() || size == 0 || size + alignment > _capacity) {
+            return std::nullopt;
+        }
+
+        std::unique_lock lock{_lock};
+        auto allocation = try_reserve(size, alignment);
+        while (!allocation && wait) {
+            _space_available.wait(lock);
+            allocation = try_reserve(size, alignment);
+        }
+
+        return allocation;
+    }
+
+    void upload_ring::release_locked(const upload_allocation &allocation) {
+        if (allocation.sequence < _first_sequence ||
+            allocation.sequence - _first_sequence >= _regions.size()) {
+            SPDLOG_WARN("Releasing unknown upload ring allocation {}", allocation.sequence);
+            return;
+        }
+
+        _regions[allocation.sequence - _first_sequence].released = true;
+    }
+
+    void upload_ring::release(const upload_allocation &allocation) {
+        std::lock_guard lock{_lock};
+        release_locked(allocation);
+    }
+
+    void upload_ring::copy_to_buffer(const upload_allocation &allocation, const GLuint buffer, const size_t offset) {
+        glBindBuffer(GL_COPY_READ_BUFFER, _buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glCopyBufferSubData(GL_COPY_READ_BUFFER, GL_COPY_WRITE_BUFFER, static_cast<GLintptr>(allocation.offset),
+                            static_cast<GLintptr>(offset), static_cast<GLsizeiptr>(allocation.size));
+        glBindBuffer(GL_COPY_WRITE_BUFFER, 0);
+        glBindBuffer(GL_COPY_READ_BUFFER, 0);
+    }
+
+    void upload_ring::end_frame() {
+        if (!is_enabled()) {
+            return;
+        }
+
+        std::shared_ptr<sync_object> sync{};
+        auto retired = false;
+
+        std::lock_guard lock{_lock};
+        for (auto &region: _regions) {
+            if (region.released && !region.sync) {
+                if (!sync) {
+                    sync = std::make_shared<sync_object>();
+                    sync->fence = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+                }
+
+                region.sync = sync;
+            }
+        }
+
+        while (!_regions.empty()) {
+            const auto &front = _regions.front();
+            if (!front.sync || front.sync == sync) {
+                break;
+            }
+
+            if (const auto status = glClientWaitSync(front.sync->fence, 0, 0);
+                status != GL_ALREADY_SIGNALED && status != GL_CONDITION_SATISFIED) {
+                break;
+            }
+
+            _used -= front.consumed;
+            _regions.pop_front();
+            ++_first_sequence;
+            retired = true;
+        }
+
+        if (retired) {
+            _space_available.notify_all();
+        }
+    }
+
+    upload_ring &upload_ring::instance() {
+        static upload_ring ring{};
+        return ring;
+    }
+}
@@ -0,0 +1,93 @@
+#ifndef WOW_UNIX_UPLOAD_RING_H
+#define WOW_UNIX_UPLOAD_RING_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+extern "C" {
+#include <glad/gl.h>
+}
+
+namespace wow::gl {
+    inline constexpr size_t UPLOAD_RING_SIZE = 64 * 1024 * 1024;
+    inline constexpr size_t UPLOAD_RING_ALIGNMENT = 16;
+
+    struct upload_allocation {
+        uint64_t sequence = 0;
+        size_t offset = 0;
+        size_t size = 0;
+        void *data = nullptr;
+    };
+
+    class upload_ring {
+        struct sync_object {
+            GLsync fence{};
+
+            ~sync_object() {
+                glDeleteSync(fence);
+            }
+        };
+
+        struct region {
+            size_t end = 0;
+            size_t consumed = 0;
+            bool released = false;
+            std::shared_ptr<sync_object> sync{};
+        };
+
+        GLuint _buffer{};
+        uint8_t *_memory = nullptr;
+        size_t _capacity = 0;
+
+        std::mutex _lock{};
+        std::condition_variable _space_available{};
+        std::deque<region> _regions{};
+        uint64_t _first_sequence = 0;
+        size_t _head = 0;
+        size_t _used = 0;
+
+        std::optional<upload_allocation> try_reserve(size_t size, size_t alignment);
+
+        void release_locked(const upload_allocation &allocation);
+
+    public:
+        upload_ring() = default;
+
+        ~upload_ring();
+
+        upload_ring(const upload_ring &) = delete;
+
+        upload_ring &operator=(const upload_ring &) = delete;
+
+        void initialize(size_t capacity);
+
+        [[nodiscard]] bool is_enabled() const {
+            return _memory != nullptr;
+        }
+
+        std::optional<upload_allocation> allocate(size_t size, size_t alignment = UPLOAD_RING_ALIGNMENT,
+                                                  bool wait = true);
+
+        void release(const upload_allocation &allocation);
+
+        void copy_to_buffer(const upload_allocation &allocation, GLuint buffer, size_t offset = 0);
+
+        template<typename T>
+        void unpack(const upload_allocation &allocation, T &&upload) {
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _buffer);
+            upload(reinterpret_cast<const void *>(allocation.offset));
+            glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0);
+            release(allocation);
+        }
+
+        void end_frame();
+
+        static upload_ring &instance();
+    };
+}
+
+#endif //WOW_UNIX_UPLOAD_RING_H
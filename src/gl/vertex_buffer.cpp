@@ -25,4 +25,8 @@ namespace wow::gl {
         glBufferData(GL_ARRAY_BUFFER, static_cast<GLsizeiptr>(size), data, GL_STATIC_DRAW);
         unbind();
     }
+
+    void vertex_buffer::allocate(const size_t size) {
+        set_data(nullptr, size);
+    }
 }
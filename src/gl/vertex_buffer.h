@@ -24,6 +24,12 @@ namespace wow::gl {
 
         void set_data(const void *data, size_t size);
 
+        void allocate(size_t size);
+
+        [[nodiscard]] GLuint native() const {
+            return _buffer;
+        }
+
         template<typename T>
         void set_data(const std::vector<T> &data) {
             set_data(data.data(), data.size() * sizeof(T));
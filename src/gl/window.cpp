@@ -6,6 +6,8 @@
 
 #include "mesh.h"
 #include "texture.h"
+#include "upload_context.h"
+#include "upload_ring.h"
 #include "spdlog/spdlog.h"
 #include "utils/di.h"
 
@@ -55,7 +57,7 @@ namespace wow::gl {
         utils::app_module->camera()->update_aspect_ratio(static_cast<float>(width) / static_cast<float>(height));
     }
 
-    window::window() {
+    window::window(const config::config_manager_ptr &config_manager) {
         if (!glfwInit()) {
             report_glfw_error("Cannot initialize GLFW");
             throw std::runtime_error("Cannot initialize GLFW");
@@ -149,7 +151,11 @@ namespace wow::gl {
         }
 
         texture::initialize_default_texture();
+        upload_ring::instance().initialize(UPLOAD_RING_SIZE);
         mesh::terrain_mesh();
+        if (config_manager->render().upload_thread) {
+            upload_context::instance().initialize(_window);
+        }
 
         glDebugMessageCallback(gl_debug_callback, nullptr);
         glEnable(GL_DEBUG_OUTPUT);
@@ -186,10 +192,15 @@ namespace wow::gl {
     }
 
     void window::end_frame() const {
+        upload_ring::instance().end_frame();
+
+        const auto swap_start = std::chrono::steady_clock::now();
         glfwSwapBuffers(_window);
+        _swap_wait = std::chrono::steady_clock::now() - swap_start;
     }
 
     void window::terminate() {
+        upload_context::instance().shutdown();
         glfwDestroyWindow(_window);
         glfwTerminate();
         _window = nullptr;
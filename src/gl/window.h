@@ -1,6 +1,7 @@
 #ifndef WOW_UNIX_WINDOW_H
 #define WOW_UNIX_WINDOW_H
 
+#include <chrono>
 #include <memory>
 #include <string>
 #include <functional>
@@ -12,6 +13,7 @@ extern "C" {
 #include <GLFW/glfw3.h>
 }
 #include "glm/vec2.hpp"
+#include "config/config_manager.h"
 
 #ifndef _WIN32
 #define GLFW_EXPOSE_NATIVE_X11
@@ -34,6 +36,7 @@ namespace wow::gl {
 
     private:
         GLFWwindow *_window{};
+        mutable std::chrono::steady_clock::duration _swap_wait{};
 
         std::mutex _callback_lock{};
         std::vector<mouse_move_callback> _mouse_move_callbacks{};
@@ -49,7 +52,7 @@ namespace wow::gl {
         void on_resize(int width, int height) const;
 
     public:
-        window();
+        explicit window(const config::config_manager_ptr &config_manager);
 
         void add_mouse_move_callback(mouse_move_callback cb) {
             std::lock_guard lock(_callback_lock);
@@ -94,6 +97,10 @@ namespace wow::gl {
 
         void end_frame() const;
 
+        [[nodiscard]] std::chrono::steady_clock::duration swap_wait() const {
+            return _swap_wait;
+        }
+
         void terminate();
 
         [[nodiscard]] std::pair<int, int> size() const;
@@ -137,8 +144,8 @@ namespace wow::gl {
 
     using window_ptr = std::shared_ptr<window>;
 
-    inline window_ptr make_window() {
-        return std::make_shared<window>();
+    inline window_ptr make_window(const config::config_manager_ptr &config_manager) {
+        return std::make_shared<window>(config_manager);
     }
 }
 
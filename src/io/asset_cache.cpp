@@ -0,0 +1,129 @@
+#include "asset_cache.h"
+
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <thread>
+
+#include "spdlog/spdlog.h"
+#include "utils/mapped_file.h"
+
+namespace wow::io {
+    uint64_t asset_cache::hash_key(const std::string &key) {
+        uint64_t hash = 0xcbf29ce484222325ull;
+        for (const auto ch: key) {
+            hash ^= static_cast<uint8_t>(ch);
+            hash *= 0x100000001b3ull;
+        }
+
+        return hash;
+    }
+
+    std::filesystem::path asset_cache::entry_path(const std::string &kind, const uint64_t key_hash) const {
+        return _directory / kind / fmt::format("{:016x}.bin", key_hash);
+    }
+
+    asset_cache::asset_cache(const config::config_manager_ptr &config_manager) {
+        const auto &config = config_manager->cache();
+        if (!config.enabled) {
+            return;
+        }
+
+        _directory = std::filesystem::absolute(config.directory) / fmt::format("v{}", ASSET_CACHE_VERSION);
+
+        std::error_code error{};
+        std::filesystem::create_directories(_directory, error);
+        if (error) {
+            SPDLOG_WARN("Cannot create asset cache directory {}: {}", _directory.string(), error.message());
+            return;
+        }
+
+        _is_enabled = true;
+        SPDLOG_INFO("Using asset cache in {}", _directory.string());
+    }
+
+    utils::binary_reader_ptr asset_cache::load(const std::string &kind, const std::string &key) const {
+        if (!_is_enabled) {
+            return nullptr;
+        }
+
+        const auto key_hash = hash_key(key);
+        const auto path = entry_path(kind, key_hash);
+        if (!std::filesystem::exists(path)) {
+            return nullptr;
+        }
+
+        const auto file = utils::make_mapped_file(path.string());
+        if (!file || file->size() < sizeof(entry_header)) {
+            return nullptr;
+        }
+
+        entry_header header{};
+        memcpy(&header, file->data(), sizeof(entry_header));
+        if (header.magic != 'WACE' || header.version != ASSET_CACHE_VERSION || header.key_hash != key_hash ||
+            header.key_length != key.size()) {
+            return nullptr;
+        }
+
+        const auto stored_key = file->view(sizeof(entry_header), header.key_length);
+        if (stored_key.size() != key.size() || memcmp(stored_key.data(), key.data(), key.size()) != 0) {
+            return nullptr;
+        }
+
+        const auto payload = file->view(sizeof(entry_header) + header.key_length, header.payload_size);
+        if (payload.size() != header.payload_size) {
+            SPDLOG_WARN("Ignoring truncated asset cache entry {}", path.string());
+            return nullptr;
+        }
+
+        return std::make_shared<utils::binary_reader>(payload, file);
+    }
+
+    void asset_cache::store(const std::string &kind, const std::string &key, const std::span<const uint8_t> data) const {
+        if (!_is_enabled) {
+            return;
+        }
+
+        const auto key_hash = hash_key(key);
+        const auto path = entry_path(kind, key_hash);
+
+        std::error_code error{};
+        std::filesystem::create_directories(path.parent_path(), error);
+        if (error) {
+            SPDLOG_WARN("Cannot create asset cache directory {}: {}", path.parent_path().string(), error.message());
+            return;
+        }
+
+        std::stringstream thread_id{};
+        thread_id << std::this_thread::get_id();
+        auto temp_path = path;
+        temp_path += fmt::format(".{}.tmp", thread_id.str());
+
+        const entry_header header{
+            .magic = 'WACE',
+            .version = ASSET_CACHE_VERSION,
+            .key_hash = key_hash,
+            .key_length = static_cast<uint32_t>(key.size()),
+            .payload_size = data.size()
+        };
+
+        {
+            std::ofstream stream{temp_path, std::ios::binary | std::ios::trunc};
+            stream.write(reinterpret_cast<const char *>(&header), sizeof(header));
+            stream.write(key.data(), static_cast<std::streamsize>(key.size()));
+            stream.write(reinterpret_cast<const char *>(data.data()), static_cast<std::streamsize>(data.size()));
+            if (!stream) {
+                SPDLOG_WARN("Cannot write asset cache entry {}", temp_path.string());
+                stream.close();
+                std::filesystem::remove(temp_path, error);
+                return;
+            }
+        }
+
+        std::filesystem::rename(temp_path, path, error);
+        if (error) {
+            SPDLOG_WARN("Cannot commit asset cache entry {}: {}", path.string(), error.message());
+            std::filesystem::remove(temp_path, error);
+        }
+    }
+}
@@ -0,0 +1,49 @@
+#ifndef WOW_UNIX_ASSET_CACHE_H
+#define WOW_UNIX_ASSET_CACHE_H
+
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <span>
+#include <string>
+
+#include "config/config_manager.h"
+#include "utils/io.h"
+
+namespace wow::io {
+    inline constexpr uint32_t ASSET_CACHE_VERSION = 2;
+
+    class asset_cache {
+#pragma pack(push, 1)
+        struct entry_header {
+            uint32_t magic;
+            uint32_t version;
+            uint64_t key_hash;
+            uint32_t key_length;
+            uint64_t payload_size;
+        };
+#pragma pack(pop)
+
+        std::filesystem::path _directory{};
+        bool _is_enabled = false;
+
+        static uint64_t hash_key(const std::string &key);
+
+        [[nodiscard]] std::filesystem::path entry_path(const std::string &kind, uint64_t key_hash) const;
+
+    public:
+        explicit asset_cache(const config::config_manager_ptr &config_manager);
+
+        [[nodiscard]] bool is_enabled() const {
+            return _is_enabled;
+        }
+
+        [[nodiscard]] utils::binary_reader_ptr load(const std::string &kind, const std::string &key) const;
+
+        void store(const std::string &kind, const std::string &key, std::span<const uint8_t> data) const;
+    };
+
+    using asset_cache_ptr = std::shared_ptr<asset_cache>;
+}
+
+#endif //WOW_UNIX_ASSET_CACHE_H
@@ -0,0 +1,239 @@
+#include "bc_decoder.h"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define WOW_UNIX_BC_DECODER_SSE 1
+#include <immintrin.h>
+#endif
+
+namespace wow::io::blp {
+    namespace {
+        enum class bc_format {
+            bc1,
+            bc2,
+            bc3
+        };
+
+        template<bc_format format>
+        struct bc_traits;
+
+        template<>
+        struct bc_traits<bc_format::bc1> {
+            static constexpr size_t block_size = 8;
+            static constexpr size_t color_offset = 0;
+            static constexpr bool three_color_mode = true;
+        };
+
+        template<>
+        struct bc_traits<bc_format::bc2> {
+            static constexpr size_t block_size = 16;
+            static constexpr size_t color_offset = 8;
+            static constexpr bool three_color_mode = false;
+        };
+
+        template<>
+        struct bc_traits<bc_format::bc3> {
+            static constexpr size_t block_size = 16;
+            static constexpr size_t color_offset = 8;
+            static constexpr bool three_color_mode = false;
+        };
+
+        constexpr auto row_index_table = [] {
+            std::array<std::array<uint32_t, 4>, 256> table{};
+            for (auto bits = 0u; bits < 256; ++bits) {
+                for (auto i = 0u; i < 4; ++i) {
+                    table[bits][i] = (bits >> (i * 2)) & 0x3;
+                }
+            }
+
+            return table;
+        }();
+
+        template<typename T>
+        T load(const uint8_t *data) {
+            T value{};
+            memcpy(&value, data, sizeof(T));
+            return value;
+        }
+
+        uint32_t expand_565(const uint32_t color) {
+            const auto low = color & 0x1Fu;
+            const auto green = color >> 5u & 0x3Fu;
+            const auto high = color >> 11u & 0x1Fu;
+
+            return ((high << 3u) | (high >> 2u)) |
+                   (((green << 2u) | (green >> 4u)) << 8u) |
+                   (((low << 3u) | (low >> 2u)) << 16u) |
+                   0xFF000000u;
+        }
+
+        uint32_t blend_channels(const uint32_t a, const uint32_t b, const uint32_t weight_a, const uint32_t weight_b,
+                                const uint32_t divisor) {
+            uint32_t result = 0xFF000000u;
+            for (auto shift = 0u; shift < 24; shift += 8) {
+                const auto value = (weight_a * ((a >> shift) & 0xFF) + weight_b * ((b >> shift) & 0xFF)) / divisor;
+                result |= value << shift;
+            }
+
+            return result;
+        }
+
+        template<bc_format format>
+        std::array<uint32_t, 4> color_palette(const uint8_t *block) {
+            const auto color0 = load<uint16_t>(block);
+            const auto color1 = load<uint16_t>(block + 2);
+
+            std::array<uint32_t, 4> palette{};
+            palette[0] = expand_565(color0);
+            palette[1] = expand_565(color1);
+
+            if (!bc_traits<format>::three_color_mode || color0 > color1) {
+                palette[2] = blend_channels(palette[0], palette[1], 2, 1, 3);
+                palette[3] = blend_channels(palette[0], palette[1], 1, 2, 3);
+            } else {
+                palette[2] = blend_channels(palette[0], palette[1], 1, 1, 2);
+                palette[3] = 0;
+            }
+
+            return palette;
+        }
+
+        template<bc_format format>
+        std::array<uint8_t, 16> alpha_values(const uint8_t *block) {
+            std::array<uint8_t, 16> alpha{};
+            if constexpr (format == bc_format::bc2) {
+                const auto bits = load<uint64_t>(block);
+                for (auto i = 0u; i < 16; ++i) {
+                    alpha[i] = static_cast<uint8_t>(((bits >> (i * 4)) & 0xF) * 17);
+                }
+            } else if constexpr (format == bc_format::bc3) {
+                const uint32_t alpha0 = block[0];
+                const uint32_t alpha1 = block[1];
+
+                std::array<uint8_t, 8> palette{static_cast<uint8_t>(alpha0), static_cast<uint8_t>(alpha1)};
+                if (alpha0 > alpha1) {
+                    for (auto i = 0u; i < 6; ++i) {
+                        palette[i + 2] = static_cast<uint8_t>(((6 - i) * alpha0 + (1 + i) * alpha1) / 7);
+                    }
+                } else {
+                    for (auto i = 0u; i < 4; ++i) {
+                        palette[i + 2] = static_cast<uint8_t>(((4 - i) * alpha0 + (1 + i) * alpha1) / 5);
+                    }
+
+                    palette[6] = 0;
+                    palette[7] = 0xFF;
+                }
+
+                uint64_t bits = 0;
+                memcpy(&bits, block + 2, 6);
+                for (auto i = 0u; i < 16; ++i) {
+                    alpha[i] = palette[(bits >> (i * 3)) & 0x7];
+                }
+            }
+
+            return alpha;
+        }
+
+        template<bc_format format>
+        void decode_block(const uint8_t *block, uint8_t *output, const size_t stride) {
+            const auto color_block = block + bc_traits<format>::color_offset;
+            const auto palette = color_palette<format>(color_block);
+            const auto indices = load<uint32_t>(color_block + 4);
+
+            [[maybe_unused]] const auto alpha = alpha_values<format>(block);
+
+#ifdef WOW_UNIX_BC_DECODER_SSE
+            const auto zero = _mm_setzero_si128();
+            [[maybe_unused]] const auto rgb_mask = _mm_set1_epi32(0x00FFFFFF);
+            [[maybe_unused]] __m128i alpha_rows[4]{};
+            if constexpr (format != bc_format::bc1) {
+                const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(alpha.data()));
+                const auto low = _mm_unpacklo_epi8(zero, bytes);
+                const auto high = _mm_unpackhi_epi8(zero, bytes);
+                alpha_rows[0] = _mm_unpacklo_epi16(zero, low);
+                alpha_rows[1] = _mm_unpackhi_epi16(zero, low);
+                alpha_rows[2] = _mm_unpacklo_epi16(zero, high);
+                alpha_rows[3] = _mm_unpackhi_epi16(zero, high);
+            }
+
+            for (auto row = 0u; row < 4; ++row) {
+                const auto &index = row_index_table[(indices >> (row * 8)) & 0xFF];
+                auto pixels = _mm_setr_epi32(static_cast<int32_t>(palette[index[0]]),
+                                             static_cast<int32_t>(palette[index[1]]),
+                                             static_cast<int32_t>(palette[index[2]]),
+                                             static_cast<int32_t>(palette[index[3]]));
+
+                if constexpr (format != bc_format::bc1) {
+                    pixels = _mm_or_si128(_mm_and_si128(pixels, rgb_mask), alpha_rows[row]);
+                }
+
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(output + row * stride), pixels);
+            }
+#else
+            for (auto row = 0u; row < 4; ++row) {
+                const auto &index = row_index_table[(indices >> (row * 8)) & 0xFF];
+                std::array<uint32_t, 4> pixels{};
+                for (auto i = 0u; i < 4; ++i) {
+                    pixels[i] = palette[index[i]];
+                    if constexpr (format != bc_format::bc1) {
+                        pixels[i] = (pixels[i] & 0x00FFFFFF) | static_cast<uint32_t>(alpha[row * 4 + i]) << 24u;
+                    }
+                }
+
+                memcpy(output + row * stride, pixels.data(), sizeof(pixels));
+            }
+#endif
+        }
+
+        template<bc_format format>
+        void decode(const std::span<const uint8_t> blocks, const uint32_t width, const uint32_t height,
+                    uint8_t *rgba) {
+            const auto blocks_x = (width + 3) / 4;
+            const auto blocks_y = (height + 3) / 4;
+            if (blocks.size() < static_cast<size_t>(blocks_x) * blocks_y * bc_traits<format>::block_size) {
+                throw std::runtime_error("BLP layer is smaller than its block count");
+            }
+
+            const auto stride = static_cast<size_t>(width) * 4;
+            auto block = blocks.data();
+
+            for (auto by = 0u; by < blocks_y; ++by) {
+                const auto rows = std::min(4u, height - by * 4);
+                auto output = rgba + by * 4 * stride;
+
+                for (auto bx = 0u; bx < blocks_x; ++bx, block += bc_traits<format>::block_size, output += 16) {
+                    const auto columns = std::min(4u, width - bx * 4);
+                    if (rows == 4 && columns == 4) {
+                        decode_block<format>(block, output, stride);
+                        continue;
+                    }
+
+                    std::array<uint32_t, 16> pixels{};
+                    decode_block<format>(block, reinterpret_cast<uint8_t *>(pixels.data()), 16);
+                    for (auto row = 0u; row < rows; ++row) {
+                        memcpy(output + row * stride, pixels.data() + row * 4, columns * 4);
+                    }
+                }
+            }
+        }
+    }
+
+    void decode_bc1(const std::span<const uint8_t> blocks, const uint32_t width, const uint32_t height,
+                    uint8_t *rgba) {
+        decode<bc_format::bc1>(blocks, width, height, rgba);
+    }
+
+    void decode_bc2(const std::span<const uint8_t> blocks, const uint32_t width, const uint32_t height,
+                    uint8_t *rgba) {
+        decode<bc_format::bc2>(blocks, width, height, rgba);
+    }
+
+    void decode_bc3(const std::span<const uint8_t> blocks, const uint32_t width, const uint32_t height,
+                    uint8_t *rgba) {
+        decode<bc_format::bc3>(blocks, width, height, rgba);
+    }
+}
@@ -0,0 +1,15 @@
+#ifndef WOW_UNIX_BC_DECODER_H
+#define WOW_UNIX_BC_DECODER_H
+
+#include <cstdint>
+#include <span>
+
+namespace wow::io::blp {
+    void decode_bc1(std::span<const uint8_t> blocks, uint32_t width, uint32_t height, uint8_t *rgba);
+
+    void decode_bc2(std::span<const uint8_t> blocks, uint32_t width, uint32_t height, uint8_t *rgba);
+
+    void decode_bc3(std::span<const uint8_t> blocks, uint32_t width, uint32_t height, uint8_t *rgba);
+}
+
+#endif //WOW_UNIX_BC_DECODER_H
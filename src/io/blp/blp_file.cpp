@@ -1,6 +1,9 @@
 #include "blp_file.h"
+#include <algorithm>
 #include <stdexcept>
 
+#include "bc_decoder.h"
+
 namespace wow::io::blp {
     void blp_file::load_format() {
         _format = blp_format::unknown;
@@ -36,134 +39,16 @@ namespace wow::io::blp {
         }
     }
 
-    void rgb565_to_rgb8_array(const uint32_t &input, uint8_t *output) {
-        auto r = input & 0x1Fu;
-        auto g = input >> 5u & 0x3Fu;
-        auto b = input >> 11u & 0x1Fu;
-
-        r = (r << 3u) | (r >> 2u);
-        g = (g << 2u) | (g >> 4u);
-        b = (b << 3u) | (b >> 2u);
-
-        output[0] = static_cast<uint8_t>(b);
-        output[1] = static_cast<uint8_t>(g);
-        output[2] = static_cast<uint8_t>(r);
-    }
-
-    // ReSharper disable once CppDFAUnreachableFunctionCall
-    void blp_file::read_bc_colors(utils::binary_reader &reader, std::array<rgb_data_array, 4> &colors,
-                                  const bool pre_multiplied_alpha,
-                                  const bool use_4_colors) {
-        const auto color1 = reader.read<uint16_t>();
-        const auto color2 = reader.read<uint16_t>();
-
-        rgb565_to_rgb8_array(color1, colors[0].data.buffer);
-        rgb565_to_rgb8_array(color2, colors[1].data.buffer);
-
-        for (auto i = 0; i < 4; ++i) {
-            colors[i].data.buffer[3] = 0xFF;
-        }
-
-        if (use_4_colors || color1 > color2) {
-            for (auto i = 0; i < 3; ++i) {
-                colors[3].data.buffer[i] = static_cast<uint8_t>(
-                    (colors[0].data.buffer[i] + 2 * colors[1].data.buffer[i]) / 3);
-                colors[2].data.buffer[i] = static_cast<uint8_t>(
-                    (2 * colors[0].data.buffer[i] + colors[1].data.buffer[i]) / 3);
-            }
-        } else {
-            for (auto i = 0; i < 3; ++i) {
-                colors[3].data.buffer[i] = 0;
-                colors[2].data.buffer[i] = static_cast<uint8_t>(
-                    (colors[0].data.buffer[i] + colors[1].data.buffer[i]) / 2);
-            }
-
-            if (pre_multiplied_alpha) {
-                colors[3].data.buffer[3] = 0;
-            }
-        }
-    }
-
-    void blp_file::process_block_bc1(utils::binary_reader &reader, std::vector<uint32_t> &block_data,
-                                     const size_t block_offset) {
-        std::array<rgb_data_array, 4> colors{};
-        read_bc_colors(reader, colors, true, false);
-        const auto indices = reader.read<uint32_t>();
-        for (auto i = 0; i < 16; ++i) {
-            const auto idx = static_cast<uint8_t>((indices >> (i * 2)) & 0x3);
-            block_data[block_offset + i] = colors[idx].data.color;
-        }
-    }
-
-    void blp_file::process_block_bc2(utils::binary_reader &reader, std::vector<uint32_t> &block_data,
-                                     const size_t block_offset) {
-        uint8_t alpha_values[16]{};
-        const auto alpha = reader.read<uint64_t>();
-        for (auto i = 0; i < 16; ++i) {
-            alpha_values[i] = static_cast<uint8_t>((alpha >> (i * 4)) & 0xF) * 17;
-        }
-
-        std::array<rgb_data_array, 4> colors{};
-        read_bc_colors(reader, colors, false, true);
-
-        const auto indices = reader.read<uint32_t>();
-        for (auto i = 0; i < 16; ++i) {
-            const auto idx = static_cast<uint8_t>((indices >> (i * 2)) & 0x3);
-            block_data[block_offset + i] = (colors[idx].data.color & 0x00FFFFFF) | (alpha_values[i] << 24);
-        }
-    }
-
-    void blp_file::process_block_bc3(utils::binary_reader &reader, std::vector<uint32_t> &block_data,
-                                     const size_t block_offset) {
-        uint8_t alpha_values[8]{};
-        uint8_t alpha_lookup[16]{};
-
-        const auto alpha1 = static_cast<uint32_t>(reader.read<uint8_t>());
-        const auto alpha2 = static_cast<uint32_t>(reader.read<uint8_t>());
-
-        alpha_values[0] = static_cast<uint8_t>(alpha1);
-        alpha_values[1] = static_cast<uint8_t>(alpha2);
-
-        if (alpha1 > alpha2) {
-            for (auto i = 0; i < 6; ++i) {
-                alpha_values[i + 2] = static_cast<uint8_t>(((6 - i) * alpha1 + (1 + i) * alpha2) / 7);
-            }
-        } else {
-            for (auto i = 0; i < 4; ++i) {
-                alpha_values[i + 2] = static_cast<uint8_t>(((4 - i) * alpha1 + (1 + i) * alpha2) / 5);
-            }
-
-            alpha_values[6] = 0;
-            alpha_values[7] = 0xFF;
-        }
-
-        uint64_t lookup_value{};
-        reader.read(&lookup_value, 6);
-        for (auto i = 0; i < 16; ++i) {
-            alpha_lookup[i] = static_cast<uint8_t>((lookup_value >> (i * 3)) & 0x7);
-        }
-
-        std::array<rgb_data_array, 4> colors{};
-        read_bc_colors(reader, colors, false, true);
-
-        const auto indices = reader.read<uint32_t>();
-        for (auto i = 0; i < 16; ++i) {
-            const auto idx = static_cast<uint8_t>((indices >> (i * 2)) & 0x3);
-            block_data[block_offset + i] = colors[idx].data.color |
-                                           (alpha_values[alpha_lookup[i]] << 24);
-        }
-    }
-
     void blp_file::process_palette_fast_path(std::vector<uint8_t> &rgba_data,
                                              const uint32_t w, const uint32_t h,
-                                             const std::vector<uint8_t> &layer_data) const {
+                                             const std::span<const uint8_t> layer_data) const {
         std::vector<uint32_t> row_buffer(w);
 
         const auto num_entries = w * h;
         auto counter = 0;
 
-        for (auto y = 0; y < h; ++y) {
-            for (auto x = 0; x < w; ++x) {
+        for (auto y = 0u; y < h; ++y) {
+            for (auto x = 0u; x < w; ++x) {
                 const auto index = layer_data[counter];
                 const auto alpha = static_cast<uint32_t>(layer_data[num_entries + counter]);
                 const auto color = (_palette[index] & 0x00FFFFFF) | (alpha << 24);
@@ -178,12 +63,12 @@ namespace wow::io::blp {
 
     void blp_file::process_palette_full_path(std::vector<uint8_t> &rgba_data,
                                              const uint32_t w, const uint32_t h,
-                                             const std::vector<uint8_t> &layer_data) const {
+                                             const std::span<const uint8_t> layer_data) const {
         const auto num_entries = w * h;
 
         std::vector<uint32_t> color_buffer(num_entries);
 
-        for (auto i = 0; i < num_entries; ++i) {
+        for (auto i = 0u; i < num_entries; ++i) {
             const auto index = layer_data[i];
             const auto color = _palette[index];
             color_buffer[i] = color | 0xFF000000;
@@ -195,9 +80,9 @@ namespace wow::io::blp {
 
             case 1: {
                 auto counter = 0;
-                for (auto i = 0; i < (num_entries / 8) + (num_entries % 8 ? 1 : 0); ++i) {
+                for (auto i = 0u; i < (num_entries / 8) + (num_entries % 8 ? 1 : 0); ++i) {
                     const auto alpha_byte = layer_data[num_entries + i];
-                    for (auto bit = 0; bit < (i == (num_entries / 8) ? (num_entries % 8) : 8); ++bit) {
+                    for (auto bit = 0u; bit < (i == (num_entries / 8) ? (num_entries % 8) : 8); ++bit) {
                         const auto alpha = (alpha_byte & (1 << bit)) ? 0xFF : 0x00;
                         color_buffer[counter] = (color_buffer[counter] & 0x00FFFFFF) | (alpha << 24);
                         ++counter;
@@ -213,7 +98,7 @@ namespace wow::io::blp {
                 };
 
                 auto counter = 0;
-                for (auto i = 0; i < (num_entries / 2) + (num_entries % 2 ? 1 : 0); ++i) {
+                for (auto i = 0u; i < (num_entries / 2) + (num_entries % 2 ? 1 : 0); ++i) {
                     const auto alpha_byte = layer_data[num_entries + i];
                     const auto alpha1 = ALPHA_LOOKUP4[alpha_byte & 0x0F];
                     color_buffer[counter++] |= alpha1 << 24;
@@ -234,40 +119,25 @@ namespace wow::io::blp {
     void blp_file::unwrap_compressed_blp_layer(
         const uint32_t w, const uint32_t h,
         std::vector<uint8_t> &rgba_data,
-        const std::vector<uint8_t> &layer_data) const {
-        const auto converter = block_converter_function();
-
-        const auto num_blocks = ((w + 3) / 4) * ((h + 3) / 4);
-        std::vector<uint32_t> block_data(num_blocks * 16);
-
-        utils::binary_reader reader{layer_data};
-        for (auto i = 0; i < num_blocks; ++i) {
-            converter(reader, block_data, i * 16);
-        }
-
-        std::vector<uint32_t> color_buffer(w * h);
-        auto counter = 0;
-        for (auto y = 0; y < h; ++y) {
-            for (auto x = 0; x < w; ++x) {
-                const auto bx = x / 4;
-                const auto by = y / 4;
-
-                const auto ibx = x % 4;
-                const auto iby = y % 4;
-
-                const auto block_index = by * ((w + 3) / 4) + bx;
-                const auto inner_index = iby * 4 + ibx;
-                const auto color = block_data[block_index * 16 + inner_index];
-                color_buffer[counter++] = color;
-            }
+        const std::span<const uint8_t> layer_data) const {
+        switch (_format) {
+            case blp_format::bc1:
+                decode_bc1(layer_data, w, h, rgba_data.data());
+                break;
+            case blp_format::bc2:
+                decode_bc2(layer_data, w, h, rgba_data.data());
+                break;
+            case blp_format::bc3:
+                decode_bc3(layer_data, w, h, rgba_data.data());
+                break;
+            default:
+                throw std::runtime_error("Unsupported BLP compression");
         }
-
-        memcpy(rgba_data.data(), color_buffer.data(), w * h * 4);
     }
 
     void blp_file::unwrap_blp_layer_with_palette(std::vector<uint8_t> &rgba_data,
                                                  const uint32_t w, const uint32_t h,
-                                                 const std::vector<uint8_t> &layer_data) const {
+                                                 const std::span<const uint8_t> layer_data) const {
         if (_header.alpha_depth == 0) {
             process_palette_fast_path(rgba_data, w, h, layer_data);
         } else {
@@ -277,7 +147,7 @@ namespace wow::io::blp {
 
     void blp_file::unwrap_blp_layer(std::vector<uint8_t> &rgba_data, const uint32_t w, const uint32_t h,
                                     const uint32_t layer) const {
-        const auto layer_data = _mipmaps[layer];
+        const auto layer_data = get_layer(layer);
         switch (_format) {
             case blp_format::rgb: {
                 if (rgba_data.size() != layer_data.size()) {
@@ -307,11 +177,7 @@ namespace wow::io::blp {
         }
     }
 
-    blp_file::blp_file(const mpq_file_ptr &file) {
-        if (!file) {
-            throw std::runtime_error("Invalid MPQ file pointer");
-        }
-
+    void blp_file::load_header(const mpq_file_ptr &file) {
         file->read(_header);
         load_format();
 
@@ -324,80 +190,128 @@ namespace wow::io::blp {
             file->read(_palette);
         }
 
-        uint32_t mipmap_count = 0;
-
+        _mipmap_count = 0;
         for (uint32_t i = 0; i < 16; ++i) {
             if (_header.mipmap_sizes[i] > 0) {
-                mipmap_count = i + 1;
+                _mipmap_count = i + 1;
             } else {
                 break;
             }
         }
 
-        _mipmaps.resize(mipmap_count);
+        for (uint32_t i = 0; i < _mipmap_count; ++i) {
+            const auto offset = static_cast<size_t>(_header.mipmap_offsets[i]);
+            const auto size = static_cast<size_t>(_header.mipmap_sizes[i]);
+            if (offset > file->file_size() || size > file->file_size() - offset) {
+                throw std::runtime_error("BLP mipmap out of bounds");
+            }
+        }
+    }
+
+    blp_file::blp_file(const mpq_file_ptr &file) {
+        if (!file) {
+            throw std::runtime_error("Invalid MPQ file pointer");
+        }
 
-        for (uint32_t i = 0; i < mipmap_count; ++i) {
-            if (_header.mipmap_sizes[i] > 0) {
-                file->seek(_header.mipmap_offsets[i]);
-                _mipmaps[i].resize(_header.mipmap_sizes[i]);
-                file->read(_mipmaps[i]);
+        load_header(file);
+        _file = file;
+    }
+
+    blp_file::blp_file(blp_layer_source source) : _source(std::move(source)) {
+        if (!_source) {
+            throw std::runtime_error("Invalid BLP layer source");
+        }
+
+        const auto header = _source(0, sizeof(blp_header) + 256 * sizeof(uint32_t));
+        if (!header) {
+            throw std::runtime_error("Invalid MPQ file pointer");
+        }
+
+        load_header(header);
+        _layers.resize(_mipmap_count);
+    }
+
+    std::span<const uint8_t> blp_file::get_layer(const uint32_t layer) const {
+        if (layer >= _mipmap_count) {
+            throw std::out_of_range("BLP layer out of range");
+        }
+
+        const auto offset = static_cast<size_t>(_header.mipmap_offsets[layer]);
+        const auto size = static_cast<size_t>(_header.mipmap_sizes[layer]);
+
+        if (_file) {
+            return _file->full_data().subspan(offset, size);
+        }
+
+        std::lock_guard lock(_layer_lock);
+        if (!_layers[layer]) {
+            auto file = _source(offset, size);
+            if (!file || file->size() != size) {
+                throw std::runtime_error("Failed to read BLP mipmap");
             }
+
+            _layers[layer] = std::move(file);
         }
+
+        return _layers[layer]->full_data();
     }
 
-    std::vector<uint8_t> blp_file::palette_layer_to_rgba(const uint32_t layer) const {
-        if (_format != blp_format::rgb_palette) {
-            throw std::runtime_error("Invalid BLP format: Layer is not paletted");
+    void blp_file::release_layer(const uint32_t layer) const {
+        if (_file || layer >= _mipmap_count) {
+            return;
         }
 
-        std::vector<uint8_t> rgba_data{};
-        this->unwrap_blp_layer_with_palette(rgba_data, std::max(1u, _header.width >> layer),
-                                            std::max(1u, _header.height >> layer), _mipmaps[layer]);
+        std::lock_guard lock(_layer_lock);
+        _layers[layer].reset();
+    }
 
-        return rgba_data;
+    uint32_t blp_file::layer_for_dimension(const uint32_t dimension) const {
+        if (_mipmap_count == 0 || dimension >= _header.width) {
+            return 0;
+        }
+
+        for (uint32_t i = 1; i < _mipmap_count; ++i) {
+            if ((_header.width >> i) <= dimension) {
+                return i;
+            }
+        }
+
+        return _mipmap_count - 1;
     }
 
-    std::vector<uint8_t> blp_file::convert_to_rgba() const {
-        if (_format == blp_format::unknown) {
-            throw std::runtime_error("Unsupported BLP format for conversion");
+    std::vector<uint8_t> blp_file::palette_layer_to_rgba(const uint32_t layer) const {
+        if (_format != blp_format::rgb_palette) {
+            throw std::runtime_error("Invalid BLP format: Layer is not paletted");
         }
 
-        std::vector<uint8_t> rgba_data;
-        rgba_data.resize(_header.width * _header.height * 4);
-        unwrap_blp_layer(rgba_data, _header.width, _header.height, 0);
+        const auto w = std::max(1u, _header.width >> layer);
+        const auto h = std::max(1u, _header.height >> layer);
+        std::vector<uint8_t> rgba_data(w * h * 4);
+        this->unwrap_blp_layer_with_palette(rgba_data, w, h, get_layer(layer));
+
         return rgba_data;
     }
 
-    std::vector<uint8_t> blp_file::convert_to_rgba(uint32_t dimension, uint32_t &w, uint32_t &h) const {
+    std::vector<uint8_t> blp_file::layer_to_rgba(const uint32_t layer, uint32_t &w, uint32_t &h) const {
         if (_format == blp_format::unknown) {
             throw std::runtime_error("Unsupported BLP format for conversion");
         }
 
-        auto layer = 0;
-        if (dimension < _header.width) {
-            bool found = false;
-            for (int i = 1; i < _mipmaps.size(); ++i) {
-                if (const auto current_size = _header.width >> i;
-                    current_size <= dimension) {
-                    found = true;
-                    layer = i;
-                    break;
-                }
-            }
+        w = std::max(1u, _header.width >> layer);
+        h = std::max(1u, _header.height >> layer);
 
-            if (!found) {
-                layer = _mipmaps.size() - 1;
-            }
-        }
+        std::vector<uint8_t> rgba_data(w * h * 4);
+        unwrap_blp_layer(rgba_data, w, h, layer);
+        return rgba_data;
+    }
 
-        dimension = _header.width >> layer;
-        w = dimension;
-        h = dimension;
+    std::vector<uint8_t> blp_file::convert_to_rgba() const {
+        uint32_t w = 0, h = 0;
+        return layer_to_rgba(0, w, h);
+    }
 
-        std::vector<uint8_t> rgba_data;
-        rgba_data.resize(dimension * dimension * 4);
-        unwrap_blp_layer(rgba_data, dimension, dimension, layer);
-        return rgba_data;
+    std::vector<uint8_t> blp_file::convert_to_rgba(const uint32_t dimension, uint32_t &w, uint32_t &h) const {
+        return layer_to_rgba(layer_for_dimension(dimension), w, h);
     }
 
     void write_to_vector(void *context, void *data, const int size) {
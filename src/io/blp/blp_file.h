@@ -4,9 +4,11 @@
 #include "io/mpq_file.h"
 #include "utils/io.h"
 #include <vector>
-#include <functional>
 #include <memory>
 #include <array>
+#include <functional>
+#include <mutex>
+#include <span>
 
 namespace wow::io::blp {
     enum class blp_format {
@@ -31,71 +33,43 @@ namespace wow::io::blp {
         uint32_t mipmap_sizes[16];
     };
 
-    class blp_file {
-        struct rgb_data_array {
-            rgb_data_array() {
-                data.color = 0;
-            }
-
-            union data {
-                uint32_t color;
-                uint8_t buffer[4];
-            } data{};
-        };
+    using blp_layer_source = std::function<mpq_file_ptr(size_t offset, size_t size)>;
 
+    class blp_file {
         blp_header _header{};
         std::vector<uint32_t> _palette;
-        std::vector<std::vector<uint8_t> > _mipmaps;
+        mpq_file_ptr _file{};
+        blp_layer_source _source{};
+        uint32_t _mipmap_count = 0;
         blp_format _format = blp_format::unknown;
 
-        void load_format();
-
-        typedef std::function<void(utils::binary_reader &, std::vector<uint32_t> &, size_t)> block_converter_function_t;
-
-        [[nodiscard]] block_converter_function_t block_converter_function() const {
-            switch (_format) {
-                case blp_format::bc1:
-                    return &blp_file::process_block_bc1;
-                case blp_format::bc2:
-                    return &blp_file::process_block_bc2;
-                case blp_format::bc3:
-                    return &blp_file::process_block_bc3;
-                default:
-                    return {};
-            }
-        }
-
-        static void read_bc_colors(utils::binary_reader &reader, std::array<rgb_data_array, 4> &colors,
-                                   bool pre_multiplied_alpha,
-                                   bool use_4_colors);
-
-        static void process_block_bc1(utils::binary_reader &reader, std::vector<uint32_t> &block_data,
-                                      size_t block_offset);
+        mutable std::mutex _layer_lock{};
+        mutable std::vector<mpq_file_ptr> _layers{};
 
-        static void process_block_bc2(utils::binary_reader &reader, std::vector<uint32_t> &block_data,
-                                      size_t block_offset);
+        void load_format();
 
-        static void process_block_bc3(utils::binary_reader &reader, std::vector<uint32_t> &block_data,
-                                      size_t block_offset);
+        void load_header(const mpq_file_ptr &file);
 
         void process_palette_fast_path(std::vector<uint8_t> &rgba_data, uint32_t w, uint32_t h,
-                                       const std::vector<uint8_t> &layer_data) const;
+                                       std::span<const uint8_t> layer_data) const;
 
         void process_palette_full_path(std::vector<uint8_t> &rgba_data, uint32_t w, uint32_t h,
-                                       const std::vector<uint8_t> &layer_data) const;
+                                       std::span<const uint8_t> layer_data) const;
 
         void unwrap_compressed_blp_layer(uint32_t w, uint32_t h, std::vector<uint8_t> &rgba_data,
-                                         const std::vector<uint8_t> &layer_data) const;
+                                         std::span<const uint8_t> layer_data) const;
 
         void unwrap_blp_layer_with_palette(std::vector<uint8_t> &rgba_data,
                                            uint32_t w, uint32_t h,
-                                           const std::vector<uint8_t> &layer_data) const;
+                                           std::span<const uint8_t> layer_data) const;
 
         void unwrap_blp_layer(std::vector<uint8_t> &rgba_data, uint32_t w, uint32_t h, uint32_t layer) const;
 
     public:
         explicit blp_file(const mpq_file_ptr &file);
 
+        explicit blp_file(blp_layer_source source);
+
         [[nodiscard]] uint32_t width() const {
             return _header.width;
         }
@@ -108,16 +82,20 @@ namespace wow::io::blp {
             return _format;
         }
 
-        std::vector<uint8_t> get_layer(const uint32_t layer) const {
-            return _mipmaps[layer];
-        }
+        [[nodiscard]] std::span<const uint8_t> get_layer(uint32_t layer) const;
+
+        void release_layer(uint32_t layer) const;
 
         size_t layer_count() const {
-            return _mipmaps.size();
+            return _mipmap_count;
         }
 
+        [[nodiscard]] uint32_t layer_for_dimension(uint32_t dimension) const;
+
         std::vector<uint8_t> palette_layer_to_rgba(uint32_t layer) const;
 
+        [[nodiscard]] std::vector<uint8_t> layer_to_rgba(uint32_t layer, uint32_t &w, uint32_t &h) const;
+
         [[nodiscard]] std::vector<uint8_t> convert_to_rgba() const;
 
         [[nodiscard]] std::vector<uint8_t> convert_to_rgba(uint32_t dimension, uint32_t &w, uint32_t &h) const;
@@ -3,10 +3,14 @@
 
 #include <map>
 #include <cstdint>
+#include <ranges>
+#include <span>
+#include <string_view>
 #include <boost/di.hpp>
 
 #include "io/mpq_file.h"
 #include "spdlog/spdlog.h"
+#include "utils/io.h"
 #include "dbc_structs.h"
 
 #include <boost/pfr.hpp>
@@ -52,40 +56,51 @@ namespace wow::io::dbc {
 
         dbc_header _header{};
 
-        void load_header(const mpq_file_ptr &file) {
-            file->seek(0);
-            _header = file->read<dbc_header>();
+        void load_header(utils::binary_reader &file) {
+            file.seek(0);
+            _header = file.read<dbc_header>();
             if (_header.magic != 0x43424457) {
                 SPDLOG_ERROR("Invalid DBC file: 0x{:X} != 0x{:X} ", _header.magic, 0x43424443);
                 throw std::runtime_error("Invalid DBC file");
             }
 
-            file->seek(sizeof(dbc_header) + _header.record_count * _header.record_size);
-            std::vector<char> string_data(_header.string_block_size);
-            file->read(string_data);
+            const auto string_offset = sizeof(dbc_header) + static_cast<size_t>(_header.record_count) * _header.record_size;
+            const auto data = file.data();
+            if (string_offset > data.size() || _header.string_block_size > data.size() - string_offset) {
+                SPDLOG_ERROR("Invalid DBC file: string block exceeds file size");
+                throw std::runtime_error("Invalid DBC file");
+            }
+
+            const std::string_view string_data{
+                reinterpret_cast<const char *>(data.data() + string_offset), _header.string_block_size
+            };
 
-            int32_t offset = 0;
+            size_t offset = 0;
             while (offset < string_data.size()) {
-                std::string str{string_data.data() + offset};
-                _string_table[offset] = str;
-                offset += static_cast<int32_t>(str.size() + 1);
+                auto end = string_data.find('\0', offset);
+                if (end == std::string_view::npos) {
+                    end = string_data.size();
+                }
+
+                _string_table[static_cast<int32_t>(offset)] = std::string{string_data.substr(offset, end - offset)};
+                offset = end + 1;
             }
         }
 
-        void load_data(const mpq_file_ptr &file) {
+        void load_data(utils::binary_reader &file) {
             for (int32_t i = 0; i < _header.record_count; ++i) {
-                file->seek(sizeof(dbc_header) + i * _header.record_size);
+                file.seek(sizeof(dbc_header) + i * _header.record_size);
 
                 T record{};
                 boost::pfr::for_each_field(record, [&]<typename F>(F &field) {
                     typedef std::remove_cv_t<F> field_type;
 
                     if constexpr (std::is_same_v<field_type, std::string>) {
-                        field = _string_table[file->read<int32_t>()];
+                        field = _string_table[file.read<int32_t>()];
                     } else if constexpr (std::is_same_v<field_type, loc_string>) {
                         field = loc_string{};
                         int32_t values[17]{};
-                        file->read(values);
+                        file.read(values);
                         for (int idx = 0; idx < 16; ++idx) {
                             if (values[idx] != 0) {
                                 field.text = _string_table[values[idx]];
@@ -93,14 +108,14 @@ namespace wow::io::dbc {
                             }
                         }
                     } else if constexpr (std::is_same_v<field_type, bool>) {
-                        field = file->read<uint8_t>() != 0;
+                        field = file.read<uint8_t>() != 0;
                     } else if constexpr (is_std_array_v<field_type> && std::is_same_v<std_array_t<field_type>, std::string>) {
                         constexpr auto array_size = std_array_size_v<field_type>;
                         for (int idx = 0; idx < array_size; ++idx) {
-                            field[idx] = _string_table[file->read<int32_t>()];
+                            field[idx] = _string_table[file.read<int32_t>()];
                         }
                     } else {
-                        field = file->read<field_type>();
+                        field = file.read<field_type>();
                     }
                 });
 
@@ -111,12 +126,76 @@ namespace wow::io::dbc {
             _string_table.clear();
         }
 
+        static void write_record(utils::binary_writer &writer, const T &record) {
+            boost::pfr::for_each_field(record, [&]<typename F>(const F &field) {
+                typedef std::remove_cv_t<F> field_type;
+
+                if constexpr (std::is_same_v<field_type, std::string>) {
+                    writer.write_string(field);
+                } else if constexpr (std::is_same_v<field_type, loc_string>) {
+                    writer.write_string(field.text);
+                } else if constexpr (is_std_array_v<field_type> && std::is_same_v<std_array_t<field_type>, std::string>) {
+                    for (const auto &value: field) {
+                        writer.write_string(value);
+                    }
+                } else {
+                    writer.write(field);
+                }
+            });
+        }
+
+        static T read_record(utils::binary_reader &reader) {
+            T record{};
+            boost::pfr::for_each_field(record, [&]<typename F>(F &field) {
+                typedef std::remove_cv_t<F> field_type;
+
+                if constexpr (std::is_same_v<field_type, std::string>) {
+                    field = reader.read_string();
+                } else if constexpr (std::is_same_v<field_type, loc_string>) {
+                    field.text = reader.read_string();
+                } else if constexpr (is_std_array_v<field_type> && std::is_same_v<std_array_t<field_type>, std::string>) {
+                    for (auto &value: field) {
+                        value = reader.read_string();
+                    }
+                } else {
+                    field = reader.read<field_type>();
+                }
+            });
+
+            return record;
+        }
+
     public:
-        explicit dbc_file(const mpq_file_ptr &file) {
+        explicit dbc_file(const std::span<const uint8_t> data) {
+            utils::binary_reader file{data};
             load_header(file);
             load_data(file);
         }
 
+        explicit dbc_file(utils::binary_reader &cached) {
+            _header = cached.read<dbc_header>();
+            if (_header.magic != 0x43424457) {
+                throw std::runtime_error("Invalid cached DBC header");
+            }
+
+            const auto cached_records = cached.read<uint32_t>();
+            for (uint32_t i = 0; i < cached_records; ++i) {
+                auto record = read_record(cached);
+                _record_map[boost::pfr::get<0>(record)] = std::move(record);
+            }
+        }
+
+        [[nodiscard]] std::vector<uint8_t> serialize() const {
+            utils::binary_writer writer{};
+            writer.write(_header);
+            writer.write(static_cast<uint32_t>(_record_map.size()));
+            for (const auto &record: _record_map | std::views::values) {
+                write_record(writer, record);
+            }
+
+            return writer.data();
+        }
+
         uint32_t record_count() const {
             return _header.record_count;
         }
@@ -142,8 +221,8 @@ namespace wow::io::dbc {
     using dbc_file_ptr = std::shared_ptr<dbc_file<T> >;
 
     template<typename T>
-    dbc_file_ptr<T> make_dbc(mpq_file_ptr file) {
-        return std::make_shared<dbc_file<T> >(file);
+    dbc_file_ptr<T> make_dbc(const mpq_file_ptr &file) {
+        return std::make_shared<dbc_file<T> >(file->full_data());
     }
 }
 
@@ -4,26 +4,26 @@ namespace wow::io::dbc {
     void dbc_manager::initialize(const mpq_manager_ptr &mpq_manager,
                                  const std::function<void(int, const std::string &)> &callback) {
         callback(95, "Loading Map.dbc");
-        _map_dbc = make_dbc<map_record>(mpq_manager->open("DBFilesClient\\Map.dbc"));
+        _map_dbc = load_dbc<map_record>(mpq_manager, "DBFilesClient\\Map.dbc");
         callback(95, "Loading LoadingScreens.dbc");
-        _loading_screen_dbc = make_dbc<loading_screen_record>(mpq_manager->open("DBFilesClient\\LoadingScreens.dbc"));
+        _loading_screen_dbc = load_dbc<loading_screen_record>(mpq_manager, "DBFilesClient\\LoadingScreens.dbc");
         callback(95, "Loading AreaPoi.dbc");
-        _area_poi_dbc = make_dbc<area_poi_record>(mpq_manager->open("DBFilesClient\\AreaPoi.dbc"));
+        _area_poi_dbc = load_dbc<area_poi_record>(mpq_manager, "DBFilesClient\\AreaPoi.dbc");
         callback(95, "Loading AreaTable.dbc");
-        _area_table_dbc = make_dbc<area_table_record>(mpq_manager->open("DBFilesClient\\AreaTable.dbc"));
+        _area_table_dbc = load_dbc<area_table_record>(mpq_manager, "DBFilesClient\\AreaTable.dbc");
         callback(95, "Loading Light.dbc");
-        _light_dbc = make_dbc<light_record>(mpq_manager->open("DBFilesClient\\Light.dbc"));
+        _light_dbc = load_dbc<light_record>(mpq_manager, "DBFilesClient\\Light.dbc");
         callback(95, "Loading LightParams.dbc");
-        _light_params_dbc = make_dbc<light_params_record>(mpq_manager->open("DBFilesClient\\LightParams.dbc"));
+        _light_params_dbc = load_dbc<light_params_record>(mpq_manager, "DBFilesClient\\LightParams.dbc");
         callback(95, "Loading LightSkybox.dbc");
-        _light_skybox_dbc = make_dbc<light_skybox_record>(mpq_manager->open("DBFilesClient\\LightSkybox.dbc"));
+        _light_skybox_dbc = load_dbc<light_skybox_record>(mpq_manager, "DBFilesClient\\LightSkybox.dbc");
         callback(95, "Loading LightIntBand.dbc");
-        _light_int_band_dbc = make_dbc<light_int_band_record>(mpq_manager->open("DBFilesClient\\LightIntBand.dbc"));
+        _light_int_band_dbc = load_dbc<light_int_band_record>(mpq_manager, "DBFilesClient\\LightIntBand.dbc");
         callback(95, "Loading LightFloatBand.dbc");
-        _light_float_band_dbc = make_dbc<light_float_band_record>(mpq_manager->open("DBFilesClient\\LightFloatBand.dbc"));
+        _light_float_band_dbc = load_dbc<light_float_band_record>(mpq_manager, "DBFilesClient\\LightFloatBand.dbc");
         callback(95, "Loading SoundEntries.dbc");
-        _sound_entries_dbc = make_dbc<sound_entries_record>(mpq_manager->open("DBFilesClient\\SoundEntries.dbc"));
+        _sound_entries_dbc = load_dbc<sound_entries_record>(mpq_manager, "DBFilesClient\\SoundEntries.dbc");
         callback(95, "Loading ZoneMusic.dbc");
-        _zone_music_dbc = make_dbc<zone_music_record>(mpq_manager->open("DBFilesClient\\ZoneMusic.dbc"));
+        _zone_music_dbc = load_dbc<zone_music_record>(mpq_manager, "DBFilesClient\\ZoneMusic.dbc");
     }
 }
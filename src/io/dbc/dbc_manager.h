@@ -3,10 +3,13 @@
 
 #include "dbc_structs.h"
 #include "dbc_file.h"
+#include "io/asset_cache.h"
 #include "io/mpq_manager.h"
 
 namespace wow::io::dbc {
     class dbc_manager {
+        asset_cache_ptr _asset_cache{};
+
         dbc_file_ptr<map_record> _map_dbc{};
         dbc_file_ptr<loading_screen_record> _loading_screen_dbc{};
         dbc_file_ptr<area_poi_record> _area_poi_dbc{};
@@ -19,7 +22,32 @@ namespace wow::io::dbc {
         dbc_file_ptr<sound_entries_record> _sound_entries_dbc{};
         dbc_file_ptr<zone_music_record> _zone_music_dbc{};
 
+        template<typename T>
+        dbc_file_ptr<T> load_dbc(const mpq_manager_ptr &mpq_manager, const std::string &path) {
+            auto key = mpq_manager->content_key(path);
+            if (key) {
+                key = fmt::format("{}|size={}|schema={}", *key, sizeof(T), T::schema_version);
+                if (const auto cached = _asset_cache->load("dbc", *key)) {
+                    try {
+                        return std::make_shared<dbc_file<T> >(*cached);
+                    } catch (const std::exception &e) {
+                        SPDLOG_WARN("Ignoring invalid cached DBC {}: {}", path, e.what());
+                    }
+                }
+            }
+
+            const auto file = make_dbc<T>(mpq_manager->open(path));
+            if (key && _asset_cache->is_enabled()) {
+                _asset_cache->store("dbc", *key, file->serialize());
+            }
+
+            return file;
+        }
+
     public:
+        explicit dbc_manager(asset_cache_ptr asset_cache) : _asset_cache(std::move(asset_cache)) {
+        }
+
         void initialize(const mpq_manager_ptr &mpq_manager,
                         const std::function<void(int, const std::string &)> &callback);
 
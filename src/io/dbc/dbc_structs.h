@@ -21,6 +21,8 @@ namespace wow::io::dbc {
     };
 
     struct map_record {
+        static constexpr uint32_t schema_version = 1;
+
         int32_t id;
         std::string directory;
         map_instance instance_type;
@@ -42,6 +44,8 @@ namespace wow::io::dbc {
     };
 
     struct loading_screen_record {
+        static constexpr uint32_t schema_version = 1;
+
         int32_t id;
         std::string name;
         std::string path;
@@ -49,6 +53,8 @@ namespace wow::io::dbc {
     };
 
     struct area_poi_record {
+        static constexpr uint32_t schema_version = 1;
+
         int32_t id;
         int32_t importance;
         int32_t normal_icon;
@@ -72,6 +78,8 @@ namespace wow::io::dbc {
     };
 
     struct area_table_record {
+        static constexpr uint32_t schema_version = 1;
+
         int32_t id;
         int32_t map_id;
         int32_t parent_id;
@@ -92,6 +100,8 @@ namespace wow::io::dbc {
     };
 
     struct light_record {
+        static constexpr uint32_t schema_version = 1;
+
         int32_t id;
         int32_t map_id;
         float x;
@@ -110,6 +120,8 @@ namespace wow::io::dbc {
     };
 
     struct light_params_record {
+        static constexpr uint32_t schema_version = 1;
+
         int32_t id;
         int32_t highlight_sky;
         int32_t light_skybox_id;
@@ -122,12 +134,16 @@ namespace wow::io::dbc {
     };
 
     struct light_skybox_record {
+        static constexpr uint32_t schema_version = 1;
+
         int32_t id;
         std::string name;
         int32_t flags;
     };
 
     struct light_int_band_record {
+        static constexpr uint32_t schema_version = 1;
+
         int32_t id;
         int32_t num_entries;
         std::array<int32_t, 16> times;
@@ -135,6 +151,8 @@ namespace wow::io::dbc {
     };
 
     struct light_float_band_record {
+        static constexpr uint32_t schema_version = 1;
+
         int32_t id;
         int32_t num_entries;
         std::array<int32_t, 16> times;
@@ -142,6 +160,8 @@ namespace wow::io::dbc {
     };
 
     struct sound_entries_record {
+        static constexpr uint32_t schema_version = 1;
+
         int32_t id;
         int32_t sound_type;
         std::string name;
@@ -157,6 +177,8 @@ namespace wow::io::dbc {
     };
 
     struct zone_music_record {
+        static constexpr uint32_t schema_version = 1;
+
         int32_t id;
         std::string name;
         int32_t silence_min_day;
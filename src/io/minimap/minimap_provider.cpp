@@ -37,16 +37,17 @@ namespace wow::io::minimap {
                 << std::setw(2) << std::setfill('0') << y << ".blp";
 
         if (const auto key = utils::to_lower(path_stream.str()); _md5_translate.contains(key)) {
-            const auto file = _mpq_manager->open(fmt::format("textures\\minimap\\{}", _md5_translate.at(key)));
-            return std::make_shared<blp::blp_file>(file);
+            return _mpq_manager->open_blp(fmt::format("textures\\minimap\\{}", _md5_translate.at(key)));
         }
 
         return {};
     }
 
     minimap_provider::minimap_provider(dbc::dbc_manager_ptr dbc_manager,
-                                       mpq_manager_ptr mpq_manager) : _dbc_manager(std::move(dbc_manager)),
-                                                                      _mpq_manager(std::move(mpq_manager)) {
+                                       mpq_manager_ptr mpq_manager,
+                                       asset_cache_ptr asset_cache) : _dbc_manager(std::move(dbc_manager)),
+                                                                      _mpq_manager(std::move(mpq_manager)),
+                                                                      _asset_cache(std::move(asset_cache)) {
     }
 
     void minimap_provider::switch_to_map(uint32_t map_id) {
@@ -59,6 +60,7 @@ namespace wow::io::minimap {
             _cache.clear();
 
             if (_md5_translate.empty()) {
+                _md5_translate_key = _mpq_manager->content_key("textures\\minimap\\md5translate.trs").value_or("");
                 auto fl = _mpq_manager->open("textures\\minimap\\md5translate.trs");
                 auto content = fl->read_text();
 
@@ -112,6 +114,16 @@ namespace wow::io::minimap {
             return;
         }
 
+        const auto persistent_key = fmt::format("{}|{}|{}|{}|{}", _md5_translate_key, _base_path, zoom_level, tx, ty);
+        if (!_md5_translate_key.empty()) {
+            if (const auto cached = _asset_cache->load("minimap", persistent_key)) {
+                const auto png = cached->data();
+                image_data.assign(png.begin(), png.end());
+                add_to_cache(cache_key, image_data);
+                return;
+            }
+        }
+
         std::vector<std::shared_future<void> > futures{};
         for (auto y = 0; y < num_tiles; ++y) {
             for (auto x = 0; x < num_tiles; ++x) {
@@ -151,5 +163,36 @@ namespace wow::io::minimap {
         std::ranges::for_each(futures, [](auto &f) { f.get(); });
         image_data = utils::to_png(tile_data, 256, 256);
         add_to_cache(cache_key, image_data);
+        if (!_md5_translate_key.empty()) {
+            _asset_cache->store("minimap", persistent_key, image_data);
+        }
+    }
+
+    std::vector<uint8_t> minimap_provider::tile_image(const uint32_t x, const uint32_t y,
+                                                      const uint32_t dimension) const {
+        const auto tile = open_tile(x, y);
+        if (!tile) {
+            return {};
+        }
+
+        uint32_t tw = 0, th = 0;
+        const auto tile_image = tile->convert_to_rgba(dimension, tw, th);
+        if (tw < dimension || th < dimension) {
+            return {};
+        }
+
+        const auto src = reinterpret_cast<const uint32_t *>(tile_image.data());
+        std::vector<uint8_t> image(dimension * dimension * 4);
+        const auto dst = reinterpret_cast<uint32_t *>(image.data());
+
+        const auto pixel_advance = tw / dimension;
+        const auto row_advance = th / dimension;
+        for (auto iy = 0u; iy < dimension; ++iy) {
+            for (auto ix = 0u; ix < dimension; ++ix) {
+                dst[iy * dimension + ix] = src[iy * row_advance * tw + ix * pixel_advance];
+            }
+        }
+
+        return image;
     }
 }
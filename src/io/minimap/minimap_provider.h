@@ -5,6 +5,7 @@
 #include <unordered_map>
 #include <mutex>
 
+#include "io/asset_cache.h"
 #include "io/blp/blp_file.h"
 #include "io/dbc/dbc_manager.h"
 #include "utils/work_pool.h"
@@ -13,9 +14,11 @@ namespace wow::io::minimap {
     class minimap_provider {
         dbc::dbc_manager_ptr _dbc_manager{};
         mpq_manager_ptr _mpq_manager{};
+        asset_cache_ptr _asset_cache{};
         utils::work_pool _loader_pool{};
 
         std::map<std::string, std::string> _md5_translate{};
+        std::string _md5_translate_key{};
 
         uint32_t _current_map_id = 0xFFFFFFFF;
         std::string _base_path{};
@@ -32,12 +35,15 @@ namespace wow::io::minimap {
     public:
         minimap_provider(
             dbc::dbc_manager_ptr dbc_manager,
-            mpq_manager_ptr mpq_manager
+            mpq_manager_ptr mpq_manager,
+            asset_cache_ptr asset_cache
         );
 
         void switch_to_map(uint32_t map_id);
 
         void read_image(std::vector<uint8_t> &image_data, uint32_t map_id, uint32_t zoom_level, int32_t tx, int32_t ty);
+
+        [[nodiscard]] std::vector<uint8_t> tile_image(uint32_t x, uint32_t y, uint32_t dimension) const;
     };
 
     using minimap_provider_ptr = std::shared_ptr<minimap_provider>;
@@ -0,0 +1,55 @@
+#include "mpq_directory.h"
+
+#include <algorithm>
+
+#include "StormLib.h"
+
+namespace wow::io {
+    std::string mpq_directory::normalize(const std::string &path) {
+        std::string result{path};
+        std::ranges::transform(result, result.begin(), [](const char ch) {
+            return ch == '/' ? '\\' : static_cast<char>(tolower(static_cast<unsigned char>(ch)));
+        });
+        return result;
+    }
+
+    mpq_directory::archive_listing mpq_directory::list_archive(const HANDLE handle) {
+        archive_listing listing{};
+        if (!SFileHasFile(handle, LISTFILE_NAME)) {
+            return listing;
+        }
+
+        SFILE_FIND_DATA find_data{};
+        const auto find_handle = SFileFindFirstFile(handle, "*", &find_data, nullptr);
+        if (!find_handle) {
+            return listing;
+        }
+
+        do {
+            listing.files.emplace(normalize(find_data.cFileName));
+        } while (SFileFindNextFile(find_handle, &find_data));
+
+        SFileFindClose(find_handle);
+        listing.has_listfile = true;
+        return listing;
+    }
+
+    void mpq_directory::add_listing(const uint32_t archive_index, const archive_listing &listing) {
+        if (!listing.has_listfile) {
+            _unlisted_archives.push_back(archive_index);
+            return;
+        }
+
+        for (const auto &file: listing.files) {
+            _entries.try_emplace(file, archive_index);
+        }
+    }
+
+    std::optional<uint32_t> mpq_directory::find(const std::string &path) const {
+        if (const auto itr = _entries.find(normalize(path)); itr != _entries.end()) {
+            return itr->second;
+        }
+
+        return std::nullopt;
+    }
+}
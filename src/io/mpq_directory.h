@@ -0,0 +1,47 @@
+#ifndef WOW_UNIX_MPQ_DIRECTORY_H
+#define WOW_UNIX_MPQ_DIRECTORY_H
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "StormPort.h"
+
+namespace wow::io {
+    class mpq_directory {
+    public:
+        struct archive_listing {
+            std::unordered_set<std::string> files{};
+            bool has_listfile = false;
+        };
+
+    private:
+        std::unordered_map<std::string, uint32_t> _entries{};
+        std::vector<uint32_t> _unlisted_archives{};
+
+    public:
+        static std::string normalize(const std::string &path);
+
+        static archive_listing list_archive(HANDLE handle);
+
+        void add_listing(uint32_t archive_index, const archive_listing &listing);
+
+        [[nodiscard]] std::optional<uint32_t> find(const std::string &path) const;
+
+        [[nodiscard]] const std::vector<uint32_t> &unlisted_archives() const {
+            return _unlisted_archives;
+        }
+
+        [[nodiscard]] size_t size() const {
+            return _entries.size();
+        }
+    };
+
+    using mpq_directory_ptr = std::shared_ptr<const mpq_directory>;
+}
+
+#endif //WOW_UNIX_MPQ_DIRECTORY_H
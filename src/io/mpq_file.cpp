@@ -1,40 +1,94 @@
 #include "mpq_file.h"
 
+#include <algorithm>
 #include <stdexcept>
 
 #include "spdlog/fmt/fmt.h"
 
 namespace wow::io {
-    mpq_file::mpq_file(const HANDLE file) : _file(file) {
+    bool mpq_file::map_stored_entry(const HANDLE file, const utils::mapped_file_ptr &archive_mapping,
+                                    const uint64_t header_offset, const size_t offset, const size_t size) {
+        if (!archive_mapping) {
+            return false;
+        }
+
+        DWORD flags = 0;
+        if (!SFileGetFileInfo(file, SFileInfoFlags, &flags, sizeof(flags), nullptr)) {
+            return false;
+        }
+
+        if ((flags & (MPQ_FILE_COMPRESS_MASK | MPQ_FILE_ENCRYPTED | MPQ_FILE_PATCH_FILE | MPQ_FILE_DELETE_MARKER)) !=
+            0) {
+            return false;
+        }
+
+        ULONGLONG byte_offset = 0;
+        DWORD file_size = 0, compressed_size = 0;
+        if (!SFileGetFileInfo(file, SFileInfoByteOffset, &byte_offset, sizeof(byte_offset), nullptr) ||
+            !SFileGetFileInfo(file, SFileInfoFileSize, &file_size, sizeof(file_size), nullptr) ||
+            !SFileGetFileInfo(file, SFileInfoCompressedSize, &compressed_size, sizeof(compressed_size), nullptr)) {
+            return false;
+        }
+
+        if (file_size != compressed_size) {
+            return false;
+        }
+
+        const auto begin = std::min<size_t>(offset, file_size);
+        const auto length = std::min<size_t>(size, file_size - begin);
+        const auto view = archive_mapping->view(header_offset + byte_offset + begin, length);
+        if (view.size() != length) {
+            return false;
+        }
+
+        _data = view;
+        _owner = archive_mapping;
+        _file_size = file_size;
+        return true;
+    }
+
+    void mpq_file::read_entry(const HANDLE file, const size_t offset, const size_t size) {
         DWORD size_high = 0;
-        uint64_t size = SFileGetFileSize(_file, &size_high);
-        size |= static_cast<uint64_t>(size_high) << 32;
-        _buffer.resize(size);
+        uint64_t file_size = SFileGetFileSize(file, &size_high);
+        file_size |= static_cast<uint64_t>(size_high) << 32;
 
-        SFileSetFilePointer(_file, 0, nullptr, FILE_BEGIN);
-        SFileReadFile(_file, _buffer.data(), size, nullptr, nullptr);
-        SFileCloseFile(_file);
+        const auto begin = std::min<uint64_t>(offset, file_size);
+        const auto length = std::min<uint64_t>(size, file_size - begin);
+
+        const auto buffer = std::make_shared<std::vector<uint8_t> >(length);
+        LONG position_high = static_cast<LONG>(begin >> 32);
+        SFileSetFilePointer(file, static_cast<LONG>(begin & 0xFFFFFFFF), &position_high, FILE_BEGIN);
+        SFileReadFile(file, buffer->data(), length, nullptr, nullptr);
+
+        _data = *buffer;
+        _owner = buffer;
+        _file_size = file_size;
     }
 
-    std::vector<uint8_t> mpq_file::full_data() {
-        return _buffer;
+    mpq_file::mpq_file(const HANDLE file, const utils::mapped_file_ptr &archive_mapping, const uint64_t header_offset,
+                       const size_t offset, const size_t size) {
+        if (!map_stored_entry(file, archive_mapping, header_offset, offset, size)) {
+            read_entry(file, offset, size);
+        }
+
+        SFileCloseFile(file);
     }
 
     void mpq_file::read(size_t size, void *buffer) {
-        if (_offset + size > _buffer.size()) {
+        if (_offset + size > _data.size()) {
             throw std::runtime_error(fmt::format("mpq file read out of bounds: {} + {} > {}", _offset, size,
-                                                 _buffer.size()));
+                                                 _data.size()));
         }
 
-        memcpy(buffer, _buffer.data() + _offset, size);
+        memcpy(buffer, _data.data() + _offset, size);
         _offset += size;
     }
 
     std::string mpq_file::read_text() {
-        return std::string{reinterpret_cast<char *>(_buffer.data()), _buffer.size()};
+        return std::string{reinterpret_cast<const char *>(_data.data()), _data.size()};
     }
 
     utils::binary_reader_ptr mpq_file::to_binary_reader() {
-        return std::make_shared<utils::binary_reader>(_buffer);
+        return std::make_shared<utils::binary_reader>(_data, _owner);
     }
 }
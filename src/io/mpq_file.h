@@ -1,25 +1,43 @@
 #ifndef WOW_UNIX_MPQ_FILE_H
 #define WOW_UNIX_MPQ_FILE_H
 
+#include <limits>
 #include <memory>
+#include <span>
 #include <StormLib.h>
 #include <vector>
 
 #include "utils/io.h"
+#include "utils/mapped_file.h"
 
 namespace wow::io {
+    inline constexpr size_t MPQ_FILE_TO_END = std::numeric_limits<size_t>::max();
+
     class mpq_file {
-        HANDLE _file{};
-        std::vector<uint8_t> _buffer{};
+        std::shared_ptr<const void> _owner{};
+        std::span<const uint8_t> _data{};
         size_t _offset{};
+        size_t _file_size{};
+
+        bool map_stored_entry(HANDLE file, const utils::mapped_file_ptr &archive_mapping, uint64_t header_offset,
+                              size_t offset, size_t size);
+
+        void read_entry(HANDLE file, size_t offset, size_t size);
 
     public:
-        explicit mpq_file(HANDLE file);
+        explicit mpq_file(HANDLE file, const utils::mapped_file_ptr &archive_mapping = {}, uint64_t header_offset = 0,
+                          size_t offset = 0, size_t size = MPQ_FILE_TO_END);
 
-        std::vector<uint8_t> full_data();
+        [[nodiscard]] std::span<const uint8_t> full_data() const {
+            return _data;
+        }
 
         [[nodiscard]] size_t size() const {
-            return _buffer.size();
+            return _data.size();
+        }
+
+        [[nodiscard]] size_t file_size() const {
+            return _file_size;
         }
 
         [[nodiscard]] size_t position() const {
@@ -0,0 +1,61 @@
+#include "mpq_handle_pool.h"
+
+#include <algorithm>
+
+#include "StormLib.h"
+#include "spdlog/spdlog.h"
+
+namespace wow::io {
+    mpq_handle_pool::mpq_handle_pool(std::string path, const HANDLE primary, const size_t max_handles)
+        : _path(std::move(path)), _max_handles(std::max<size_t>(max_handles, 1)) {
+        _all_handles.push_back(primary);
+        _idle_handles.push_back(primary);
+    }
+
+    mpq_handle_pool::~mpq_handle_pool() {
+        for (const auto handle: _all_handles) {
+            SFileCloseArchive(handle);
+        }
+    }
+
+    mpq_handle_pool::lease mpq_handle_pool::acquire() {
+        std::unique_lock lock(_lock);
+        while (true) {
+            if (!_idle_handles.empty()) {
+                const auto handle = _idle_handles.back();
+                _idle_handles.pop_back();
+                return lease{this, handle};
+            }
+
+            if (_all_handles.size() + _pending_opens < _max_handles) {
+                ++_pending_opens;
+                lock.unlock();
+
+                HANDLE handle{};
+                const auto opened = SFileOpenArchive(_path.c_str(), 0, MPQ_OPEN_READ_ONLY, &handle);
+
+                lock.lock();
+                --_pending_opens;
+                if (opened) {
+                    _all_handles.push_back(handle);
+                    return lease{this, handle};
+                }
+
+                SPDLOG_WARN("Cannot open additional handle for MPQ {}, limiting pool to {} handles", _path,
+                            _all_handles.size());
+                _max_handles = _all_handles.size();
+            }
+
+            _handle_event.wait(lock);
+        }
+    }
+
+    void mpq_handle_pool::release(const HANDLE handle) {
+        {
+            std::lock_guard lock(_lock);
+            _idle_handles.push_back(handle);
+        }
+
+        _handle_event.notify_one();
+    }
+}
@@ -0,0 +1,77 @@
+#ifndef WOW_UNIX_MPQ_HANDLE_POOL_H
+#define WOW_UNIX_MPQ_HANDLE_POOL_H
+
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "StormPort.h"
+
+namespace wow::io {
+    class mpq_handle_pool {
+    public:
+        class lease {
+            mpq_handle_pool *_pool{};
+            HANDLE _handle{};
+
+        public:
+            lease(mpq_handle_pool *pool, HANDLE handle) : _pool(pool), _handle(handle) {
+            }
+
+            lease(lease &&other) noexcept : _pool(other._pool), _handle(other._handle) {
+                other._pool = nullptr;
+                other._handle = nullptr;
+            }
+
+            lease(const lease &) = delete;
+
+            lease &operator=(const lease &) = delete;
+
+            lease &operator=(lease &&) = delete;
+
+            ~lease() {
+                if (_pool && _handle) {
+                    _pool->release(_handle);
+                }
+            }
+
+            [[nodiscard]] HANDLE get() const {
+                return _handle;
+            }
+        };
+
+    private:
+        std::string _path;
+        size_t _max_handles;
+
+        std::vector<HANDLE> _all_handles{};
+        std::vector<HANDLE> _idle_handles{};
+        size_t _pending_opens = 0;
+
+        std::mutex _lock{};
+        std::condition_variable _handle_event{};
+
+        void release(HANDLE handle);
+
+    public:
+        mpq_handle_pool(std::string path, HANDLE primary, size_t max_handles);
+
+        ~mpq_handle_pool();
+
+        mpq_handle_pool(const mpq_handle_pool &) = delete;
+
+        mpq_handle_pool &operator=(const mpq_handle_pool &) = delete;
+
+        lease acquire();
+
+        [[nodiscard]] const std::string &path() const {
+            return _path;
+        }
+    };
+
+    using mpq_handle_pool_ptr = std::shared_ptr<mpq_handle_pool>;
+}
+
+#endif //WOW_UNIX_MPQ_HANDLE_POOL_H
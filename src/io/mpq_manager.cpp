@@ -3,11 +3,13 @@
 #include <filesystem>
 #include <fstream>
 #include <regex>
+#include <thread>
 
 #include "StormLib.h"
 #include "blp/blp_file.h"
 #include "spdlog/spdlog.h"
 #include "utils/string_utils.h"
+#include "utils/work_pool.h"
 
 #include "dbc/dbc_manager.h"
 
@@ -124,20 +126,36 @@ namespace wow::io {
                              const dbc::dbc_manager_ptr &dbc_manager) : _dbc_manager(dbc_manager) {
         event_manager->listen(web::event::js_event_type::load_data_event,
                               [this, event_manager](const web::event::js_event &event) {
-                                  load_from_folder(event.load_data_event_data.folder,
-                                                   [event_manager](const int progress, const std::string &msg) {
-                                                       auto ev = web::event::js_event{};
-                                                       ev.type = web::event::js_event_type::load_update_event;
-                                                       ev.load_update_event_data.message = msg;
-                                                       ev.load_update_event_data.percentage = progress;
-                                                       ev.load_update_event_data.completed = progress >= 100;
-
-                                                       event_manager->submit(ev);
-                                                   });
+                                  std::lock_guard lock{_load_thread_lock};
+                                  if (_load_thread.joinable()) {
+                                      _load_thread.join();
+                                  }
+
+                                  _load_thread = std::thread{
+                                      [this, event_manager, folder = event.load_data_event_data.folder] {
+                                          load_from_folder(folder,
+                                                           [event_manager](const int progress, const std::string &msg) {
+                                                               auto ev = web::event::js_event{};
+                                                               ev.type = web::event::js_event_type::load_update_event;
+                                                               ev.load_update_event_data.message = msg;
+                                                               ev.load_update_event_data.percentage = progress;
+                                                               ev.load_update_event_data.completed = progress >= 100;
+
+                                                               event_manager->submit(ev);
+                                                           });
+                                      }
+                                  };
                                   return event_manager->empty_response();
                               });
     }
 
+    mpq_manager::~mpq_manager() {
+        std::lock_guard lock{_load_thread_lock};
+        if (_load_thread.joinable()) {
+            _load_thread.join();
+        }
+    }
+
     void mpq_manager::load_from_folder(const std::string &folder,
                                        const std::function<void(int, const std::string &)> &callback) {
         callback(0, "Searching MPQ files...");
@@ -159,40 +177,256 @@ namespace wow::io {
         actual_base_mpq_files.insert(actual_base_mpq_files.end(), actual_locale_mpq_files.begin(),
                                      actual_locale_mpq_files.end());
 
-        auto total_mpq = actual_base_mpq_files.size();
+        const auto total_mpq = static_cast<uint32_t>(actual_base_mpq_files.size());
 
         callback(10, fmt::format("Loading {} MPQ files...", total_mpq));
 
-        auto processed = 0;
-        for (auto &mpq: actual_base_mpq_files) {
-            callback(10 + processed * 85 / total_mpq,
-                     fmt::format("Loading {}...", std::filesystem::relative(mpq, data_path).string()));
-            HANDLE handle{};
-            if (!SFileOpenArchive(mpq.c_str(), 0, MPQ_OPEN_READ_ONLY, &handle)) {
-                SPDLOG_WARN("Skipping MPQ file: {} due to loading error", mpq);
-            } else {
-                _archives.emplace(_archives.begin(), handle, mpq);
-                SPDLOG_DEBUG("Loaded MPQ file: {}", mpq);
+        _directory.store(nullptr, std::memory_order_release);
+
+        {
+            std::lock_guard lock(_mount_lock);
+            _archives.clear();
+            _archives.resize(total_mpq);
+            _listings.assign(total_mpq, {});
+            _mounted.assign(total_mpq, false);
+            _mounted_prefix = 0;
+            _is_mounting = true;
+            _total_mpq_count = total_mpq;
+            _loaded_mpq_count = 0;
+        }
+
+        std::mutex progress_lock{};
+        auto last_progress = 10;
+        const auto report = [&](const int progress, const std::string &message) {
+            std::lock_guard lock(progress_lock);
+            last_progress = std::max(last_progress, progress);
+            callback(last_progress, message);
+        };
+
+        {
+            utils::work_pool mount_pool{};
+            std::vector<std::shared_future<void> > futures{};
+            for (auto i = 0u; i < total_mpq; ++i) {
+                const auto &mpq = actual_base_mpq_files[i];
+                futures.push_back(mount_pool.submit([&, i, mpq] {
+                    mount_archive(total_mpq - 1 - i, mpq);
+
+                    uint32_t loaded = 0;
+                    {
+                        std::lock_guard lock(_mount_lock);
+                        loaded = _loaded_mpq_count;
+                    }
+
+                    report(static_cast<int>(10 + loaded * 85 / total_mpq),
+                           fmt::format("Loaded {}", std::filesystem::relative(mpq, data_path).string()));
+                }));
             }
 
-            ++processed;
+            _dbc_manager->initialize(shared_from_this(), [&](int, const std::string &message) {
+                report(0, message);
+            });
+
+            std::ranges::for_each(futures, [](const auto &f) { f.get(); });
         }
 
-        callback(95, "Loading DBC files...");
-        _dbc_manager->initialize(shared_from_this(), callback);
+        report(95, "Indexing MPQ files...");
+        build_directory();
+
+        {
+            std::lock_guard lock(_mount_lock);
+            _listings.clear();
+            _is_mounting = false;
+        }
+
+        _mount_cv.notify_all();
         callback(100, "Done!");
     }
 
-    mpq_file_ptr mpq_manager::open(const std::string &path) {
-        std::lock_guard lock(_archive_lock);
-        for (const auto &[handle, name]: _archives) {
-            HANDLE file_handle{};
-            if (SFileOpenFileEx(handle, path.c_str(), 0, &file_handle)) {
-                SPDLOG_INFO("Opening file: {} in MPQ: {}", path, name);
-                return std::make_shared<mpq_file>(file_handle);
+    void mpq_manager::mount_archive(const uint32_t index, const std::string &path) {
+        HANDLE handle{};
+        if (!SFileOpenArchive(path.c_str(), 0, MPQ_OPEN_READ_ONLY, &handle)) {
+            SPDLOG_WARN("Skipping MPQ file: {} due to loading error", path);
+        } else {
+            ULONGLONG header_offset = 0;
+            SFileGetFileInfo(handle, SFileMpqHeaderOffset, &header_offset, sizeof(header_offset), nullptr);
+
+            auto &archive = _archives[index];
+            archive.handles = std::make_shared<mpq_handle_pool>(path, handle, std::thread::hardware_concurrency());
+            archive.mapping = utils::make_mapped_file(path);
+            archive.header_offset = header_offset;
+            _listings[index] = std::make_shared<const mpq_directory::archive_listing>(
+                mpq_directory::list_archive(handle));
+            SPDLOG_DEBUG("Loaded MPQ file: {}", path);
+        }
+
+        {
+            std::lock_guard lock(_mount_lock);
+            _mounted[index] = true;
+            while (_mounted_prefix < _mounted.size() && _mounted[_mounted_prefix]) {
+                ++_mounted_prefix;
+            }
+
+            ++_loaded_mpq_count;
+        }
+
+        _mount_cv.notify_all();
+    }
+
+    bool mpq_manager::archive_contains(const mount_probe &probe, const std::string &normalized_path,
+                                       const std::string &path) {
+        if (!probe.handles || !probe.listing) {
+            return false;
+        }
+
+        if (probe.listing->has_listfile) {
+            return probe.listing->files.contains(normalized_path);
+        }
+
+        const auto handle = probe.handles->acquire();
+        return SFileHasFile(handle.get(), path.c_str());
+    }
+
+    void mpq_manager::build_directory() {
+        const auto directory = std::make_shared<mpq_directory>();
+        for (auto i = 0u; i < _archives.size(); ++i) {
+            if (_archives[i].handles) {
+                directory->add_listing(i, *_listings[i]);
             }
         }
 
-        return nullptr;
+        SPDLOG_INFO("Indexed {} files from {} MPQ archives ({} without listfile)", directory->size(),
+                    _archives.size(), directory->unlisted_archives().size());
+        _directory.store(directory, std::memory_order_release);
+    }
+
+    std::optional<uint32_t> mpq_manager::resolve_while_mounting(const std::string &path) {
+        const auto normalized_path = mpq_directory::normalize(path);
+        uint32_t checked = 0;
+
+        while (true) {
+            std::vector<mount_probe> probes{};
+            auto complete = false;
+            {
+                std::unique_lock lock(_mount_lock);
+                _mount_cv.wait(lock, [&] {
+                    return checked < _mounted_prefix || !_is_mounting || _mounted_prefix == _mounted.size();
+                });
+
+                if (const auto directory = _directory.load(std::memory_order_acquire)) {
+                    lock.unlock();
+                    return resolve_listed(*directory, path);
+                }
+
+                for (; checked < _mounted_prefix; ++checked) {
+                    probes.push_back({checked, _archives[checked].handles, _listings[checked]});
+                }
+
+                complete = !_is_mounting || _mounted_prefix == _mounted.size();
+            }
+
+            for (const auto &probe: probes) {
+                if (archive_contains(probe, normalized_path, path)) {
+                    return probe.index;
+                }
+            }
+
+            if (complete) {
+                return std::nullopt;
+            }
+        }
+    }
+
+    std::optional<uint32_t> mpq_manager::resolve(const std::string &path) {
+        const auto directory = _directory.load(std::memory_order_acquire);
+        if (!directory) {
+            return resolve_while_mounting(path);
+        }
+
+        return resolve_listed(*directory, path);
+    }
+
+    std::optional<uint32_t> mpq_manager::resolve_listed(const mpq_directory &directory, const std::string &path) {
+        const auto listed = directory.find(path);
+        for (const auto index: directory.unlisted_archives()) {
+            if (listed && index > *listed) {
+                break;
+            }
+
+            const auto handle = _archives[index].handles->acquire();
+            if (SFileHasFile(handle.get(), path.c_str())) {
+                return index;
+            }
+        }
+
+        return listed;
+    }
+
+    mpq_file_ptr mpq_manager::open(const std::string &path) {
+        return open(path, 0, MPQ_FILE_TO_END);
+    }
+
+    mpq_file_ptr mpq_manager::open(const std::string &path, const size_t offset, const size_t size) {
+        const auto index = resolve(path);
+        if (!index) {
+            return nullptr;
+        }
+
+        const auto &[handles, mapping, header_offset] = _archives[*index];
+        const auto handle = handles->acquire();
+        HANDLE file_handle{};
+        if (!SFileOpenFileEx(handle.get(), path.c_str(), 0, &file_handle)) {
+            SPDLOG_WARN("File {} is indexed in MPQ {} but could not be opened", path, handles->path());
+            return nullptr;
+        }
+
+        if (offset == 0 && size == MPQ_FILE_TO_END) {
+            SPDLOG_INFO("Opening file: {} in MPQ: {}", path, handles->path());
+        } else {
+            SPDLOG_DEBUG("Opening {} bytes at {} of file: {} in MPQ: {}", size, offset, path, handles->path());
+        }
+
+        return std::make_shared<mpq_file>(file_handle, mapping, header_offset, offset, size);
+    }
+
+    blp::blp_file_ptr mpq_manager::open_blp(const std::string &path) {
+        if (!resolve(path)) {
+            return nullptr;
+        }
+
+        return std::make_shared<blp::blp_file>(
+            [self = weak_from_this(), path](const size_t offset, const size_t size) -> mpq_file_ptr {
+                const auto manager = self.lock();
+                return manager ? manager->open(path, offset, size) : nullptr;
+            });
+    }
+
+    bool mpq_manager::exists(const std::string &path) {
+        return resolve(path).has_value();
+    }
+
+    std::optional<std::string> mpq_manager::content_key(const std::string &path) {
+        const auto index = resolve(path);
+        if (!index) {
+            return std::nullopt;
+        }
+
+        const auto &handles = _archives[*index].handles;
+        const auto handle = handles->acquire();
+        HANDLE file_handle{};
+        if (!SFileOpenFileEx(handle.get(), path.c_str(), 0, &file_handle)) {
+            return std::nullopt;
+        }
+
+        DWORD crc = 0, file_size = 0, compressed_size = 0;
+        ULONGLONG byte_offset = 0, file_time = 0;
+        SFileGetFileInfo(file_handle, SFileInfoCRC32, &crc, sizeof(crc), nullptr);
+        SFileGetFileInfo(file_handle, SFileInfoByteOffset, &byte_offset, sizeof(byte_offset), nullptr);
+        SFileGetFileInfo(file_handle, SFileInfoFileSize, &file_size, sizeof(file_size), nullptr);
+        SFileGetFileInfo(file_handle, SFileInfoCompressedSize, &compressed_size, sizeof(compressed_size), nullptr);
+        SFileGetFileInfo(file_handle, SFileInfoFileTime, &file_time, sizeof(file_time), nullptr);
+        SFileCloseFile(file_handle);
+
+        return fmt::format("{}|{}|{:08x}|{}|{}|{}|{}", handles->path(), mpq_directory::normalize(path), crc,
+                           byte_offset, file_size, compressed_size, file_time);
     }
 }
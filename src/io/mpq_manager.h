@@ -1,15 +1,22 @@
 #ifndef WOW_UNIX_MPQ_MANAGER_H
 #define WOW_UNIX_MPQ_MANAGER_H
 
+#include <atomic>
+#include <condition_variable>
 #include <filesystem>
 #include <functional>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <regex>
+#include <thread>
 
 #include "StormPort.h"
 #include "web/event/event_manager.h"
 
+#include "io/mpq_directory.h"
 #include "io/mpq_file.h"
+#include "io/mpq_handle_pool.h"
 
 namespace wow::io {
     namespace dbc {
@@ -17,10 +24,24 @@ namespace wow::io {
         using dbc_manager_ptr = std::shared_ptr<dbc_manager>;
     }
 
+    namespace blp {
+        class blp_file;
+        using blp_file_ptr = std::shared_ptr<blp_file>;
+    }
+
     class mpq_manager : public std::enable_shared_from_this<mpq_manager> {
         struct loaded_archive {
-            HANDLE handle{};
-            std::string name{};
+            mpq_handle_pool_ptr handles{};
+            utils::mapped_file_ptr mapping{};
+            uint64_t header_offset{};
+        };
+
+        using archive_listing_ptr = std::shared_ptr<const mpq_directory::archive_listing>;
+
+        struct mount_probe {
+            uint32_t index{};
+            mpq_handle_pool_ptr handles{};
+            archive_listing_ptr listing{};
         };
 
         static std::vector<std::string> load_files(const std::filesystem::path &directory);
@@ -30,12 +51,22 @@ namespace wow::io {
         dbc::dbc_manager_ptr _dbc_manager;
 
         std::vector<loaded_archive> _archives{};
-        std::mutex _archive_lock{};
+        std::atomic<mpq_directory_ptr> _directory{};
+
+        std::vector<archive_listing_ptr> _listings{};
+        std::vector<bool> _mounted{};
+        uint32_t _mounted_prefix = 0;
+        bool _is_mounting = false;
+        std::mutex _mount_lock{};
+        std::condition_variable _mount_cv{};
 
         uint32_t _total_mpq_count = 0;
         uint32_t _loaded_mpq_count = 0;
         std::string _locale;
 
+        std::thread _load_thread{};
+        std::mutex _load_thread_lock{};
+
         static void load_base_mpq_files(const std::vector<std::string> &all_mpqs, std::vector<std::string> &out_files);
 
         void load_locale_mpq_files(const std::vector<std::string> &all_mpqs,
@@ -45,12 +76,35 @@ namespace wow::io {
                                           const std::vector<std::filesystem::path> &files,
                                           std::vector<std::string> &out_files);
 
+        void mount_archive(uint32_t index, const std::string &path);
+
+        static bool archive_contains(const mount_probe &probe, const std::string &normalized_path,
+                                     const std::string &path);
+
+        void build_directory();
+
+        std::optional<uint32_t> resolve_while_mounting(const std::string &path);
+
+        std::optional<uint32_t> resolve_listed(const mpq_directory &directory, const std::string &path);
+
+        std::optional<uint32_t> resolve(const std::string &path);
+
     public:
         explicit mpq_manager(web::event::event_manager_ptr event_manager, const dbc::dbc_manager_ptr &dbc_manager);
 
+        ~mpq_manager();
+
         void load_from_folder(const std::string &folder, const std::function<void(int, const std::string &)> &callback);
 
         mpq_file_ptr open(const std::string &path);
+
+        mpq_file_ptr open(const std::string &path, size_t offset, size_t size);
+
+        blp::blp_file_ptr open_blp(const std::string &path);
+
+        bool exists(const std::string &path);
+
+        std::optional<std::string> content_key(const std::string &path);
     };
 
     using mpq_manager_ptr = std::shared_ptr<mpq_manager>;
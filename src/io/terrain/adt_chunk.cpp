@@ -8,71 +8,52 @@
 
 namespace wow::io::terrain {
     gl::index_buffer_ptr adt_chunk::_index_buffer;
-    uint32_t adt_chunk::_alpha_uniform{};
-    uint32_t adt_chunk::_color_uniforms[4]{};
-
-    void adt_chunk::load_alpha_rle(const uint32_t layer, const utils::binary_reader_ptr &reader) {
-        auto num_read = 0;
-        while (num_read < 4096) {
-            const auto indicator = reader->read<uint8_t>();
-            const auto repeat = indicator & 0x7F;
-            if ((indicator & 0x80) != 0) {
-                const auto value = static_cast<uint32_t>(reader->read<uint8_t>());
-                for (auto i = 0; i < repeat; ++i) {
-                    _texture_data[num_read++] |= static_cast<uint32_t>(value) << (layer * 8);
-                }
-            } else {
-                for (auto i = 0; i < repeat; ++i) {
-                    _texture_data[num_read++] |= static_cast<uint32_t>(reader->read<uint8_t>()) << (layer * 8);
-                }
-            }
-        }
-    }
+    terrain_lod_table adt_chunk::_lod_table{};
 
-    void adt_chunk::load_alpha_uncompressed(const uint32_t layer, const utils::binary_reader_ptr &reader) {
-        for (auto i = 0; i < 4096; ++i) {
-            _texture_data[i] |= static_cast<uint32_t>(reader->read<uint8_t>()) << (layer * 8);
+    void adt_chunk::load_alpha_rle(const uint32_t layer, utils::binary_reader &reader, uint8_t *alpha) {
+        const auto result = decode_alpha_rle(reader.data().subspan(reader.position()), alpha);
+        if (!result.complete) {
+            SPDLOG_WARN("MCAL RLE alpha map for layer {} is truncated", layer);
         }
-    }
 
-    void adt_chunk::load_alpha_compressed(const uint32_t layer, const utils::binary_reader_ptr &reader) {
-        auto out_ptr = _texture_data.data();
+        reader.seek_mod(static_cast<ssize_t>(result.consumed));
+    }
 
-        const auto full_alpha = _header.flags.unfixed_alpha_map != 0;
-        for (auto k = 0; k < (full_alpha ? 64 : 63); ++k) {
-            for (auto j = 0; j < 32; ++j) {
-                const auto val = reader->read<uint8_t>();
-                auto val1 = static_cast<uint8_t>(val & 0x0F);
-                auto val2 = static_cast<uint8_t>((j == 31 && !full_alpha) ? val1 : (val >> 4));
+    const uint8_t *adt_chunk::load_alpha_uncompressed(const uint32_t layer, utils::binary_reader &reader) {
+        const auto data = reader.data().subspan(reader.position());
+        if (data.size() < ALPHA_MAP_TEXELS) {
+            SPDLOG_WARN("MCAL alpha map for layer {} is truncated", layer);
+            return nullptr;
+        }
 
-                val1 = static_cast<uint8_t>(val1 * 17);
-                val2 = static_cast<uint8_t>(val2 * 17);
+        reader.seek_mod(ALPHA_MAP_TEXELS);
+        return data.data();
+    }
 
-                *out_ptr++ |= static_cast<uint32_t>(val1) << (layer * 8);
-                *out_ptr++ |= static_cast<uint32_t>(val2) << (layer * 8);
-            }
+    void adt_chunk::load_alpha_compressed(const uint32_t layer, utils::binary_reader &reader, uint8_t *alpha) {
+        const auto result = decode_alpha_4bit(reader.data().subspan(reader.position()),
+                                              _header.flags.unfixed_alpha_map != 0, alpha);
+        if (!result.complete) {
+            SPDLOG_WARN("MCAL alpha map for layer {} is truncated", layer);
+            return;
         }
 
-        if (!full_alpha) {
-            for (auto j = 0; j < 64; ++j) {
-                _texture_data[63 * 64 + j] |= ((_texture_data[62 * 64 + j] >> (layer * 8)) & 0xFF) << (layer * 8);
-            }
-        }
+        reader.seek_mod(static_cast<ssize_t>(result.consumed));
     }
 
-    void adt_chunk::load_heights(const utils::binary_reader_ptr &reader) {
-        if (reader->read<uint32_t>() != 'MCVT') {
+    void adt_chunk::load_heights(utils::binary_reader &reader) {
+        if (reader.read<uint32_t>() != 'MCVT') {
             SPDLOG_ERROR("Chunk has invalid MCVT chunk, signature mismatch");
             return;
         }
 
-        if (reader->read<uint32_t>() < 145 * sizeof(float)) {
+        if (reader.read<uint32_t>() < 145 * sizeof(float)) {
             SPDLOG_ERROR("Chunk has invalid MCVT chunk, size too small");
             return;
         }
 
         std::array<float, 145> heights{};
-        reader->read(heights);
+        reader.read(heights);
 
         auto counter = 0;
 
@@ -104,19 +85,19 @@ namespace wow::io::terrain {
         }
     }
 
-    void adt_chunk::load_normals(const utils::binary_reader_ptr &reader) {
-        if (reader->read<uint32_t>() != 'MCNR') {
+    void adt_chunk::load_normals(utils::binary_reader &reader) {
+        if (reader.read<uint32_t>() != 'MCNR') {
             SPDLOG_ERROR("Chunk has invalid MCNR chunk, signature mismatch");
             return;
         }
 
-        if (reader->read<uint32_t>() < 145 * 3 * sizeof(int8_t)) {
+        if (reader.read<uint32_t>() < 145 * 3 * sizeof(int8_t)) {
             SPDLOG_ERROR("Chunk has invalid MCNR chunk, size too small");
             return;
         }
 
         std::array<int8_t, 145 * 3> normals{};
-        reader->read(normals);
+        reader.read(normals);
         for (auto i = 0; i < 145; ++i) {
             auto &vec = _vectors[i];
             vec.normal.x = static_cast<float>(normals[i * 3]) / -127.0f;
@@ -125,190 +106,192 @@ namespace wow::io::terrain {
         }
     }
 
-    void adt_chunk::load_colors(const utils::binary_reader_ptr &reader) {
-        for (auto &vec: _vectors) {
-            vec.vertex_color = glm::vec3(0.5f, 0.5f, 0.5f);
-        }
-
-        if (reader) {
-            if (reader->read<uint32_t>() != 'MCCV') {
-                SPDLOG_ERROR("Chunk has invalid MCCV chunk, signature mismatch");
-                return;
-            }
-
-            if (reader->read<uint32_t>() < 145 * 4 * sizeof(uint8_t)) {
-                SPDLOG_ERROR("Chunk has invalid MCCV chunk, size too small");
-                return;
-            }
-
-            std::array<glm::i8vec4, 145> colors{};
-            reader->read(colors);
-            for (auto i = 0; i < 145; ++i) {
-                auto &vec = _vectors[i];
-                vec.vertex_color = glm::vec3(colors[i].r / 255.0f, colors[i].g / 255.0f, colors[i].b / 255.0f);
-            }
-        }
-    }
-
-    void adt_chunk::load_shadows(const utils::binary_reader_ptr &reader) {
-        if (_texture_data.empty()) {
-            _texture_data.assign(4096, 0x000000000);
+    void adt_chunk::load_colors(utils::binary_reader &reader) {
+        if (reader.read<uint32_t>() != 'MCCV') {
+            SPDLOG_ERROR("Chunk has invalid MCCV chunk, signature mismatch");
+            return;
         }
 
-        for (auto i = 0; i < 4096; ++i) {
-            _texture_data[i] &= 0x00FFFFFF;
+        if (reader.read<uint32_t>() < 145 * 4 * sizeof(uint8_t)) {
+            SPDLOG_ERROR("Chunk has invalid MCCV chunk, size too small");
+            return;
         }
 
-        if (!reader) {
-            return;
+        std::array<glm::i8vec4, 145> colors{};
+        reader.read(colors);
+        for (auto i = 0; i < 145; ++i) {
+            auto &vec = _vectors[i];
+            vec.vertex_color = glm::vec3(colors[i].r / 255.0f, colors[i].g / 255.0f, colors[i].b / 255.0f);
         }
+    }
 
-        if (reader->read<uint32_t>() != 'MCSH') {
+    const uint8_t *adt_chunk::load_shadows(utils::binary_reader &reader) {
+        if (reader.read<uint32_t>() != 'MCSH') {
             SPDLOG_ERROR("Chunk has invalid MCSH chunk, signature mismatch");
-            return;
+            return nullptr;
         }
 
-        if (reader->read<uint32_t>() < (4096 / 8) * sizeof(uint8_t)) {
+        if (reader.read<uint32_t>() < ALPHA_MAP_TEXELS / 8) {
             SPDLOG_ERROR("Chunk has invalid MCSH chunk, size too small");
-            return;
+            return nullptr;
         }
 
-        for (auto i = 0; i < 64; ++i) {
-            auto val = reader->read<uint64_t>();
-            for (auto j = 0; j < 64; ++j) {
-                _texture_data[i * 64 + j] |= (((val & 0x1) ? 0xFF : 0x00) << 24);
-                val >>= 1;
-            }
+        const auto data = reader.data().subspan(reader.position());
+        if (data.size() < ALPHA_MAP_TEXELS / 8) {
+            SPDLOG_ERROR("Chunk has invalid MCSH chunk, data truncated");
+            return nullptr;
         }
+
+        return data.data();
     }
 
-    void adt_chunk::load_layers(const utils::binary_reader_ptr &reader) {
+    void adt_chunk::load_layers(utils::binary_reader &reader) {
         if (_header.num_layers < 1) {
             return;
         }
 
-        if (reader->read<uint32_t>() != 'MCLY') {
+        if (reader.read<uint32_t>() != 'MCLY') {
             SPDLOG_ERROR("Chunk has invalid MCLY chunk, signature mismatch");
             return;
         }
 
-        if (reader->read<uint32_t>() < _header.num_layers * sizeof(mcly)) {
+        if (reader.read<uint32_t>() < _header.num_layers * sizeof(mcly)) {
             SPDLOG_ERROR("Chunk has invalid MCLY chunk, size too small");
             return;
         }
 
         _layers.resize(_header.num_layers);
-        reader->read(_layers);
+        reader.read(_layers);
+        resolve_textures();
+    }
 
-        for (auto i = 0; i < _header.num_layers; ++i) {
-            const auto layer = _layers[i];
-            auto tex = _parent_tile.lock()->find_texture(layer.texture_id);
-            if (!tex) {
+    void adt_chunk::resolve_textures() {
+        const auto tile = _parent_tile.lock();
+        std::array<int32_t, 4> layers{-1, -1, -1, -1};
+        std::array<int32_t, 4> textures{-1, -1, -1, -1};
+        for (size_t i = 0; i < _layers.size() && i < layers.size(); ++i) {
+            layers[i] = tile->find_texture(static_cast<int32_t>(_layers[i].texture_id));
+            if (layers[i] < 0) {
                 SPDLOG_ERROR("Chunk has invalid MCLY chunk, texture not found");
-                return;
+            } else {
+                textures[i] = static_cast<int32_t>(_layers[i].texture_id);
             }
+        }
+
+        tile->set_chunk_layers(_header.index_y * 16 + _header.index_x, layers, textures);
+    }
+
+    void adt_chunk::update_bounds() {
+        _bounds = utils::bounding_box(_vectors[0].position, _vectors[0].position);
+        for (const auto &v: _vectors) {
+            _bounds.take_min_max(v.position);
+        }
 
-            _textures.push_back(tex);
+        if (_bounds.max().z - _bounds.min().z < 5) {
+            _bounds.max().z = _bounds.min().z + 5;
         }
+
+        const auto planar = [this](const uint32_t index) {
+            return glm::vec2{_vectors[index].position.x, _vectors[index].position.y};
+        };
+
+        _center = planar(72);
+        _neighbor_centers = {
+            planar(4) * 2.0f - _center,
+            planar(76) * 2.0f - _center,
+            planar(140) * 2.0f - _center,
+            planar(68) * 2.0f - _center
+        };
     }
 
-    void adt_chunk::load_alpha(const utils::binary_reader_ptr &reader) {
-        if (reader->read<uint32_t>() != 'MCAL') {
+    void adt_chunk::load_alpha(utils::binary_reader &reader, alpha_shadow_source &source, alpha_buffers &buffers) {
+        if (reader.read<uint32_t>() != 'MCAL') {
             SPDLOG_ERROR("Chunk has invalid MCAL chunk, signature mismatch");
             return;
         }
 
-        _texture_data.assign(4096, 0x000000000);
-
-        for (auto i = 1; i < _header.num_layers; ++i) {
+        const auto num_layers = std::min<size_t>(_layers.size(), source.alpha.size() + 1);
+        for (size_t i = 1; i < num_layers; ++i) {
             const auto layer = _layers[i];
+            const auto plane = static_cast<uint32_t>(i - 1);
             if (!layer.flags.use_alpha_map && !layer.flags.alpha_map_compressed) {
-                for (auto k = 0; k < 4096; ++k) {
-                    _texture_data[k] |= (0xFF << ((i - 1) * 8));
-                }
+                source.alpha[plane] = opaque_alpha_plane();
                 continue;
             }
 
-            if (layer.offset_mcal + _header.ofs_alpha + 8 >= reader->size()) {
+            if (layer.offset_mcal + _header.ofs_alpha + 8 >= reader.size()) {
                 SPDLOG_WARN("Invalid MCAL chunk, offset too large");
                 continue;
             }
 
-            reader->seek(_header.ofs_alpha + layer.offset_mcal + 8);
+            reader.seek(_header.ofs_alpha + layer.offset_mcal + 8);
 
             if (layer.flags.alpha_map_compressed) {
-                load_alpha_rle(i - 1, reader);
+                load_alpha_rle(plane, reader, buffers[plane].data());
+                source.alpha[plane] = buffers[plane].data();
             } else if (_use_big_alpha) {
-                load_alpha_uncompressed(i - 1, reader);
+                source.alpha[plane] = load_alpha_uncompressed(plane, reader);
             } else {
-                load_alpha_compressed(i - 1, reader);
+                load_alpha_compressed(plane, reader, buffers[plane].data());
+                source.alpha[plane] = buffers[plane].data();
             }
+        }
+    }
+
+    std::optional<chunk_corner_heights> adt_chunk::read_corner_heights(utils::binary_reader &reader) {
+        if (reader.read<uint32_t>() != 'MCNK') {
+            return std::nullopt;
+        }
 
-            reader->seek(layer.offset_mcal);
+        reader.seek_mod(4);
+        const auto header = reader.read<map_chunk_header>();
+        if (header.index_x >= 16 || header.index_y >= 16) {
+            return std::nullopt;
         }
+
+        reader.seek(header.ofs_heights);
+        if (reader.read<uint32_t>() != 'MCVT' || reader.read<uint32_t>() < 145 * sizeof(float)) {
+            return std::nullopt;
+        }
+
+        std::array<float, 145> heights{};
+        reader.read(heights);
+
+        return chunk_corner_heights{
+            .index_x = header.index_x,
+            .index_y = header.index_y,
+            .heights = {
+                header.position.z + heights[0],
+                header.position.z + heights[8],
+                header.position.z + heights[136],
+                header.position.z + heights[144]
+            }
+        };
     }
 
-    void adt_chunk::sync_load() {
+    void adt_chunk::initialize_index_buffer() {
         static std::once_flag flag{};
         std::call_once(flag, [] {
             _index_buffer = std::make_shared<gl::index_buffer>(gl::index_type::uint16);
 
-            std::array<uint16_t, 768> indices{};
-            for (auto y = 0u; y < 8; ++y) {
-                for (auto x = 0u; x < 8; ++x) {
-                    const auto i = y * 8 * 12 + x * 12;
-                    indices[i + 0] = y * 17 + x;
-                    indices[i + 2] = y * 17 + x + 9;
-                    indices[i + 1] = y * 17 + x + 1;
-
-                    indices[i + 3] = y * 17 + x + 1;
-                    indices[i + 5] = y * 17 + x + 9;
-                    indices[i + 4] = y * 17 + x + 18;
-
-                    indices[i + 6] = y * 17 + x + 18;
-                    indices[i + 8] = y * 17 + x + 9;
-                    indices[i + 7] = y * 17 + x + 17;
-
-                    indices[i + 9] = y * 17 + x + 17;
-                    indices[i + 11] = y * 17 + x + 9;
-                    indices[i + 10] = y * 17 + x;
-                }
-            }
-
+            const auto indices = build_terrain_lod_indices(_lod_table);
             _index_buffer->set_data(indices);
             gl::mesh::terrain_mesh().mesh->index_buffer(_index_buffer);
-
-
-            _alpha_uniform = gl::mesh::terrain_mesh().mesh->program()->uniform_location("shadow_texture");
-            for (auto i = 0; i < 4; ++i) {
-                _color_uniforms[i] = gl::mesh::terrain_mesh().mesh->program()->uniform_location(
-                    fmt::format("color_texture{}", i));
-            }
         });
-
-        _shadow_texture = gl::make_texture();
-        _shadow_texture->bgra_image(64, 64, _texture_data.data());
-        _shadow_texture->filtering(GL_LINEAR, GL_LINEAR);
-        _shadow_texture->wrap(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
-        _texture_data.clear();
-
-
-        _is_sync_loaded = true;
-        utils::app_module->map_manager()->add_load_progress();
     }
 
     adt_chunk::adt_chunk(
         const wdt_file_ptr &wdt,
         const adt_tile_ptr &tile,
-        const utils::binary_reader_ptr &reader
+        utils::binary_reader &reader
     ) : _parent_tile(tile) {
-        if (reader->read<uint32_t>() != 'MCNK') {
+        if (reader.read<uint32_t>() != 'MCNK') {
             SPDLOG_ERROR("Chunk has invalid MCNK chunk, signature mismatch");
             return;
         }
 
-        reader->seek_mod(4);
-        _header = reader->read<map_chunk_header>();
+        reader.seek_mod(4);
+        _header = reader.read<map_chunk_header>();
 
         if (!_header.ofs_heights) {
             return;
@@ -316,82 +299,105 @@ namespace wow::io::terrain {
 
         _use_big_alpha = wdt->has_large_alpha();
 
-        reader->seek(_header.ofs_heights);
+        reader.seek(_header.ofs_heights);
         load_heights(reader);
-        reader->seek(_header.ofs_normals);
+        reader.seek(_header.ofs_normals);
         load_normals(reader);
 
+        for (auto &vec: _vectors) {
+            vec.vertex_color = glm::vec3(0.5f, 0.5f, 0.5f);
+        }
+
         if (_header.ofs_mccv > 0) {
-            reader->seek(_header.ofs_mccv);
+            reader.seek(_header.ofs_mccv);
             load_colors(reader);
-        } else {
-            load_colors(nullptr);
         }
 
         _parent_tile.lock()->update_vectors(_vectors, (_header.index_y * 16 + _header.index_x) * 145);
 
         if (_header.num_layers > 0) {
-            reader->seek(_header.ofs_layer);
+            reader.seek(_header.ofs_layer);
             load_layers(reader);
         }
 
+        alpha_shadow_source source{};
+        alpha_buffers buffers{};
         if (_header.num_layers > 1 && _header.size_alpha > 8 && _header.ofs_alpha > 0) {
-            reader->seek(_header.ofs_alpha);
-            load_alpha(reader);
+            reader.seek(_header.ofs_alpha);
+            load_alpha(reader, source, buffers);
         }
 
         if (_header.size_shadow > 8) {
-            reader->seek(_header.ofs_shadow);
-            load_shadows(reader);
-        } else {
-            load_shadows(nullptr);
+            reader.seek(_header.ofs_shadow);
+            source.shadow = load_shadows(reader);
         }
 
-        _bounds = utils::bounding_box(_vectors[0].position, _vectors[0].position);
-        for (const auto &v: _vectors) {
-            _bounds.take_min_max(v.position);
-        }
-
-        if (_bounds.max().z - _bounds.min().z < 5) {
-            _bounds.max().z = _bounds.min().z + 5;
-        }
+        std::array<uint32_t, ALPHA_MAP_TEXELS> texels{};
+        pack_alpha_shadow(source, texels.data());
+        _parent_tile.lock()->update_alpha(_header.index_x, _header.index_y, texels);
 
+        update_bounds();
         _is_async_loaded = true;
     }
 
-    void adt_chunk::on_frame(const scene::scene_info &scene_info) {
-        if (!_is_async_loaded) {
+    adt_chunk::adt_chunk(const adt_tile_ptr &tile, utils::binary_reader &cached) : _parent_tile(tile) {
+        const auto is_loaded = cached.read<uint8_t>() != 0;
+        _header = cached.read<map_chunk_header>();
+        if (!is_loaded) {
             return;
         }
 
-        if (!_is_sync_loaded) {
-            if (_sync_load_requested) {
-                return;
-            }
+        cached.read(_vectors);
+        _layers.resize(cached.read<uint32_t>());
+        cached.read(_layers);
 
-            _sync_load_requested = true;
-            utils::app_module->gpu_dispatcher()->dispatch([this] { sync_load(); });
-            return;
-        }
+        tile->update_vectors(_vectors, (_header.index_y * 16 + _header.index_x) * 145);
+        resolve_textures();
+        update_bounds();
+        _is_async_loaded = true;
+    }
 
-        if (!_bounds.intersects_sphere(scene_info.camera_position, scene_info.view_distance)) {
+    void adt_chunk::save(utils::binary_writer &writer) const {
+        writer.write(static_cast<uint8_t>(_is_async_loaded ? 1 : 0));
+        writer.write(_header);
+        if (!_is_async_loaded) {
             return;
         }
 
-        if (!utils::app_module->camera()->view_frustum().intersects_aabb(_bounds)) {
-            return;
-        }
+        writer.write(_vectors);
+        writer.write(static_cast<uint32_t>(_layers.size()));
+        writer.write(_layers);
+    }
 
-        const auto mesh = gl::mesh::terrain_mesh().mesh;
-        for (auto i = 0; i < _header.num_layers; ++i) {
-            mesh->texture(_color_uniforms[i], _textures[i]);
+    uint32_t adt_chunk::lod(const glm::vec2 &camera, const float lod_distance) const {
+        return select_terrain_lod(glm::distance(camera, _center), lod_distance);
+    }
+
+    uint32_t adt_chunk::stitch_edges(const glm::vec2 &camera, const float lod_distance, const uint32_t lod) const {
+        uint32_t edges = 0;
+        for (auto i = 0u; i < _neighbor_centers.size(); ++i) {
+            if (select_terrain_lod(glm::distance(camera, _neighbor_centers[i]), lod_distance) > lod) {
+                edges |= 1u << i;
+            }
         }
 
-        mesh->texture(_alpha_uniform, _shadow_texture);
-        // ReSharper disable once CppExpressionWithoutSideEffects
-        mesh->bind_textures();
+        return edges;
+    }
+
+    gl::draw_elements_indirect_command adt_chunk::draw_command(const uint32_t lod, const uint32_t edges) const {
+        const auto chunk_index = _header.index_y * 16 + _header.index_x;
+        const auto &range = _lod_table[lod][edges];
+        return {
+            .count = range.count,
+            .instance_count = 1,
+            .first_index = range.first_index,
+            .base_vertex = static_cast<int32_t>(chunk_index * 145),
+            .base_instance = chunk_index
+        };
+    }
 
-        mesh->draw(true, (_header.index_y * 16 + _header.index_x) * 145);
+    size_t adt_chunk::cpu_memory_usage() const {
+        return sizeof(adt_chunk) + _layers.capacity() * sizeof(mcly);
     }
 
     uint32_t vector_index(const uint32_t row, const uint32_t column) {
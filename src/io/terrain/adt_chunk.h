@@ -3,9 +3,13 @@
 
 #include <atomic>
 #include <memory>
+#include <optional>
 
+#include "alpha_map.h"
+#include "terrain_lod.h"
 #include "wdt_file.h"
 #include "gl/index_buffer.h"
+#include "gl/indirect_buffer.h"
 #include "gl/texture.h"
 #include "gl/vertex_buffer.h"
 #include "glm/vec2.hpp"
@@ -29,8 +33,22 @@ namespace wow::io::terrain {
         glm::vec3 vertex_color{};
     };
 
+    struct adt_packed_vector {
+        float height{};
+        std::array<int8_t, 4> normal{};
+        std::array<uint8_t, 4> vertex_color{};
+    };
+
+    static_assert(sizeof(adt_packed_vector) == 12);
+
 #pragma pack(pop)
 
+    struct chunk_corner_heights {
+        uint32_t index_x{};
+        uint32_t index_y{};
+        std::array<float, 4> heights{};
+    };
+
     class adt_chunk {
 #pragma pack(push, 1)
         struct map_chunk_flags {
@@ -103,72 +121,93 @@ namespace wow::io::terrain {
 #pragma pack(pop)
 
         static gl::index_buffer_ptr _index_buffer;
-        static uint32_t _alpha_uniform;
-        static uint32_t _color_uniforms[4];
-
-        gl::texture_ptr _shadow_texture{};
+        static terrain_lod_table _lod_table;
 
         std::weak_ptr<adt_tile> _parent_tile{};
 
         std::atomic_bool _is_async_loaded = false;
-        bool _is_sync_loaded = false;
-        bool _sync_load_requested = false;
 
         bool _use_big_alpha = false;
 
         utils::bounding_box _bounds{};
+        glm::vec2 _center{};
+        std::array<glm::vec2, 4> _neighbor_centers{};
 
         map_chunk_header _header{};
 
         std::array<adt_vector, 145> _vectors{};
 
-        std::vector<gl::texture_ptr> _textures{};
-        std::vector<uint32_t> _texture_data{};
         std::vector<mcly> _layers{};
 
-        void load_alpha_rle(uint32_t layer, const utils::binary_reader_ptr &reader);
+        using alpha_buffers = std::array<std::array<uint8_t, ALPHA_MAP_TEXELS>, 3>;
+
+        void load_alpha_rle(uint32_t layer, utils::binary_reader &reader, uint8_t *alpha);
+
+        const uint8_t *load_alpha_uncompressed(uint32_t layer, utils::binary_reader &reader);
 
-        void load_alpha_uncompressed(uint32_t layer, const utils::binary_reader_ptr &reader);
+        void load_alpha_compressed(uint32_t layer, utils::binary_reader &reader, uint8_t *alpha);
 
-        void load_alpha_compressed(uint32_t layer, const utils::binary_reader_ptr &reader);
+        void load_heights(utils::binary_reader &reader);
 
-        void load_heights(const utils::binary_reader_ptr &reader);
+        void load_normals(utils::binary_reader &reader);
 
-        void load_normals(const utils::binary_reader_ptr &reader);
+        void load_colors(utils::binary_reader &reader);
 
-        void load_colors(const utils::binary_reader_ptr &reader);
+        const uint8_t *load_shadows(utils::binary_reader &reader);
 
-        void load_shadows(const utils::binary_reader_ptr &reader);
+        void load_layers(utils::binary_reader &reader);
 
-        void load_layers(const utils::binary_reader_ptr &reader);
+        void load_alpha(utils::binary_reader &reader, alpha_shadow_source &source, alpha_buffers &buffers);
 
-        void load_alpha(const utils::binary_reader_ptr &reader);
+        void resolve_textures();
 
-        void sync_load();
+        void update_bounds();
 
     public:
         explicit adt_chunk(
             const wdt_file_ptr &wdt,
             const adt_tile_ptr &tile,
-            const utils::binary_reader_ptr &reader
+            utils::binary_reader &reader
         );
 
+        adt_chunk(const adt_tile_ptr &tile, utils::binary_reader &cached);
+
+        void save(utils::binary_writer &writer) const;
+
         [[nodiscard]] std::pair<uint32_t, uint32_t> index() const {
             return {_header.index_x, _header.index_y};
         }
 
-        void on_frame(const scene::scene_info &scene_info);
+        [[nodiscard]] bool is_async_loaded() const {
+            return _is_async_loaded;
+        }
+
+        [[nodiscard]] uint32_t lod(const glm::vec2 &camera, float lod_distance) const;
+
+        [[nodiscard]] uint32_t stitch_edges(const glm::vec2 &camera, float lod_distance, uint32_t lod) const;
+
+        [[nodiscard]] gl::draw_elements_indirect_command draw_command(uint32_t lod, uint32_t edges) const;
 
         [[nodiscard]] const utils::bounding_box &bounds() const {
             return _bounds;
         }
 
+        [[nodiscard]] const glm::vec2 &center() const {
+            return _center;
+        }
+
         int32_t area_id() const {
             return _header.area_id;
         }
 
         float height(float x, float y) const;
 
+        [[nodiscard]] size_t cpu_memory_usage() const;
+
+        static std::optional<chunk_corner_heights> read_corner_heights(utils::binary_reader &reader);
+
+        static void initialize_index_buffer();
+
         static const gl::index_buffer_ptr &index_buffer() {
             return _index_buffer;
         }
@@ -1,29 +1,69 @@
 #include "adt_tile.h"
 
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <numeric>
 #include <utility>
 
 #include "spdlog/spdlog.h"
+#include "gl/render_stats.h"
 #include "utils/di.h"
 
 namespace wow::io::terrain {
-    void adt_tile::read_chunks(const utils::binary_reader_ptr &reader) {
-        while (!reader->eof()) {
-            const auto signature = reader->read<uint32_t>();
-            const auto size = reader->read<uint32_t>();
-            std::vector<uint8_t> data(size);
-            reader->read(data.data(), size);
+    std::array<int32_t, ADT_TEXTURE_ARRAY_SLOTS> adt_tile::_array_uniforms{};
+    int32_t adt_tile::_alpha_uniform{};
+    int32_t adt_tile::_origin_uniform{};
+
+    namespace {
+        constexpr size_t alpha_texel_count() {
+            size_t count = 0;
+            for (auto i = 0u; i < ADT_ALPHA_TEXTURE_LEVELS; ++i) {
+                const auto size = static_cast<size_t>(ADT_ALPHA_TEXTURE_SIZE >> i);
+                count += size * size;
+            }
+
+            return count;
+        }
+    }
+
+    void adt_tile::read_chunks(const std::span<const uint8_t> data) {
+        _data_chunks.clear();
+        _data_chunks.reserve(16);
+
+        size_t offset = 0;
+        while (offset + 8 <= data.size()) {
+            uint32_t signature{};
+            uint32_t size{};
+            memcpy(&signature, data.data() + offset, sizeof(uint32_t));
+            memcpy(&size, data.data() + offset + 4, sizeof(uint32_t));
+            offset += 8;
+
+            if (size > data.size() - offset) {
+                SPDLOG_WARN("ADT tile {},{} has truncated chunk {:08X}, ignoring remaining data", _x, _y, signature);
+                break;
+            }
+
             if (signature != 'MCNK') {
-                _data_chunks[signature] = {signature, size, std::move(data)};
+                _data_chunks.push_back({signature, data.subspan(offset, size)});
             }
+
+            offset += size;
         }
     }
 
-    bool adt_tile::load_chunk_indices() {
-        if (!_data_chunks.contains('MCIN')) {
-            return false;
+    std::span<const uint8_t> adt_tile::find_chunk(const uint32_t signature) const {
+        for (const auto &chunk: _data_chunks) {
+            if (chunk.signature == signature) {
+                return chunk.data;
+            }
         }
 
-        const auto data = _data_chunks['MCIN'].data;
+        return {};
+    }
+
+    bool adt_tile::load_chunk_indices() {
+        const auto data = find_chunk('MCIN');
         if (data.size() < 256 * sizeof(decltype(_chunk_indices)::value_type)) {
             return false;
         }
@@ -34,32 +74,144 @@ namespace wow::io::terrain {
     }
 
     void adt_tile::load_textures() {
-        if (!_data_chunks.contains('MTEX')) {
-            return;
-        }
-
-        const auto str_data = _data_chunks['MTEX'].data;
+        const auto str_data = find_chunk('MTEX');
         const auto str_ptr = reinterpret_cast<const char *>(str_data.data());
         const auto str_end = str_ptr + str_data.size();
         auto cur_offset = str_ptr;
 
         while (cur_offset < str_end) {
-            const auto texture_name = std::string{cur_offset};
+            const auto texture_name = std::string(cur_offset, strnlen(cur_offset, str_end - cur_offset));
             cur_offset += texture_name.size() + 1;
-            _texture_map.emplace_back(_texture_manager->load(texture_name));
+            add_texture(texture_name);
+        }
+    }
+
+    void adt_tile::add_texture(const std::string &texture_name) {
+        const auto texture = _texture_atlas ? _texture_atlas->load(texture_name) : nullptr;
+        _texture_names.emplace_back(texture_name);
+        _texture_map.emplace_back(texture);
+
+        if (!texture) {
+            _texture_slots.push_back(-1);
+            return;
+        }
+
+        auto slot = std::ranges::find(_texture_pages, texture->page());
+        if (slot == _texture_pages.end()) {
+            if (_texture_pages.size() >= ADT_TEXTURE_ARRAY_SLOTS) {
+                SPDLOG_WARN("ADT tile {},{} uses more than {} terrain texture arrays, skipping {}", _x, _y,
+                            ADT_TEXTURE_ARRAY_SLOTS, texture_name);
+                _texture_slots.push_back(-1);
+                return;
+            }
+
+            _texture_pages.push_back(texture->page());
+            slot = _texture_pages.end() - 1;
+        }
+
+        const auto slot_index = static_cast<int32_t>(std::distance(_texture_pages.begin(), slot));
+        _texture_slots.push_back(slot_index << 24 | static_cast<int32_t>(texture->residency_index()));
+    }
+
+    void adt_tile::update_alpha(const uint32_t chunk_x, const uint32_t chunk_y,
+                                const std::array<uint32_t, ALPHA_MAP_TEXELS> &texels) {
+        if (chunk_x >= 16 || chunk_y >= 16 || _alpha_data.empty()) {
+            return;
+        }
+
+        constexpr auto stride = ADT_ALPHA_TEXTURE_SIZE;
+        const auto base = _alpha_data.data() + static_cast<size_t>(chunk_y) * 64 * stride + chunk_x * 64;
+        for (auto row = 0u; row < 64; ++row) {
+            std::copy_n(texels.begin() + row * 64, 64, base + row * stride);
+        }
+    }
+
+    void adt_tile::build_alpha_mipmaps() {
+        if (_alpha_data.size() < alpha_texel_count()) {
+            return;
+        }
+
+        auto src = _alpha_data.data();
+        auto size = ADT_ALPHA_TEXTURE_SIZE;
+        for (auto level = 1u; level < ADT_ALPHA_TEXTURE_LEVELS; ++level) {
+            const auto dst = src + static_cast<size_t>(size) * size;
+            const auto half = size / 2;
+            for (auto y = 0u; y < half; ++y) {
+                for (auto x = 0u; x < half; ++x) {
+                    const auto texel = src + static_cast<size_t>(y) * 2 * size + x * 2;
+                    uint32_t value = 0;
+                    for (auto shift = 0u; shift < 32; shift += 8) {
+                        const auto sum = ((texel[0] >> shift) & 0xFF) + ((texel[1] >> shift) & 0xFF) +
+                                         ((texel[size] >> shift) & 0xFF) + ((texel[size + 1] >> shift) & 0xFF);
+                        value |= ((sum + 2) / 4) << shift;
+                    }
+
+                    dst[y * half + x] = value;
+                }
+            }
+
+            src = dst;
+            size = half;
         }
     }
 
-    void adt_tile::load_chunks(wdt_file_ptr wdt, const utils::binary_reader_ptr &reader) {
-        for (const auto &mcin: _chunk_indices) {
-            reader->seek(mcin.offset);
-            std::vector<uint8_t> data(mcin.size);
-            reader->read(data.data(), mcin.size);
-            const auto chunk = std::make_shared<adt_chunk>(
-                wdt,
-                shared_from_this(),
-                utils::make_binary_reader(data)
-            );
+    void adt_tile::set_chunk_layers(const uint32_t index, const std::array<int32_t, 4> &layers,
+                                    const std::array<int32_t, 4> &textures) {
+        if (index >= _chunk_state.layers.size()) {
+            return;
+        }
+
+        _chunk_state.layers[index] = layers;
+        _chunk_textures[index] = textures;
+    }
+
+    void adt_tile::request_textures(const glm::vec2 &camera, const float pixels_per_unit) {
+        if (pixels_per_unit <= 0.0f) {
+            return;
+        }
+
+        _texture_footprints.assign(_texture_map.size(), std::numeric_limits<float>::max());
+        for (const auto slot: _visible_chunks) {
+            const auto &chunk = _chunks[_chunk_slots[slot]];
+            const auto [x, y] = chunk->index();
+            const auto distance = std::max(glm::distance(camera, chunk->center()) - utils::CHUNK_SIZE * 0.5f,
+                                           utils::VERTEX_SIZE);
+            const auto footprint = distance / (utils::VERTEX_SIZE * pixels_per_unit);
+
+            for (const auto texture: _chunk_textures[y * 16 + x]) {
+                if (texture >= 0 && static_cast<size_t>(texture) < _texture_footprints.size()) {
+                    _texture_footprints[texture] = std::min(_texture_footprints[texture], footprint);
+                }
+            }
+        }
+
+        for (auto i = 0u; i < _texture_map.size(); ++i) {
+            if (_texture_map[i] && _texture_footprints[i] < std::numeric_limits<float>::max()) {
+                _texture_atlas->request(*_texture_map[i], _texture_footprints[i]);
+            }
+        }
+    }
+
+    void adt_tile::load_chunks(const wdt_file_ptr &wdt, const std::span<const uint8_t> data, utils::work_pool &pool) {
+        std::array<adt_chunk_ptr, ADT_CHUNK_COUNT> decoded{};
+        const auto self = shared_from_this();
+
+        pool.parallel_for(_chunk_indices.size(), [&](const size_t index) {
+            const auto &mcin = _chunk_indices[index];
+            if (mcin.offset > data.size() || mcin.size > data.size() - mcin.offset) {
+                SPDLOG_WARN("Invalid MCNK offset {} (size {}) in ADT tile {},{}", mcin.offset, mcin.size, _x, _y);
+                return;
+            }
+
+            utils::binary_reader reader{data.subspan(mcin.offset, mcin.size)};
+            decoded[index] = std::make_shared<adt_chunk>(wdt, self, reader);
+        });
+
+        for (const auto &chunk: decoded) {
+            if (!chunk) {
+                continue;
+            }
+
             auto [x, y] = chunk->index();
             if (x >= 16 || y >= 16) {
                 SPDLOG_WARN("Invalid chunk index {},{} in ADT tile {},{}", x, y, _x, _y);
@@ -75,9 +227,100 @@ namespace wow::io::terrain {
             return;
         }
 
+        static std::once_flag flag{};
+        std::call_once(flag, [] {
+            const auto program = gl::mesh::terrain_mesh().mesh->program();
+            program->storage_block("terrain_chunks", 0);
+            program->storage_block("terrain_texture_residency", scene::TERRAIN_RESIDENCY_BINDING);
+            for (auto i = 0u; i < ADT_TEXTURE_ARRAY_SLOTS; ++i) {
+                _array_uniforms[i] = program->uniform_location(fmt::format("color_arrays[{}]", i));
+            }
+
+            _alpha_uniform = program->uniform_location("shadow_texture");
+            _origin_uniform = program->uniform_location("tile_origin");
+            SPDLOG_INFO("Terrain vertices use {} bytes per vertex ({} KB per tile, {} KB unpacked)",
+                        sizeof(adt_packed_vector), vertex_memory_usage() / 1024,
+                        ADT_CHUNK_COUNT * ADT_CHUNK_VECTOR_COUNT * sizeof(adt_vector) / 1024);
+            adt_chunk::initialize_index_buffer();
+        });
+
         _sync_loaded = true;
-        _vertex_buffer = gl::make_vertex_buffer();
-        _vertex_buffer->set_data(_vectors);
+        if (!_vectors_staged && !_vertex_buffer) {
+            _vertex_buffer = gl::make_vertex_buffer();
+            _vertex_buffer->set_data(_vectors);
+        }
+
+        _chunk_buffer = gl::make_storage_buffer();
+        _chunk_buffer->set_data(_chunk_state);
+
+        _indirect_buffer = gl::make_indirect_buffer();
+        _draw_commands.reserve(ADT_CHUNK_COUNT);
+
+        if (!_alpha_staged) {
+            _alpha_texture = create_alpha_texture(_alpha_data);
+            release_alpha_data();
+        }
+
+        for (const auto page: _texture_pages) {
+            _texture_arrays.push_back(_texture_atlas->page(page));
+        }
+
+        if (_texture_arrays.empty()) {
+            _texture_arrays.push_back(_texture_atlas->empty_page());
+        }
+
+        utils::app_module->map_manager()->add_load_progress(ADT_CHUNK_COUNT);
+    }
+
+    void adt_tile::release_alpha_data() {
+        _cpu_memory_usage -= _alpha_data.capacity() * sizeof(uint32_t);
+        _alpha_data.clear();
+        _alpha_data.shrink_to_fit();
+    }
+
+    gl::texture_ptr adt_tile::create_alpha_texture(const std::vector<uint32_t> &alpha_data) {
+        auto texture = gl::make_texture();
+        texture->bgra_mipmaps(ADT_ALPHA_TEXTURE_SIZE, ADT_ALPHA_TEXTURE_SIZE, ADT_ALPHA_TEXTURE_LEVELS,
+                              alpha_data.data());
+        texture->filtering(GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR);
+        texture->wrap(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+        return texture;
+    }
+
+    void adt_tile::stage_vectors() {
+        const auto allocation = gl::upload_ring::instance().allocate(sizeof(_vectors), gl::UPLOAD_RING_ALIGNMENT, false);
+        if (!allocation) {
+            return;
+        }
+
+        std::memcpy(allocation->data, _vectors.data(), sizeof(_vectors));
+        _vectors_staged = true;
+        utils::app_module->gpu_dispatcher()->upload([upload = *allocation] {
+            auto buffer = gl::make_vertex_buffer();
+            buffer->allocate(upload.size);
+            gl::upload_ring::instance().copy_to_buffer(upload, buffer->native());
+            return buffer;
+        }, [tile = shared_from_this(), upload = *allocation](gl::vertex_buffer_ptr buffer) {
+            gl::upload_ring::instance().release(upload);
+            if (!tile->_vertex_buffer && !tile->_async_unloaded) {
+                tile->_vertex_buffer = std::move(buffer);
+            }
+        });
+    }
+
+    void adt_tile::stage_alpha() {
+        if (_alpha_data.size() < alpha_texel_count()) {
+            return;
+        }
+
+        _alpha_staged = true;
+        utils::app_module->gpu_dispatcher()->upload([tile = shared_from_this()] {
+            return create_alpha_texture(tile->_alpha_data);
+        }, [tile = shared_from_this()](gl::texture_ptr texture) {
+            if (!tile->_alpha_texture) {
+                tile->_alpha_texture = std::move(texture);
+            }
+        });
     }
 
     void adt_tile::update_vectors(const std::array<adt_vector, ADT_CHUNK_VECTOR_COUNT> &vectors, uint32_t offset) {
@@ -86,7 +329,21 @@ namespace wow::io::terrain {
             return;
         }
 
-        std::ranges::copy(vectors, _vectors.begin() + offset);
+        const auto quantize = [](const float value, const float scale, const float min_value) {
+            return std::clamp(std::round(value * scale), min_value, scale);
+        };
+
+        std::ranges::transform(vectors, _vectors.begin() + offset, [&quantize](const adt_vector &vector) {
+            adt_packed_vector packed{};
+            packed.height = vector.position.z;
+            for (auto i = 0; i < 3; ++i) {
+                packed.normal[i] = static_cast<int8_t>(quantize(vector.normal[i], 127.0f, -127.0f));
+                packed.vertex_color[i] = static_cast<uint8_t>(quantize(vector.vertex_color[i], 255.0f, 0.0f));
+            }
+
+            packed.vertex_color[3] = 0xFF;
+            return packed;
+        });
     }
 
     adt_tile::adt_tile(
@@ -94,11 +351,18 @@ namespace wow::io::terrain {
         const uint32_t x,
         const uint32_t y,
         utils::binary_reader_ptr reader,
-        scene::texture_manager_ptr texture_manager) : _x(x),
-                                                      _y(y),
-                                                      _reader(std::move(reader)),
-                                                      _wdt(std::move(wdt)),
-                                                      _texture_manager(std::move(texture_manager)) {
+        scene::terrain_texture_atlas_ptr texture_atlas) : _x(x),
+                                                           _y(y),
+                                                           _reader(std::move(reader)),
+                                                           _wdt(std::move(wdt)),
+                                                           _texture_atlas(std::move(texture_atlas)) {
+        for (auto &layers: _chunk_state.layers) {
+            layers.fill(-1);
+        }
+
+        for (auto &textures: _chunk_textures) {
+            textures.fill(-1);
+        }
     }
 
     void adt_tile::on_frame(const scene::scene_info &scene_info) {
@@ -106,12 +370,64 @@ namespace wow::io::terrain {
             return;
         }
 
+        const auto &frustum = utils::app_module->camera()->view_frustum();
+        const auto tile_cull_start = std::chrono::steady_clock::now();
+        const auto tile_containment = frustum.classify_aabb(_bounds);
+        gl::render_stats::cull_time(std::chrono::steady_clock::now() - tile_cull_start);
+
         if (utils::app_module->map_manager()->is_initial_load_complete() &&
-            !utils::app_module->camera()->view_frustum().intersects_aabb(_bounds)) {
+            tile_containment == scene::containment::outside) {
             return;
         }
 
+        _last_visible = std::chrono::steady_clock::now().time_since_epoch().count();
         sync_load();
+        if (!_vertex_buffer || !_alpha_texture) {
+            return;
+        }
+
+        if (!_textures_resident) {
+            _textures_resident = std::ranges::all_of(_texture_map, [this](const scene::terrain_texture_ptr &texture) {
+                return !texture || _texture_atlas->is_resident(*texture);
+            });
+
+            if (!_textures_resident) {
+                return;
+            }
+        }
+
+        if (!_alpha_data.empty()) {
+            release_alpha_data();
+        }
+
+        const auto chunk_cull_start = std::chrono::steady_clock::now();
+        if (tile_containment == scene::containment::inside &&
+            _bounds.inside_sphere(scene_info.camera_position, scene_info.view_distance)) {
+            _visible_chunks.resize(_chunk_bounds.size());
+            std::iota(_visible_chunks.begin(), _visible_chunks.end(), 0u);
+        } else {
+            frustum.cull(_chunk_bounds, scene_info.camera_position, scene_info.view_distance, _visible_chunks);
+        }
+
+        const glm::vec2 camera{scene_info.camera_position.x, scene_info.camera_position.y};
+        _draw_commands.clear();
+        for (const auto slot: _visible_chunks) {
+            const auto &chunk = _chunks[_chunk_slots[slot]];
+            const auto lod = chunk->lod(camera, scene_info.lod_distance);
+            const auto command = chunk->draw_command(lod, chunk->stitch_edges(camera, scene_info.lod_distance, lod));
+            _draw_commands.push_back(command);
+            gl::render_stats::lod_triangles(lod, command.count / 3);
+        }
+
+        gl::render_stats::cull_time(std::chrono::steady_clock::now() - chunk_cull_start);
+        request_textures(camera, scene_info.pixels_per_unit);
+        gl::render_stats::chunks_culled(static_cast<uint32_t>(_visible_chunks.size()),
+                                        static_cast<uint32_t>(_chunk_bounds.size()));
+
+        if (_draw_commands.empty()) {
+            return;
+        }
+
         const auto mesh = gl::mesh::terrain_mesh().mesh;
         // ReSharper disable once CppExpressionWithoutSideEffects
         mesh->vertex_buffer(_vertex_buffer)
@@ -119,59 +435,193 @@ namespace wow::io::terrain {
                 .bind_ib()
                 .bind_vertex_attributes();
 
-        for (const auto &chunk: _chunks) {
-            if (chunk) {
-                chunk->on_frame(scene_info);
-            }
+        mesh->program()->vec2(glm::vec2{
+                                  static_cast<float>(_x) * utils::TILE_SIZE,
+                                  static_cast<float>(_y) * utils::TILE_SIZE
+                              }, _origin_uniform);
+        _chunk_buffer->bind_base(0);
+        _indirect_buffer->set_data(_draw_commands);
+        gl::render_stats::buffer_bind(4);
+
+        for (auto i = 0u; i < ADT_TEXTURE_ARRAY_SLOTS; ++i) {
+            mesh->texture(_array_uniforms[i], _texture_arrays[i < _texture_arrays.size() ? i : 0]);
         }
+
+        mesh->texture(_alpha_uniform, _alpha_texture);
+
+        // ReSharper disable once CppExpressionWithoutSideEffects
+        mesh->bind_textures();
+        mesh->draw_indirect(_indirect_buffer, static_cast<GLsizei>(_draw_commands.size()));
     }
 
-    void adt_tile::async_load() {
-        read_chunks(_reader);
-        if (!_data_chunks.contains('MVER') || *reinterpret_cast<uint32_t *>(_data_chunks['MVER'].data.data()) != 0x12) {
-            SPDLOG_WARN("Cannot load ADT tile {},{} - invalid version ({})", _x, _y,
-                        *reinterpret_cast<uint32_t *>(_data_chunks['MVER'].data.data()));
-            return;
+    void adt_tile::async_load(utils::work_pool &pool) {
+        if (parse(pool)) {
+            finish_async_load();
+        }
+    }
+
+    bool adt_tile::parse(utils::work_pool &pool) {
+        const auto data = _reader->data();
+        read_chunks(data);
+
+        const auto version = find_chunk('MVER');
+        uint32_t version_number = 0;
+        if (version.size() >= sizeof(uint32_t)) {
+            memcpy(&version_number, version.data(), sizeof(uint32_t));
+        }
+
+        if (version_number != 0x12) {
+            SPDLOG_WARN("Cannot load ADT tile {},{} - invalid version ({})", _x, _y, version_number);
+            _data_chunks.clear();
+            return false;
         }
 
         if (!load_chunk_indices()) {
             SPDLOG_WARN("Cannot load ADT tile {},{} - missing/invalid MCIN chunk", _x, _y);
-            return;
+            _data_chunks.clear();
+            return false;
         }
 
         load_textures();
-        load_chunks(_wdt, _reader);
+        _alpha_data.assign(alpha_texel_count(), 0);
+        load_chunks(_wdt, data, pool);
 
         _data_chunks.clear();
+        _data_chunks.shrink_to_fit();
+        _reader.reset();
+        return true;
+    }
+
+    bool adt_tile::async_load_cached(utils::binary_reader &cached) {
+        try {
+            const auto texture_count = cached.read<uint32_t>();
+            for (auto i = 0u; i < texture_count; ++i) {
+                add_texture(cached.read_string());
+            }
+
+            _alpha_data.assign(alpha_texel_count(), 0);
+            for (auto i = 0u; i < ADT_CHUNK_COUNT; ++i) {
+                if (cached.read<uint8_t>() == 0) {
+                    continue;
+                }
+
+                const auto chunk = std::make_shared<adt_chunk>(shared_from_this(), cached);
+                auto [x, y] = chunk->index();
+                if (x >= 16 || y >= 16) {
+                    SPDLOG_WARN("Invalid chunk index {},{} in cached ADT tile {},{}", x, y, _x, _y);
+                    continue;
+                }
+
+                _chunks[x + 16 * y] = chunk;
+            }
+
+            if (cached.read<uint32_t>() != ADT_ALPHA_TEXTURE_SIZE * ADT_ALPHA_TEXTURE_SIZE) {
+                throw std::runtime_error("alpha texture size mismatch");
+            }
+
+            cached.read(_alpha_data.data(), ADT_ALPHA_TEXTURE_SIZE * ADT_ALPHA_TEXTURE_SIZE * sizeof(uint32_t));
+        } catch (const std::exception &e) {
+            SPDLOG_WARN("Ignoring invalid cached ADT tile {},{}: {}", _x, _y, e.what());
+            _texture_names.clear();
+            _texture_map.clear();
+            _texture_slots.clear();
+            _texture_pages.clear();
+            for (auto &layers: _chunk_state.layers) {
+                layers.fill(-1);
+            }
+            for (auto &textures: _chunk_textures) {
+                textures.fill(-1);
+            }
+            _chunks.fill(nullptr);
+            _alpha_data.clear();
+            return false;
+        }
+
+        finish_async_load();
+        return true;
+    }
+
+    std::vector<uint8_t> adt_tile::serialize() const {
+        utils::binary_writer writer{};
+        writer.write(static_cast<uint32_t>(_texture_names.size()));
+        for (const auto &texture_name: _texture_names) {
+            writer.write_string(texture_name);
+        }
 
+        for (const auto &chunk: _chunks) {
+            writer.write(static_cast<uint8_t>(chunk ? 1 : 0));
+            if (chunk) {
+                chunk->save(writer);
+            }
+        }
+
+        writer.write(ADT_ALPHA_TEXTURE_SIZE * ADT_ALPHA_TEXTURE_SIZE);
+        writer.write(_alpha_data.data(), ADT_ALPHA_TEXTURE_SIZE * ADT_ALPHA_TEXTURE_SIZE * sizeof(uint32_t));
+
+        return writer.data();
+    }
+
+    void adt_tile::finish_async_load() {
         constexpr auto flt_max = std::numeric_limits<float>::max();
         constexpr auto flt_min = -flt_max;
         _bounds.min() = glm::vec3{flt_max, flt_max, flt_max};
         _bounds.max() = glm::vec3{flt_min, flt_min, flt_min};
 
-        for (const auto &chunk: _chunks) {
+        _chunk_bounds.clear();
+        _chunk_slots.clear();
+        _chunk_bounds.reserve(ADT_CHUNK_COUNT);
+        _chunk_slots.reserve(ADT_CHUNK_COUNT);
+
+        for (auto i = 0u; i < _chunks.size(); ++i) {
+            const auto &chunk = _chunks[i];
+            if (!chunk) {
+                continue;
+            }
+
             auto b = chunk->bounds();
             _bounds.take_min(b.min()).take_max(b.max());
+            if (chunk->is_async_loaded()) {
+                _chunk_bounds.push_back(b);
+                _chunk_slots.push_back(i);
+            }
         }
 
         if (_bounds.max().z - _bounds.min().z < 5) {
             _bounds.max().z = _bounds.min().z + 5;
         }
 
+        build_alpha_mipmaps();
+        stage_vectors();
+        stage_alpha();
+
+        _cpu_memory_usage = sizeof(adt_tile) + _texture_map.capacity() * sizeof(scene::terrain_texture_ptr) +
+                            _alpha_data.capacity() * sizeof(uint32_t);
+        _gpu_memory_usage = sizeof(_vectors) + sizeof(_chunk_state) + alpha_texel_count() * sizeof(uint32_t);
+        for (const auto &chunk: _chunks) {
+            if (chunk) {
+                _cpu_memory_usage += chunk->cpu_memory_usage();
+            }
+        }
+
+        _last_visible = std::chrono::steady_clock::now().time_since_epoch().count();
         _async_load_successful = true;
     }
 
     void adt_tile::async_unload() {
         _async_unloaded = true;
+    }
+
+    void adt_tile::release_textures() {
+        _texture_arrays.clear();
         _texture_map.clear();
     }
 
-    gl::texture_ptr adt_tile::find_texture(int32_t index) {
-        if (index < 0 || index >= _texture_map.size()) {
+    int32_t adt_tile::find_texture(const int32_t index) const {
+        if (index < 0 || static_cast<size_t>(index) >= _texture_slots.size()) {
             SPDLOG_INFO("Invalid texture index {}", index);
-            return nullptr;
+            return -1;
         }
 
-        return _texture_map[index];
+        return _texture_slots[index];
     }
 }
@@ -1,28 +1,34 @@
 #ifndef WOW_UNIX_ADT_TILE_H
 #define WOW_UNIX_ADT_TILE_H
 
-#include <map>
+#include <chrono>
 #include <memory>
+#include <span>
 
 #include "adt_chunk.h"
 #include "wdt_file.h"
-#include "gl/uniform_buffer.hpp"
+#include "gl/indirect_buffer.h"
+#include "gl/storage_buffer.h"
+#include "gl/upload_ring.h"
 #include "scene/scene_info.h"
-#include "scene/texture_manager.h"
+#include "scene/terrain_texture_atlas.h"
 #include "utils/io.h"
 #include "utils/math.h"
+#include "utils/work_pool.h"
 
 namespace wow::io::terrain {
     inline constexpr uint32_t ADT_CHUNK_COUNT = 256;
     inline constexpr uint32_t ADT_CHUNK_VECTOR_COUNT = 145;
+    inline constexpr uint32_t ADT_TEXTURE_ARRAY_SLOTS = 8;
+    inline constexpr uint32_t ADT_ALPHA_TEXTURE_SIZE = 1024;
+    inline constexpr uint32_t ADT_ALPHA_TEXTURE_LEVELS = 11;
 
     class adt_tile : public std::enable_shared_from_this<adt_tile> {
         friend class adt_chunk;
 
         struct data_chunk {
             uint32_t signature;
-            uint32_t size;
-            std::vector<uint8_t> data;
+            std::span<const uint8_t> data;
         };
 
 #pragma pack(push, 1)
@@ -33,11 +39,16 @@ namespace wow::io::terrain {
             uint32_t padding;
         };
 
-        struct adt_uniform_state {
-            int8_t textures[256][4]{};
-        };
 #pragma pack(pop)
 
+        struct adt_chunk_state {
+            std::array<std::array<int32_t, 4>, ADT_CHUNK_COUNT> layers{};
+        };
+
+        static std::array<int32_t, ADT_TEXTURE_ARRAY_SLOTS> _array_uniforms;
+        static int32_t _alpha_uniform;
+        static int32_t _origin_uniform;
+
         uint32_t _x{};
         uint32_t _y{};
 
@@ -45,35 +56,80 @@ namespace wow::io::terrain {
         wdt_file_ptr _wdt{};
 
         utils::bounding_box _bounds{};
+        utils::bounding_box_set _chunk_bounds{};
+        std::vector<uint32_t> _chunk_slots{};
+        std::vector<uint32_t> _visible_chunks{};
 
         std::atomic_bool _async_load_successful = false;
+        std::atomic<std::chrono::steady_clock::rep> _last_visible{};
+        std::atomic_size_t _cpu_memory_usage = 0;
+        size_t _gpu_memory_usage = 0;
         std::atomic_bool _async_unloaded = false;
-        std::map<uint32_t, data_chunk> _data_chunks{};
+        std::vector<data_chunk> _data_chunks{};
 
         bool _sync_loaded = false;
 
-        scene::texture_manager_ptr _texture_manager;
+        scene::terrain_texture_atlas_ptr _texture_atlas;
 
-        std::vector<gl::texture_ptr> _texture_map{};
+        std::vector<std::string> _texture_names{};
+        std::vector<scene::terrain_texture_ptr> _texture_map{};
+        bool _textures_resident = false;
+        std::vector<int32_t> _texture_slots{};
+        std::vector<uint32_t> _texture_pages{};
+        std::vector<gl::texture_array_ptr> _texture_arrays{};
 
         std::array<chunk_info, 256> _chunk_indices{};
 
         std::array<adt_chunk_ptr, 256> _chunks{};
 
-        std::array<adt_vector, ADT_CHUNK_COUNT * ADT_CHUNK_VECTOR_COUNT> _vectors{};
+        std::array<adt_packed_vector, ADT_CHUNK_COUNT * ADT_CHUNK_VECTOR_COUNT> _vectors{};
         gl::vertex_buffer_ptr _vertex_buffer{};
-        gl::uniform_buffer_ptr _uniform_buffer{};
+        bool _vectors_staged = false;
+        gl::storage_buffer_ptr _chunk_buffer{};
+        adt_chunk_state _chunk_state{};
+        std::array<std::array<int32_t, 4>, ADT_CHUNK_COUNT> _chunk_textures{};
+        std::vector<float> _texture_footprints{};
+
+        gl::indirect_buffer_ptr _indirect_buffer{};
+        std::vector<gl::draw_elements_indirect_command> _draw_commands{};
+
+        std::vector<uint32_t> _alpha_data{};
+        gl::texture_ptr _alpha_texture{};
+        bool _alpha_staged = false;
+
+        void read_chunks(std::span<const uint8_t> data);
 
-        void read_chunks(const utils::binary_reader_ptr &reader);
+        [[nodiscard]] std::span<const uint8_t> find_chunk(uint32_t signature) const;
 
         bool load_chunk_indices();
 
         void load_textures();
 
-        void load_chunks(wdt_file_ptr wdt, const utils::binary_reader_ptr &reader);
+        void add_texture(const std::string &texture_name);
+
+        void set_chunk_layers(uint32_t index, const std::array<int32_t, 4> &layers,
+                              const std::array<int32_t, 4> &textures);
+
+        void request_textures(const glm::vec2 &camera, float pixels_per_unit);
+
+        void update_alpha(uint32_t chunk_x, uint32_t chunk_y, const std::array<uint32_t, ALPHA_MAP_TEXELS> &texels);
+
+        void build_alpha_mipmaps();
+
+        void load_chunks(const wdt_file_ptr &wdt, std::span<const uint8_t> data, utils::work_pool &pool);
+
+        void finish_async_load();
 
         void sync_load();
 
+        static gl::texture_ptr create_alpha_texture(const std::vector<uint32_t> &alpha_data);
+
+        void stage_vectors();
+
+        void stage_alpha();
+
+        void release_alpha_data();
+
         void update_vectors(const std::array<adt_vector, ADT_CHUNK_VECTOR_COUNT>& vectors, uint32_t offset);
 
     public:
@@ -82,7 +138,7 @@ namespace wow::io::terrain {
             uint32_t x,
             uint32_t y,
             utils::binary_reader_ptr reader,
-            scene::texture_manager_ptr texture_manager
+            scene::terrain_texture_atlas_ptr texture_atlas
         );
 
         ~adt_tile() {
@@ -94,10 +150,38 @@ namespace wow::io::terrain {
         void on_frame(const scene::scene_info &scene_info);
 
         // this is because shared_from_this is not available in the constructor
-        void async_load();
+        void async_load(utils::work_pool &pool);
+
+        bool parse(utils::work_pool &pool);
+
+        bool async_load_cached(utils::binary_reader &cached);
 
         void async_unload();
 
+        void release_textures();
+
+        [[nodiscard]] bool is_async_loaded() const {
+            return _async_load_successful;
+        }
+
+        [[nodiscard]] std::vector<uint8_t> serialize() const;
+
+        [[nodiscard]] std::chrono::steady_clock::time_point last_visible() const {
+            return std::chrono::steady_clock::time_point{std::chrono::steady_clock::duration{_last_visible.load()}};
+        }
+
+        [[nodiscard]] size_t cpu_memory_usage() const {
+            return _cpu_memory_usage;
+        }
+
+        [[nodiscard]] size_t gpu_memory_usage() const {
+            return _gpu_memory_usage;
+        }
+
+        [[nodiscard]] static constexpr size_t vertex_memory_usage() {
+            return sizeof(_vectors);
+        }
+
         uint32_t x() const {
             return _x;
         }
@@ -114,7 +198,7 @@ namespace wow::io::terrain {
             return _chunks[index];
         }
 
-        gl::texture_ptr find_texture(int32_t index);
+        [[nodiscard]] int32_t find_texture(int32_t index) const;
     };
 
     using adt_tile_ptr = std::shared_ptr<adt_tile>;
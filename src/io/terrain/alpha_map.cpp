@@ -0,0 +1,316 @@
+#include "alpha_map.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define WOW_UNIX_ALPHA_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+#define WOW_UNIX_TARGET_AVX2
+#else
+#define WOW_UNIX_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace wow::io::terrain {
+    namespace {
+        constexpr std::array<uint8_t, ALPHA_MAP_TEXELS> zero_plane{};
+        constexpr auto opaque_plane = [] {
+            std::array<uint8_t, ALPHA_MAP_TEXELS> plane{};
+            plane.fill(0xFF);
+            return plane;
+        }();
+
+        void pack_alpha_shadow_scalar(const std::array<const uint8_t *, 3> &alpha, const uint8_t *shadow,
+                                      uint32_t *dst) {
+            for (size_t i = 0; i < ALPHA_MAP_TEXELS; ++i) {
+                const auto shadow_mask = ((shadow[i / 8] >> (i % 8)) & 0x1) != 0 ? 0xFF000000u : 0u;
+                dst[i] = static_cast<uint32_t>(alpha[0][i]) |
+                         static_cast<uint32_t>(alpha[1][i]) << 8 |
+                         static_cast<uint32_t>(alpha[2][i]) << 16 |
+                         shadow_mask;
+            }
+        }
+
+        void expand_alpha_nibbles_scalar(const uint8_t *src, uint8_t *dst, const size_t count) {
+            for (size_t i = 0; i < count; ++i) {
+                const auto low = static_cast<uint8_t>(src[i] & 0x0F);
+                const auto high = static_cast<uint8_t>(src[i] >> 4);
+                dst[i * 2] = static_cast<uint8_t>(low * 17);
+                dst[i * 2 + 1] = static_cast<uint8_t>(high * 17);
+            }
+        }
+
+#ifdef WOW_UNIX_ALPHA_X86
+        void expand_alpha_nibbles_sse2(const uint8_t *src, uint8_t *dst, const size_t count) {
+            const auto mask = _mm_set1_epi8(0x0F);
+            size_t i = 0;
+            for (; i + 16 <= count; i += 16) {
+                const auto bytes = _mm_loadu_si128(reinterpret_cast<const __m128i *>(src + i));
+                const auto low = _mm_and_si128(bytes, mask);
+                const auto high = _mm_and_si128(_mm_srli_epi16(bytes, 4), mask);
+                auto first = _mm_unpacklo_epi8(low, high);
+                auto second = _mm_unpackhi_epi8(low, high);
+                first = _mm_or_si128(first, _mm_slli_epi16(first, 4));
+                second = _mm_or_si128(second, _mm_slli_epi16(second, 4));
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 2), first);
+                _mm_storeu_si128(reinterpret_cast<__m128i *>(dst + i * 2 + 16), second);
+            }
+
+            expand_alpha_nibbles_scalar(src + i, dst + i * 2, count - i);
+        }
+
+        __m128i expand_shadow_bits_sse2(const uint16_t bits, const __m128i selector) {
+            auto mask = _mm_cvtsi32_si128(bits);
+            mask = _mm_unpacklo_epi8(mask, mask);
+            mask = _mm_unpacklo_epi16(mask, mask);
+            mask = _mm_unpacklo_epi32(mask, mask);
+            return _mm_cmpeq_epi8(_mm_and_si128(mask, selector), selector);
+        }
+
+        void pack_alpha_shadow_sse2(const std::array<const uint8_t *, 3> &alpha, const uint8_t *shadow,
+                                    uint32_t *dst) {
+            const auto selector = _mm_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+            for (size_t i = 0; i < ALPHA_MAP_TEXELS; i += 16) {
+                const auto a0 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(alpha[0] + i));
+                const auto a1 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(alpha[1] + i));
+                const auto a2 = _mm_loadu_si128(reinterpret_cast<const __m128i *>(alpha[2] + i));
+                const auto bits = static_cast<uint16_t>(shadow[i / 8] | shadow[i / 8 + 1] << 8);
+                const auto sh = expand_shadow_bits_sse2(bits, selector);
+
+                const auto low01 = _mm_unpacklo_epi8(a0, a1);
+                const auto high01 = _mm_unpackhi_epi8(a0, a1);
+                const auto low2s = _mm_unpacklo_epi8(a2, sh);
+                const auto high2s = _mm_unpackhi_epi8(a2, sh);
+
+                const auto out = reinterpret_cast<__m128i *>(dst + i);
+                _mm_storeu_si128(out, _mm_unpacklo_epi16(low01, low2s));
+                _mm_storeu_si128(out + 1, _mm_unpackhi_epi16(low01, low2s));
+                _mm_storeu_si128(out + 2, _mm_unpacklo_epi16(high01, high2s));
+                _mm_storeu_si128(out + 3, _mm_unpackhi_epi16(high01, high2s));
+            }
+        }
+
+        WOW_UNIX_TARGET_AVX2 void expand_alpha_nibbles_avx2(const uint8_t *src, uint8_t *dst, const size_t count) {
+            const auto mask = _mm256_set1_epi8(0x0F);
+            size_t i = 0;
+            for (; i + 32 <= count; i += 32) {
+                const auto bytes = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(src + i));
+                const auto low = _mm256_and_si256(bytes, mask);
+                const auto high = _mm256_and_si256(_mm256_srli_epi16(bytes, 4), mask);
+                const auto interleaved_low = _mm256_unpacklo_epi8(low, high);
+                const auto interleaved_high = _mm256_unpackhi_epi8(low, high);
+                auto first = _mm256_permute2x128_si256(interleaved_low, interleaved_high, 0x20);
+                auto second = _mm256_permute2x128_si256(interleaved_low, interleaved_high, 0x31);
+                first = _mm256_or_si256(first, _mm256_slli_epi16(first, 4));
+                second = _mm256_or_si256(second, _mm256_slli_epi16(second, 4));
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 2), first);
+                _mm256_storeu_si256(reinterpret_cast<__m256i *>(dst + i * 2 + 32), second);
+            }
+
+            expand_alpha_nibbles_sse2(src + i, dst + i * 2, count - i);
+        }
+
+        WOW_UNIX_TARGET_AVX2 void pack_alpha_shadow_avx2(const std::array<const uint8_t *, 3> &alpha,
+                                                         const uint8_t *shadow, uint32_t *dst) {
+            const auto selector = _mm256_setr_epi8(
+                1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128,
+                1, 2, 4, 8, 16, 32, 64, -128, 1, 2, 4, 8, 16, 32, 64, -128);
+            const auto spread = _mm256_setr_epi8(
+                0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1, 1, 1, 1, 1,
+                2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3);
+
+            for (size_t i = 0; i < ALPHA_MAP_TEXELS; i += 32) {
+                const auto a0 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(alpha[0] + i));
+                const auto a1 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(alpha[1] + i));
+                const auto a2 = _mm256_loadu_si256(reinterpret_cast<const __m256i *>(alpha[2] + i));
+
+                uint32_t bits{};
+                memcpy(&bits, shadow + i / 8, sizeof(bits));
+                const auto mask = _mm256_shuffle_epi8(_mm256_set1_epi32(static_cast<int>(bits)), spread);
+                const auto sh = _mm256_cmpeq_epi8(_mm256_and_si256(mask, selector), selector);
+
+                const auto low01 = _mm256_unpacklo_epi8(a0, a1);
+                const auto high01 = _mm256_unpackhi_epi8(a0, a1);
+                const auto low2s = _mm256_unpacklo_epi8(a2, sh);
+                const auto high2s = _mm256_unpackhi_epi8(a2, sh);
+
+                const auto t0 = _mm256_unpacklo_epi16(low01, low2s);
+                const auto t1 = _mm256_unpackhi_epi16(low01, low2s);
+                const auto t2 = _mm256_unpacklo_epi16(high01, high2s);
+                const auto t3 = _mm256_unpackhi_epi16(high01, high2s);
+
+                const auto out = reinterpret_cast<__m256i *>(dst + i);
+                _mm256_storeu_si256(out, _mm256_permute2x128_si256(t0, t1, 0x20));
+                _mm256_storeu_si256(out + 1, _mm256_permute2x128_si256(t2, t3, 0x20));
+                _mm256_storeu_si256(out + 2, _mm256_permute2x128_si256(t0, t1, 0x31));
+                _mm256_storeu_si256(out + 3, _mm256_permute2x128_si256(t2, t3, 0x31));
+            }
+        }
+
+        bool cpu_has_avx2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+            int info[4]{};
+            __cpuid(info, 0);
+            if (info[0] < 7) {
+                return false;
+            }
+
+            __cpuid(info, 1);
+            const auto os_xsave = (info[2] & (1 << 27)) != 0;
+            const auto has_avx = (info[2] & (1 << 28)) != 0;
+            if (!os_xsave || !has_avx || (_xgetbv(0) & 0x6) != 0x6) {
+                return false;
+            }
+
+            __cpuidex(info, 7, 0);
+            return (info[1] & (1 << 5)) != 0;
+#else
+            return __builtin_cpu_supports("avx2");
+#endif
+        }
+#endif
+
+        alpha_kernel detect_alpha_kernel() {
+#ifdef WOW_UNIX_ALPHA_X86
+            return cpu_has_avx2() ? alpha_kernel::avx2 : alpha_kernel::sse2;
+#else
+            return alpha_kernel::scalar;
+#endif
+        }
+
+        const alpha_kernel selected_kernel = detect_alpha_kernel();
+    }
+
+    alpha_kernel active_alpha_kernel() {
+        return selected_kernel;
+    }
+
+    bool is_alpha_kernel_supported(const alpha_kernel kernel) {
+        switch (kernel) {
+#ifdef WOW_UNIX_ALPHA_X86
+            case alpha_kernel::avx2:
+                return cpu_has_avx2();
+            case alpha_kernel::sse2:
+                return true;
+#endif
+            case alpha_kernel::scalar:
+                return true;
+            default:
+                return false;
+        }
+    }
+
+    std::string_view alpha_kernel_name(const alpha_kernel kernel) {
+        switch (kernel) {
+            case alpha_kernel::avx2:
+                return "avx2";
+            case alpha_kernel::sse2:
+                return "sse2";
+            default:
+                return "scalar";
+        }
+    }
+
+    void expand_alpha_nibbles(const alpha_kernel kernel, const uint8_t *src, uint8_t *dst, const size_t count) {
+        switch (kernel) {
+#ifdef WOW_UNIX_ALPHA_X86
+            case alpha_kernel::avx2:
+                expand_alpha_nibbles_avx2(src, dst, count);
+                break;
+            case alpha_kernel::sse2:
+                expand_alpha_nibbles_sse2(src, dst, count);
+                break;
+#endif
+            default:
+                expand_alpha_nibbles_scalar(src, dst, count);
+                break;
+        }
+    }
+
+    void expand_alpha_nibbles(const uint8_t *src, uint8_t *dst, const size_t count) {
+        expand_alpha_nibbles(selected_kernel, src, dst, count);
+    }
+
+    alpha_decode_result decode_alpha_rle(const std::span<const uint8_t> data, uint8_t *alpha) {
+        size_t num_read = 0;
+        size_t offset = 0;
+        while (num_read < ALPHA_MAP_TEXELS && offset < data.size()) {
+            const auto indicator = data[offset++];
+            const auto repeat = std::min<size_t>(indicator & 0x7F, ALPHA_MAP_TEXELS - num_read);
+            if ((indicator & 0x80) != 0) {
+                if (offset >= data.size()) {
+                    break;
+                }
+
+                std::fill_n(alpha + num_read, repeat, data[offset++]);
+            } else {
+                const auto count = std::min(repeat, data.size() - offset);
+                std::copy_n(data.begin() + offset, count, alpha + num_read);
+                offset += count;
+            }
+
+            num_read += repeat;
+        }
+
+        return {offset, num_read >= ALPHA_MAP_TEXELS};
+    }
+
+    alpha_decode_result decode_alpha_4bit(const alpha_kernel kernel, const std::span<const uint8_t> data,
+                                          const bool full_alpha, uint8_t *alpha) {
+        const auto rows = full_alpha ? 64u : 63u;
+        if (data.size() < rows * 32) {
+            return {};
+        }
+
+        expand_alpha_nibbles(kernel, data.data(), alpha, rows * 32);
+
+        if (!full_alpha) {
+            for (auto row = 0u; row < 63; ++row) {
+                alpha[row * 64 + 63] = alpha[row * 64 + 62];
+            }
+
+            std::copy_n(alpha + 62 * 64, 64, alpha + 63 * 64);
+        }
+
+        return {rows * 32, true};
+    }
+
+    alpha_decode_result decode_alpha_4bit(const std::span<const uint8_t> data, const bool full_alpha,
+                                          uint8_t *alpha) {
+        return decode_alpha_4bit(selected_kernel, data, full_alpha, alpha);
+    }
+
+    const uint8_t *opaque_alpha_plane() {
+        return opaque_plane.data();
+    }
+
+    void pack_alpha_shadow(const alpha_kernel kernel, const alpha_shadow_source &source, uint32_t *dst) {
+        std::array<const uint8_t *, 3> alpha{};
+        for (size_t i = 0; i < alpha.size(); ++i) {
+            alpha[i] = source.alpha[i] ? source.alpha[i] : zero_plane.data();
+        }
+
+        const auto shadow = source.shadow ? source.shadow : zero_plane.data();
+
+        switch (kernel) {
+#ifdef WOW_UNIX_ALPHA_X86
+            case alpha_kernel::avx2:
+                pack_alpha_shadow_avx2(alpha, shadow, dst);
+                break;
+            case alpha_kernel::sse2:
+                pack_alpha_shadow_sse2(alpha, shadow, dst);
+                break;
+#endif
+            default:
+                pack_alpha_shadow_scalar(alpha, shadow, dst);
+                break;
+        }
+    }
+
+    void pack_alpha_shadow(const alpha_shadow_source &source, uint32_t *dst) {
+        pack_alpha_shadow(selected_kernel, source, dst);
+    }
+}
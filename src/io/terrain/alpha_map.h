@@ -0,0 +1,53 @@
+#ifndef WOW_UNIX_ALPHA_MAP_H
+#define WOW_UNIX_ALPHA_MAP_H
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+namespace wow::io::terrain {
+    inline constexpr size_t ALPHA_MAP_TEXELS = 64 * 64;
+
+    struct alpha_shadow_source {
+        std::array<const uint8_t *, 3> alpha{};
+        const uint8_t *shadow = nullptr;
+    };
+
+    struct alpha_decode_result {
+        size_t consumed = 0;
+        bool complete = false;
+    };
+
+    enum class alpha_kernel {
+        scalar,
+        sse2,
+        avx2
+    };
+
+    alpha_kernel active_alpha_kernel();
+
+    bool is_alpha_kernel_supported(alpha_kernel kernel);
+
+    std::string_view alpha_kernel_name(alpha_kernel kernel);
+
+    void expand_alpha_nibbles(alpha_kernel kernel, const uint8_t *src, uint8_t *dst, size_t count);
+
+    void expand_alpha_nibbles(const uint8_t *src, uint8_t *dst, size_t count);
+
+    alpha_decode_result decode_alpha_rle(std::span<const uint8_t> data, uint8_t *alpha);
+
+    alpha_decode_result decode_alpha_4bit(alpha_kernel kernel, std::span<const uint8_t> data, bool full_alpha,
+                                          uint8_t *alpha);
+
+    alpha_decode_result decode_alpha_4bit(std::span<const uint8_t> data, bool full_alpha, uint8_t *alpha);
+
+    const uint8_t *opaque_alpha_plane();
+
+    void pack_alpha_shadow(alpha_kernel kernel, const alpha_shadow_source &source, uint32_t *dst);
+
+    void pack_alpha_shadow(const alpha_shadow_source &source, uint32_t *dst);
+}
+
+#endif //WOW_UNIX_ALPHA_MAP_H
@@ -0,0 +1,122 @@
+#include "far_heightfield.h"
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+
+#include "adt_chunk.h"
+#include "spdlog/spdlog.h"
+
+namespace wow::io::terrain {
+    namespace {
+#pragma pack(push, 1)
+        struct chunk_info {
+            uint32_t offset;
+            uint32_t size;
+            uint32_t flags;
+            uint32_t padding;
+        };
+#pragma pack(pop)
+
+        std::span<const uint8_t> find_chunk_indices(const std::span<const uint8_t> data) {
+            size_t offset = 0;
+            while (offset + 8 <= data.size()) {
+                uint32_t signature{};
+                uint32_t size{};
+                memcpy(&signature, data.data() + offset, sizeof(uint32_t));
+                memcpy(&size, data.data() + offset + 4, sizeof(uint32_t));
+                offset += 8;
+
+                if (size > data.size() - offset) {
+                    break;
+                }
+
+                if (signature == 'MCIN') {
+                    return data.subspan(offset, size);
+                }
+
+                offset += size;
+            }
+
+            return {};
+        }
+
+        void fill_missing(far_heightfield &field) {
+            auto sum = 0.0f;
+            auto count = 0u;
+            for (const auto h: field.heights) {
+                if (!std::isnan(h)) {
+                    sum += h;
+                    ++count;
+                }
+            }
+
+            const auto fallback = count > 0 ? sum / static_cast<float>(count) : 0.0f;
+            for (auto &h: field.heights) {
+                if (std::isnan(h)) {
+                    h = fallback;
+                }
+            }
+        }
+    }
+
+    std::vector<uint8_t> far_heightfield::serialize() const {
+        utils::binary_writer writer{};
+        writer.write(static_cast<uint32_t>(heights.size()));
+        writer.write(heights);
+        return writer.data();
+    }
+
+    std::optional<far_heightfield> far_heightfield::load(const std::span<const uint8_t> adt) {
+        const auto indices = find_chunk_indices(adt);
+        if (indices.size() < 256 * sizeof(chunk_info)) {
+            return std::nullopt;
+        }
+
+        far_heightfield field{};
+        field.heights.fill(std::numeric_limits<float>::quiet_NaN());
+
+        for (auto i = 0u; i < 256; ++i) {
+            chunk_info info{};
+            memcpy(&info, indices.data() + i * sizeof(chunk_info), sizeof(chunk_info));
+            if (info.offset >= adt.size() || info.size > adt.size() - info.offset) {
+                continue;
+            }
+
+            try {
+                utils::binary_reader reader{adt.subspan(info.offset, info.size)};
+                const auto corners = adt_chunk::read_corner_heights(reader);
+                if (!corners) {
+                    continue;
+                }
+
+                const auto x = corners->index_x;
+                const auto y = corners->index_y;
+                field.heights[y * FAR_HEIGHTFIELD_SIZE + x] = corners->heights[0];
+                field.heights[y * FAR_HEIGHTFIELD_SIZE + x + 1] = corners->heights[1];
+                field.heights[(y + 1) * FAR_HEIGHTFIELD_SIZE + x] = corners->heights[2];
+                field.heights[(y + 1) * FAR_HEIGHTFIELD_SIZE + x + 1] = corners->heights[3];
+            } catch (const std::exception &e) {
+                SPDLOG_WARN("Skipping chunk {} for far heightfield: {}", i, e.what());
+            }
+        }
+
+        fill_missing(field);
+        return field;
+    }
+
+    std::optional<far_heightfield> far_heightfield::load_cached(utils::binary_reader &cached) {
+        try {
+            if (cached.read<uint32_t>() != FAR_HEIGHTFIELD_SIZE * FAR_HEIGHTFIELD_SIZE) {
+                return std::nullopt;
+            }
+
+            far_heightfield field{};
+            cached.read(field.heights);
+            return field;
+        } catch (const std::exception &e) {
+            SPDLOG_WARN("Ignoring invalid cached far heightfield: {}", e.what());
+            return std::nullopt;
+        }
+    }
+}
@@ -0,0 +1,30 @@
+#ifndef WOW_UNIX_FAR_HEIGHTFIELD_H
+#define WOW_UNIX_FAR_HEIGHTFIELD_H
+
+#include <array>
+#include <cstdint>
+#include <optional>
+#include <span>
+#include <vector>
+
+#include "utils/io.h"
+
+namespace wow::io::terrain {
+    inline constexpr uint32_t FAR_HEIGHTFIELD_SIZE = 17;
+
+    struct far_heightfield {
+        std::array<float, FAR_HEIGHTFIELD_SIZE * FAR_HEIGHTFIELD_SIZE> heights{};
+
+        [[nodiscard]] float height(const uint32_t x, const uint32_t y) const {
+            return heights[y * FAR_HEIGHTFIELD_SIZE + x];
+        }
+
+        [[nodiscard]] std::vector<uint8_t> serialize() const;
+
+        static std::optional<far_heightfield> load(std::span<const uint8_t> adt);
+
+        static std::optional<far_heightfield> load_cached(utils::binary_reader &cached);
+    };
+}
+
+#endif //WOW_UNIX_FAR_HEIGHTFIELD_H
@@ -0,0 +1,119 @@
+#include "terrain_lod.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "utils/constants.h"
+
+namespace wow::io::terrain {
+    namespace {
+        constexpr std::array<uint32_t, TERRAIN_LOD_COUNT> lod_steps{1, 1, 2, 4, 8};
+
+        struct grid_vertex {
+            uint32_t row;
+            uint32_t column;
+            bool inner;
+        };
+
+        uint16_t vertex_index(const grid_vertex &vertex) {
+            return static_cast<uint16_t>(vertex.row * 17 + vertex.column + (vertex.inner ? 9 : 0));
+        }
+
+        grid_vertex stitch_vertex(grid_vertex vertex, const uint32_t edges, const uint32_t coarse_step) {
+            if (vertex.inner) {
+                return vertex;
+            }
+
+            if (((edges & lod_edge_top) && vertex.row == 0) || ((edges & lod_edge_bottom) && vertex.row == 8)) {
+                vertex.column -= vertex.column % coarse_step;
+            }
+
+            if (((edges & lod_edge_left) && vertex.column == 0) || ((edges & lod_edge_right) && vertex.column == 8)) {
+                vertex.row -= vertex.row % coarse_step;
+            }
+
+            return vertex;
+        }
+
+        std::vector<std::array<grid_vertex, 3>> lod_triangles(const uint32_t lod) {
+            std::vector<std::array<grid_vertex, 3>> triangles{};
+            if (lod == 0) {
+                for (auto y = 0u; y < 8; ++y) {
+                    for (auto x = 0u; x < 8; ++x) {
+                        const grid_vertex center{y, x, true};
+                        const grid_vertex top_left{y, x, false};
+                        const grid_vertex top_right{y, x + 1, false};
+                        const grid_vertex bottom_right{y + 1, x + 1, false};
+                        const grid_vertex bottom_left{y + 1, x, false};
+                        triangles.push_back({top_left, top_right, center});
+                        triangles.push_back({top_right, bottom_right, center});
+                        triangles.push_back({bottom_right, bottom_left, center});
+                        triangles.push_back({bottom_left, top_left, center});
+                    }
+                }
+
+                return triangles;
+            }
+
+            const auto step = lod_steps[lod];
+            for (auto y = 0u; y < 8; y += step) {
+                for (auto x = 0u; x < 8; x += step) {
+                    const grid_vertex top_left{y, x, false};
+                    const grid_vertex top_right{y, x + step, false};
+                    const grid_vertex bottom_right{y + step, x + step, false};
+                    const grid_vertex bottom_left{y + step, x, false};
+                    triangles.push_back({top_left, top_right, bottom_right});
+                    triangles.push_back({bottom_right, bottom_left, top_left});
+                }
+            }
+
+            return triangles;
+        }
+    }
+
+    std::vector<uint16_t> build_terrain_lod_indices(terrain_lod_table &table) {
+        std::vector<uint16_t> indices{};
+        for (auto lod = 0u; lod < TERRAIN_LOD_COUNT; ++lod) {
+            const auto triangles = lod_triangles(lod);
+            const auto coarse_step = lod_steps[std::min(lod + 1, TERRAIN_LOD_COUNT - 1)];
+
+            for (auto edges = 0u; edges < TERRAIN_LOD_STITCH_VARIANTS; ++edges) {
+                auto &range = table[lod][edges];
+                range.first_index = static_cast<uint32_t>(indices.size());
+
+                for (const auto &triangle: triangles) {
+                    const auto a = vertex_index(stitch_vertex(triangle[0], edges, coarse_step));
+                    const auto b = vertex_index(stitch_vertex(triangle[1], edges, coarse_step));
+                    const auto c = vertex_index(stitch_vertex(triangle[2], edges, coarse_step));
+                    if (a == b || b == c || a == c) {
+                        continue;
+                    }
+
+                    indices.insert(indices.end(), {a, b, c});
+                }
+
+                range.count = static_cast<uint32_t>(indices.size()) - range.first_index;
+            }
+        }
+
+        return indices;
+    }
+
+    float terrain_lod_distance(const float pixel_error, const float viewport_height, const float projection_scale) {
+        if (pixel_error <= 0.0f || viewport_height <= 0.0f) {
+            return 0.0f;
+        }
+
+        const auto pixels_per_unit = projection_scale * viewport_height * 0.5f;
+        return std::max(TERRAIN_LOD_BASE_ERROR * pixels_per_unit / pixel_error, 2.0f * utils::CHUNK_SIZE);
+    }
+
+    uint32_t select_terrain_lod(const float distance, const float lod_distance) {
+        if (lod_distance <= 0.0f || distance < lod_distance) {
+            return 0;
+        }
+
+        const auto lod = 1 + static_cast<uint32_t>(std::floor(std::log2(distance / lod_distance)));
+        return std::min(lod, TERRAIN_LOD_COUNT - 1);
+    }
+}
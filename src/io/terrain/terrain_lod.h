@@ -0,0 +1,34 @@
+#ifndef WOW_UNIX_TERRAIN_LOD_H
+#define WOW_UNIX_TERRAIN_LOD_H
+
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace wow::io::terrain {
+    inline constexpr uint32_t TERRAIN_LOD_COUNT = 5;
+    inline constexpr uint32_t TERRAIN_LOD_STITCH_VARIANTS = 16;
+    inline constexpr float TERRAIN_LOD_BASE_ERROR = 0.5f;
+
+    enum terrain_lod_edge : uint32_t {
+        lod_edge_top = 1,
+        lod_edge_right = 2,
+        lod_edge_bottom = 4,
+        lod_edge_left = 8
+    };
+
+    struct terrain_lod_range {
+        uint32_t first_index = 0;
+        uint32_t count = 0;
+    };
+
+    using terrain_lod_table = std::array<std::array<terrain_lod_range, TERRAIN_LOD_STITCH_VARIANTS>, TERRAIN_LOD_COUNT>;
+
+    std::vector<uint16_t> build_terrain_lod_indices(terrain_lod_table &table);
+
+    float terrain_lod_distance(float pixel_error, float viewport_height, float projection_scale);
+
+    uint32_t select_terrain_lod(float distance, float lod_distance);
+}
+
+#endif //WOW_UNIX_TERRAIN_LOD_H
@@ -28,5 +28,14 @@ namespace wow::io::terrain {
         }
 
         _header = mphd->read<wdt_header>();
+
+        if (const auto it = chunks.find('MAIN'); it != chunks.end() && it->second->size() >= 64 * 64 * 8) {
+            for (auto &flags: _tile_flags) {
+                flags = it->second->read<uint32_t>();
+                it->second->seek_mod(4);
+            }
+        } else {
+            SPDLOG_WARN("WDT file missing MAIN chunk, no tile availability known");
+        }
     }
 }
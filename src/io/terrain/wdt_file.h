@@ -3,6 +3,7 @@
 
 #include "utils/io.h"
 
+#include <array>
 #include <memory>
 
 namespace wow::io::terrain {
@@ -15,13 +16,26 @@ namespace wow::io::terrain {
 
     class wdt_file {
         wdt_header _header{};
+        std::array<uint32_t, 64 * 64> _tile_flags{};
 
     public:
         explicit wdt_file(const utils::binary_reader_ptr &reader);
 
+        [[nodiscard]] uint32_t flags() const {
+            return _header.flags;
+        }
+
         bool has_large_alpha() const {
             return (_header.flags & 0x84) != 0;
         }
+
+        [[nodiscard]] bool has_tile(const uint32_t x, const uint32_t y) const {
+            if (x >= 64 || y >= 64) {
+                return false;
+            }
+
+            return (_tile_flags[y * 64 + x] & 0x1) != 0;
+        }
     };
 
     using wdt_file_ptr = std::shared_ptr<wdt_file>;
@@ -3,6 +3,7 @@
 #include "utils/di.h"
 
 #include "gl/mesh.h"
+#include "glm/common.hpp"
 #include "glm/ext/matrix_clip_space.hpp"
 #include "glm/ext/matrix_transform.hpp"
 #include "glm/gtx/string_cast.hpp"
@@ -15,12 +16,19 @@ namespace wow::scene {
             _up
         );
 
-        _projection = glm::perspectiveLH(glm::radians(45.0f), 1.0f, 0.1f, 2000.0f);
+        _projection = glm::perspectiveLH(glm::radians(45.0f), _aspect, 0.1f, _far_plane);
         _matrix_changed = true;
     }
 
     void camera::update_aspect_ratio(const float aspect) {
-        _projection = glm::perspectiveLH(glm::radians(45.0f), aspect, 0.1f, 2000.0f);
+        _aspect = aspect;
+        _projection = glm::perspectiveLH(glm::radians(45.0f), _aspect, 0.1f, _far_plane);
+        _matrix_changed = true;
+    }
+
+    void camera::update_far_plane(const float far_plane) {
+        _far_plane = far_plane;
+        _projection = glm::perspectiveLH(glm::radians(45.0f), _aspect, 0.1f, _far_plane);
         _matrix_changed = true;
     }
 
@@ -35,6 +43,7 @@ namespace wow::scene {
                                 / 1000.0f;
 
         constexpr float camera_speed = 100.0f;
+        const auto last_position = _position;
 
         if (_window->is_key_pressed(GLFW_KEY_W)) {
             _position += _forward * camera_speed * delta_time;
@@ -97,6 +106,12 @@ namespace wow::scene {
 
         _last_mouse_pos = mouse_pos;
 
+        if (delta_time > 0.0f) {
+            constexpr float velocity_smoothing = 0.2f;
+            const auto frame_velocity = (_position - last_position) / delta_time;
+            _velocity = glm::mix(_velocity, frame_velocity, velocity_smoothing);
+        }
+
         const auto result = _updated;
         if (_updated) {
             _view = glm::lookAtLH(
@@ -115,6 +130,11 @@ namespace wow::scene {
             mesh->program()->use();
             mesh->program()->mat4(_view, "view");
             mesh->program()->mat4(_projection, "projection");
+
+            const auto far_mesh = gl::mesh::far_terrain_mesh().mesh;
+            far_mesh->program()->use();
+            far_mesh->program()->mat4(_view, "view");
+            far_mesh->program()->mat4(_projection, "projection");
             _matrix_changed = false;
         }
 
@@ -125,6 +145,7 @@ namespace wow::scene {
         _last_update = std::chrono::steady_clock::now();
         _is_in_world = true;
         _position = position;
+        _velocity = {};
         _updated = true;
     }
 
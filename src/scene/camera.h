@@ -16,6 +16,7 @@ namespace wow::scene {
         glm::mat4 _projection{};
 
         glm::vec3 _position{};
+        glm::vec3 _velocity{};
         glm::vec3 _forward{1.0f, 0.0f, 0.0f};
         glm::vec3 _up{0.0f, 0.0f, 1.0f};
         glm::vec3 _right = glm::cross(_up, _forward);
@@ -28,6 +29,9 @@ namespace wow::scene {
         bool _updated = false;
         bool _matrix_changed = false;
 
+        float _aspect = 1.0f;
+        float _far_plane = 2000.0f;
+
         gl::window_ptr _window{};
 
         std::chrono::steady_clock::time_point _last_update{};
@@ -37,6 +41,8 @@ namespace wow::scene {
 
         void update_aspect_ratio(float aspect);
 
+        void update_far_plane(float far_plane);
+
         [[nodiscard]] const glm::mat4 &view() const {
             return _view;
         }
@@ -61,6 +67,10 @@ namespace wow::scene {
             return _position;
         }
 
+        [[nodiscard]] glm::vec3 velocity() const {
+            return _velocity;
+        }
+
         void update_position(const glm::vec3 &position);
     };
 
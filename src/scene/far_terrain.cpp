@@ -0,0 +1,265 @@
+#include "far_terrain.h"
+
+#include <array>
+
+#include "spdlog/spdlog.h"
+#include "utils/constants.h"
+#include "utils/di.h"
+
+namespace wow::scene {
+    namespace {
+        constexpr uint32_t sector_count = 64 / FAR_TERRAIN_SECTOR_TILES;
+        constexpr uint32_t sector_cells = FAR_TERRAIN_SECTOR_TILES * (io::terrain::FAR_HEIGHTFIELD_SIZE - 1);
+        constexpr uint32_t sector_vertices = sector_cells + 1;
+        constexpr uint32_t sector_pixels = FAR_TERRAIN_SECTOR_TILES * FAR_TERRAIN_TILE_PIXELS;
+    }
+
+    far_terrain::far_terrain(config::config_manager_ptr config_manager,
+                             io::mpq_manager_ptr mpq_manager,
+                             io::asset_cache_ptr asset_cache,
+                             io::minimap::minimap_provider_ptr minimap_provider,
+                             gpu_dispatcher_ptr dispatcher) : _config_manager(std::move(config_manager)),
+                                                              _mpq_manager(std::move(mpq_manager)),
+                                                              _asset_cache(std::move(asset_cache)),
+                                                              _minimap_provider(std::move(minimap_provider)),
+                                                              _dispatcher(std::move(dispatcher)) {
+    }
+
+    std::optional<io::terrain::far_heightfield> far_terrain::load_heightfield(const std::string &path) const {
+        const auto key = _mpq_manager->content_key(path);
+        if (key) {
+            if (const auto cached = _asset_cache->load("far-terrain", *key)) {
+                if (auto field = io::terrain::far_heightfield::load_cached(*cached)) {
+                    return field;
+                }
+            }
+        }
+
+        const auto file = _mpq_manager->open(path);
+        if (!file) {
+            return std::nullopt;
+        }
+
+        const auto reader = file->to_binary_reader();
+        auto field = io::terrain::far_heightfield::load(reader->data());
+        if (field && key && _asset_cache->is_enabled()) {
+            _asset_cache->store("far-terrain", *key, field->serialize());
+        }
+
+        return field;
+    }
+
+    void far_terrain::load_sector(const uint32_t generation, const std::string &directory,
+                                  const io::terrain::wdt_file_ptr &wdt,
+                                  const uint32_t sector_x, const uint32_t sector_y) {
+        const auto data = std::make_shared<sector_data>();
+        data->vertices.resize(sector_vertices * sector_vertices);
+        data->pixels.assign(sector_pixels * sector_pixels * 4, 0);
+
+        const auto origin_x = static_cast<float>(sector_x * FAR_TERRAIN_SECTOR_TILES) * utils::TILE_SIZE;
+        const auto origin_y = static_cast<float>(sector_y * FAR_TERRAIN_SECTOR_TILES) * utils::TILE_SIZE;
+        for (auto gy = 0u; gy < sector_vertices; ++gy) {
+            for (auto gx = 0u; gx < sector_vertices; ++gx) {
+                auto &vertex = data->vertices[gy * sector_vertices + gx];
+                vertex.position = {
+                    origin_x + static_cast<float>(gx) * utils::CHUNK_SIZE,
+                    origin_y + static_cast<float>(gy) * utils::CHUNK_SIZE,
+                    0.0f
+                };
+                vertex.tex_coord = {
+                    static_cast<float>(gx) / static_cast<float>(sector_cells),
+                    static_cast<float>(gy) / static_cast<float>(sector_cells)
+                };
+            }
+        }
+
+        auto has_bounds = false;
+        for (auto ty = 0u; ty < FAR_TERRAIN_SECTOR_TILES; ++ty) {
+            for (auto tx = 0u; tx < FAR_TERRAIN_SECTOR_TILES; ++tx) {
+                if (generation != _generation) {
+                    return;
+                }
+
+                const auto x = sector_x * FAR_TERRAIN_SECTOR_TILES + tx;
+                const auto y = sector_y * FAR_TERRAIN_SECTOR_TILES + ty;
+                if (!wdt->has_tile(x, y)) {
+                    continue;
+                }
+
+                const auto path = fmt::format(R"(World\Maps\{}\{}_{}_{}.adt)", directory, directory, x, y);
+                const auto field = load_heightfield(path);
+                if (!field) {
+                    SPDLOG_DEBUG("No far heightfield for ADT tile {},{} in {}", x, y, directory);
+                    continue;
+                }
+
+                const auto base_x = tx * (io::terrain::FAR_HEIGHTFIELD_SIZE - 1);
+                const auto base_y = ty * (io::terrain::FAR_HEIGHTFIELD_SIZE - 1);
+                for (auto j = 0u; j < io::terrain::FAR_HEIGHTFIELD_SIZE; ++j) {
+                    for (auto i = 0u; i < io::terrain::FAR_HEIGHTFIELD_SIZE; ++i) {
+                        auto &vertex = data->vertices[(base_y + j) * sector_vertices + base_x + i];
+                        vertex.position.z = field->height(i, j);
+
+                        if (!has_bounds) {
+                            data->bounds = utils::bounding_box(vertex.position, vertex.position);
+                            has_bounds = true;
+                        } else {
+                            data->bounds.take_min_max(vertex.position);
+                        }
+                    }
+                }
+
+                for (auto j = 0u; j < io::terrain::FAR_HEIGHTFIELD_SIZE - 1; ++j) {
+                    for (auto i = 0u; i < io::terrain::FAR_HEIGHTFIELD_SIZE - 1; ++i) {
+                        const auto top_left = (base_y + j) * sector_vertices + base_x + i;
+                        const auto top_right = top_left + 1;
+                        const auto bottom_left = top_left + sector_vertices;
+                        const auto bottom_right = bottom_left + 1;
+                        data->indices.insert(data->indices.end(), {
+                                                 top_left, top_right, bottom_right,
+                                                 bottom_right, bottom_left, top_left
+                                             });
+                    }
+                }
+
+                const auto image = _minimap_provider->tile_image(x, y, FAR_TERRAIN_TILE_PIXELS);
+                if (image.empty()) {
+                    continue;
+                }
+
+                for (auto row = 0u; row < FAR_TERRAIN_TILE_PIXELS; ++row) {
+                    const auto target = ((ty * FAR_TERRAIN_TILE_PIXELS + row) * sector_pixels +
+                                         tx * FAR_TERRAIN_TILE_PIXELS) * 4;
+                    std::copy_n(image.begin() + row * FAR_TERRAIN_TILE_PIXELS * 4, FAR_TERRAIN_TILE_PIXELS * 4,
+                                data->pixels.begin() + target);
+                }
+            }
+        }
+
+        if (data->indices.empty()) {
+            return;
+        }
+
+        _dispatcher->dispatch([this, generation, data] {
+            if (generation != _generation) {
+                return;
+            }
+
+            sector sector{};
+            sector.vertex_buffer = gl::make_vertex_buffer();
+            sector.vertex_buffer->set_data(data->vertices);
+            sector.index_buffer = gl::make_index_buffer(gl::index_type::uint32);
+            sector.index_buffer->set_data(data->indices);
+            sector.texture = gl::make_texture();
+            sector.texture->rgba_image(sector_pixels, sector_pixels, data->pixels.data());
+            sector.texture->filtering(GL_LINEAR_MIPMAP_LINEAR, GL_LINEAR);
+            sector.texture->wrap(GL_CLAMP_TO_EDGE, GL_CLAMP_TO_EDGE);
+            sector.index_count = data->indices.size();
+            sector.bounds = data->bounds;
+            _sectors.push_back(std::move(sector));
+        }, gpu_priority::offscreen);
+    }
+
+    void far_terrain::update_detail_mask(const tile_registry::tile_list_ptr &tiles) {
+        if (tiles == _mask_tiles) {
+            return;
+        }
+
+        _mask_tiles = tiles;
+
+        std::array<uint8_t, tile_registry::GRID_SIZE * tile_registry::GRID_SIZE> mask{};
+        for (const auto &tile: *tiles) {
+            if (tile->is_async_loaded() && tile->x() < tile_registry::GRID_SIZE && tile->y() <
+                tile_registry::GRID_SIZE) {
+                mask[tile->y() * tile_registry::GRID_SIZE + tile->x()] = 0xFF;
+            }
+        }
+
+        _detail_mask->image(tile_registry::GRID_SIZE, tile_registry::GRID_SIZE, GL_RED, mask.data());
+        _detail_mask->filtering(GL_NEAREST, GL_NEAREST);
+    }
+
+    void far_terrain::load(const uint32_t map_id, const std::string &directory,
+                           const io::terrain::wdt_file_ptr &wdt) {
+        if (!is_enabled() || !wdt) {
+            return;
+        }
+
+        const auto generation = ++_generation;
+        _minimap_provider->switch_to_map(map_id);
+
+        for (auto sector_y = 0u; sector_y < sector_count; ++sector_y) {
+            for (auto sector_x = 0u; sector_x < sector_count; ++sector_x) {
+                auto has_tiles = false;
+                for (auto ty = 0u; ty < FAR_TERRAIN_SECTOR_TILES && !has_tiles; ++ty) {
+                    for (auto tx = 0u; tx < FAR_TERRAIN_SECTOR_TILES && !has_tiles; ++tx) {
+                        has_tiles = wdt->has_tile(sector_x * FAR_TERRAIN_SECTOR_TILES + tx,
+                                                  sector_y * FAR_TERRAIN_SECTOR_TILES + ty);
+                    }
+                }
+
+                if (!has_tiles) {
+                    continue;
+                }
+
+                // ReSharper disable once CppExpressionWithoutSideEffects
+                _loader_pool.submit([this, generation, directory, wdt, sector_x, sector_y] {
+                    try {
+                        load_sector(generation, directory, wdt, sector_x, sector_y);
+                    } catch (const std::exception &e) {
+                        SPDLOG_WARN("Failed to build far terrain sector {},{}: {}", sector_x, sector_y, e.what());
+                    }
+                });
+            }
+        }
+    }
+
+    void far_terrain::clear() {
+        ++_generation;
+        _dispatcher->dispatch([this] {
+            _sectors.clear();
+        }, gpu_priority::offscreen);
+    }
+
+    void far_terrain::on_frame(const scene_info &scene_info, const tile_registry::tile_list_ptr &tiles) {
+        if (_sectors.empty()) {
+            return;
+        }
+
+        const auto &far_mesh = gl::mesh::far_terrain_mesh();
+        const auto &mesh = far_mesh.mesh;
+        if (!_detail_mask) {
+            _detail_mask = gl::make_texture();
+            _detail_mask_uniform = mesh->program()->uniform_location("detail_mask");
+            _minimap_uniform = mesh->program()->uniform_location("minimap_texture");
+        }
+
+        update_detail_mask(tiles);
+
+        mesh->program()->use();
+        mesh->program()->vec4(glm::vec4(scene_info.camera_position, scene_info.view_distance),
+                              far_mesh.state.camera_position);
+        mesh->texture(_detail_mask_uniform, _detail_mask);
+
+        const auto &frustum = utils::app_module->camera()->view_frustum();
+        const auto distance = view_distance();
+
+        glEnable(GL_POLYGON_OFFSET_FILL);
+        glPolygonOffset(1.0f, 1.0f);
+
+        for (const auto &sector: _sectors) {
+            if (!sector.bounds.intersects_sphere(scene_info.camera_position, distance) ||
+                !frustum.intersects_aabb(sector.bounds)) {
+                continue;
+            }
+
+            mesh->vertex_buffer(sector.vertex_buffer)
+                    .index_buffer(sector.index_buffer)
+                    .set_index_count(sector.index_count)
+                    .texture(_minimap_uniform, sector.texture);
+            mesh->draw();
+        }
+
+        glDisable(GL_POLYGON_OFFSET_FILL);
+    }
+}
@@ -0,0 +1,100 @@
+#ifndef WOW_UNIX_FAR_TERRAIN_H
+#define WOW_UNIX_FAR_TERRAIN_H
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "gpu_dispatcher.h"
+#include "scene_info.h"
+#include "tile_registry.h"
+#include "config/config_manager.h"
+#include "gl/mesh.h"
+#include "io/asset_cache.h"
+#include "io/minimap/minimap_provider.h"
+#include "io/mpq_manager.h"
+#include "io/terrain/far_heightfield.h"
+#include "io/terrain/wdt_file.h"
+#include "utils/math.h"
+#include "utils/work_pool.h"
+
+namespace wow::scene {
+    inline constexpr uint32_t FAR_TERRAIN_SECTOR_TILES = 16;
+    inline constexpr uint32_t FAR_TERRAIN_TILE_PIXELS = 32;
+
+    class far_terrain {
+#pragma pack(push, 1)
+        struct far_vertex {
+            glm::vec3 position{};
+            glm::vec2 tex_coord{};
+        };
+#pragma pack(pop)
+
+        struct sector_data {
+            std::vector<far_vertex> vertices{};
+            std::vector<uint32_t> indices{};
+            std::vector<uint8_t> pixels{};
+            utils::bounding_box bounds{};
+        };
+
+        struct sector {
+            gl::vertex_buffer_ptr vertex_buffer{};
+            gl::index_buffer_ptr index_buffer{};
+            gl::texture_ptr texture{};
+            size_t index_count = 0;
+            utils::bounding_box bounds{};
+        };
+
+        config::config_manager_ptr _config_manager{};
+        io::mpq_manager_ptr _mpq_manager{};
+        io::asset_cache_ptr _asset_cache{};
+        io::minimap::minimap_provider_ptr _minimap_provider{};
+        gpu_dispatcher_ptr _dispatcher{};
+
+        utils::work_pool _loader_pool{};
+        std::atomic_uint32_t _generation = 0;
+
+        std::vector<sector> _sectors{};
+        gl::texture_ptr _detail_mask{};
+        tile_registry::tile_list_ptr _mask_tiles{};
+
+        int32_t _detail_mask_uniform = -1;
+        int32_t _minimap_uniform = -1;
+
+        std::optional<io::terrain::far_heightfield> load_heightfield(const std::string &path) const;
+
+        void load_sector(uint32_t generation, const std::string &directory, const io::terrain::wdt_file_ptr &wdt,
+                         uint32_t sector_x, uint32_t sector_y);
+
+        void update_detail_mask(const tile_registry::tile_list_ptr &tiles);
+
+    public:
+        far_terrain(
+            config::config_manager_ptr config_manager,
+            io::mpq_manager_ptr mpq_manager,
+            io::asset_cache_ptr asset_cache,
+            io::minimap::minimap_provider_ptr minimap_provider,
+            gpu_dispatcher_ptr dispatcher
+        );
+
+        [[nodiscard]] bool is_enabled() const {
+            return view_distance() > 0.0f;
+        }
+
+        [[nodiscard]] float view_distance() const {
+            return static_cast<float>(_config_manager->map().far_view_distance);
+        }
+
+        void load(uint32_t map_id, const std::string &directory, const io::terrain::wdt_file_ptr &wdt);
+
+        void clear();
+
+        void on_frame(const scene_info &scene_info, const tile_registry::tile_list_ptr &tiles);
+    };
+
+    using far_terrain_ptr = std::shared_ptr<far_terrain>;
+}
+
+#endif //WOW_UNIX_FAR_TERRAIN_H
@@ -1,5 +1,11 @@
 #include "frustum.h"
 #include <algorithm>
+#include <bit>
+
+#if defined(__x86_64__) || defined(_M_X64)
+#define WOW_UNIX_FRUSTUM_SSE 1
+#include <immintrin.h>
+#endif
 
 #include "glm/gtc/type_ptr.hpp"
 
@@ -52,4 +58,79 @@ namespace wow::scene {
             return plane.distance_to_point(point) >= 0;
         });
     }
+
+    containment frustum::classify_aabb(const utils::bounding_box &box) const {
+        auto result = containment::inside;
+        for (const auto &plane: _planes) {
+            if (!intersects(plane, box.min(), box.max())) {
+                return containment::outside;
+            }
+
+            if (intersects(plane.flipped(), box.min(), box.max())) {
+                result = containment::intersects;
+            }
+        }
+
+        return result;
+    }
+
+    void frustum::cull(const utils::bounding_box_set &boxes, const glm::vec3 &center, const float radius,
+                       std::vector<uint32_t> &visible) const {
+        visible.clear();
+
+        const auto count = boxes.size();
+        size_t i = 0;
+
+#ifdef WOW_UNIX_FRUSTUM_SSE
+        const auto zero = _mm_setzero_ps();
+        const auto radius_squared = _mm_set1_ps(radius * radius);
+        const auto center_x = _mm_set1_ps(center.x);
+        const auto center_y = _mm_set1_ps(center.y);
+        const auto center_z = _mm_set1_ps(center.z);
+
+        for (; i + 4 <= count; i += 4) {
+            const auto min_x = _mm_loadu_ps(boxes.min_x() + i);
+            const auto min_y = _mm_loadu_ps(boxes.min_y() + i);
+            const auto min_z = _mm_loadu_ps(boxes.min_z() + i);
+            const auto max_x = _mm_loadu_ps(boxes.max_x() + i);
+            const auto max_y = _mm_loadu_ps(boxes.max_y() + i);
+            const auto max_z = _mm_loadu_ps(boxes.max_z() + i);
+
+            const auto dx = _mm_max_ps(_mm_max_ps(_mm_sub_ps(min_x, center_x), _mm_sub_ps(center_x, max_x)), zero);
+            const auto dy = _mm_max_ps(_mm_max_ps(_mm_sub_ps(min_y, center_y), _mm_sub_ps(center_y, max_y)), zero);
+            const auto dz = _mm_max_ps(_mm_max_ps(_mm_sub_ps(min_z, center_z), _mm_sub_ps(center_z, max_z)), zero);
+            const auto distance = _mm_add_ps(_mm_add_ps(_mm_mul_ps(dx, dx), _mm_mul_ps(dy, dy)), _mm_mul_ps(dz, dz));
+
+            auto mask = _mm_cmple_ps(distance, radius_squared);
+            for (const auto &plane: _planes) {
+                if (_mm_movemask_ps(mask) == 0) {
+                    break;
+                }
+
+                const auto &normal = plane.normal();
+                const auto x = normal.x > 0 ? max_x : min_x;
+                const auto y = normal.y > 0 ? max_y : min_y;
+                const auto z = normal.z > 0 ? max_z : min_z;
+
+                const auto dp = _mm_add_ps(_mm_add_ps(_mm_mul_ps(_mm_set1_ps(normal.x), x),
+                                                      _mm_mul_ps(_mm_set1_ps(normal.y), y)),
+                                           _mm_mul_ps(_mm_set1_ps(normal.z), z));
+                mask = _mm_and_ps(mask, _mm_cmpge_ps(dp, _mm_set1_ps(-plane.distance())));
+            }
+
+            auto bits = static_cast<uint32_t>(_mm_movemask_ps(mask));
+            while (bits != 0) {
+                visible.push_back(static_cast<uint32_t>(i) + std::countr_zero(bits));
+                bits &= bits - 1;
+            }
+        }
+#endif
+
+        for (; i < count; ++i) {
+            const auto box = boxes.at(i);
+            if (box.intersects_sphere(center, radius) && intersects_aabb(box)) {
+                visible.push_back(static_cast<uint32_t>(i));
+            }
+        }
+    }
 }
@@ -7,6 +7,12 @@
 #include "utils/math.h"
 
 namespace wow::scene {
+    enum class containment {
+        outside,
+        intersects,
+        inside
+    };
+
     class frustum {
         utils::plane _planes[6];
 
@@ -28,6 +34,11 @@ namespace wow::scene {
         }
 
         [[nodiscard]] bool contains_point(const glm::vec3 &point) const;
+
+        [[nodiscard]] containment classify_aabb(const utils::bounding_box &box) const;
+
+        void cull(const utils::bounding_box_set &boxes, const glm::vec3 &center, float radius,
+                  std::vector<uint32_t> &visible) const;
     };
 }
 
@@ -1,42 +1,101 @@
 #include "gpu_dispatcher.h"
 
+#include <algorithm>
+
 namespace wow::scene {
-    void gpu_dispatcher::dispatch(work_item_t item) {
-        std::lock_guard lock{_work_lock};
-        _work_queue.push(std::move(item));
-        _has_work.store(true, std::memory_order::release);
+    gpu_dispatcher::task_ring::task_ring() {
+        for (auto i = 0u; i < slots.size(); ++i) {
+            slots[i].sequence.store(i, std::memory_order::relaxed);
+        }
     }
 
-    void gpu_dispatcher::process_one_frame() {
-        const auto start_time = std::chrono::steady_clock::now();
-        int32_t work_count = 0;
-        while (_has_work.load(std::memory_order::acquire)) {
-            work_item_t item{};
-            {
-                std::lock_guard lock{_work_lock};
-                if (!_work_queue.empty()) {
-                    item = std::move(_work_queue.front());
-                    _work_queue.pop();
-                }
+    void gpu_dispatcher::push_overflow(task_ring &ring, work_item_t item) {
+        std::lock_guard lock{ring.overflow_lock};
+        ring.overflow.push_back(std::move(item));
+        ring.overflowing.store(true, std::memory_order::release);
+        ring.depth.fetch_add(1, std::memory_order::relaxed);
+        ring.stalls.fetch_add(1, std::memory_order::relaxed);
+    }
 
-                if (_work_queue.empty()) {
-                    _has_work.store(false, std::memory_order_release);
-                }
+    bool gpu_dispatcher::run_one(task_ring &ring) {
+        const auto position = ring.dequeue_position;
+        auto &slot = ring.slots[position & (GPU_DISPATCH_RING_SIZE - 1)];
+        if (slot.sequence.load(std::memory_order::acquire) == position + 1) {
+            ring.dequeue_position = position + 1;
+            ring.depth.fetch_sub(1, std::memory_order::relaxed);
+            slot.run(slot.storage);
+            slot.sequence.store(position + GPU_DISPATCH_RING_SIZE, std::memory_order::release);
+            return true;
+        }
+
+        if (!ring.overflowing.load(std::memory_order::acquire) ||
+            ring.enqueue_position.load(std::memory_order::acquire) != position) {
+            return false;
+        }
+
+        work_item_t item{};
+        {
+            std::lock_guard lock{ring.overflow_lock};
+            if (!ring.overflow.empty()) {
+                item = std::move(ring.overflow.front());
+                ring.overflow.pop_front();
             }
 
-            if (item) {
-                item();
-                ++work_count;
+            if (ring.overflow.empty()) {
+                ring.overflowing.store(false, std::memory_order::release);
             }
+        }
+
+        if (!item) {
+            return false;
+        }
 
-            if (work_count > 25) {
-                return;
+        ring.depth.fetch_sub(1, std::memory_order::relaxed);
+        item();
+        return true;
+    }
+
+    void gpu_dispatcher::update_budget(const std::chrono::steady_clock::duration headroom) {
+        const auto headroom_ms = std::chrono::duration<float, std::milli>(headroom).count();
+        _available_ms = _available_ms * 0.9f + (_frame_time_ms.load(std::memory_order::relaxed) + headroom_ms) * 0.1f;
+        _budget_ms = std::clamp(_available_ms * 0.75f, GPU_DISPATCH_MIN_BUDGET_MS, GPU_DISPATCH_MAX_BUDGET_MS);
+        _published_budget_ms.store(_budget_ms, std::memory_order::relaxed);
+    }
+
+    void gpu_dispatcher::process_one_frame(const std::chrono::steady_clock::duration headroom) {
+        update_budget(headroom);
+
+        const auto start_time = std::chrono::steady_clock::now();
+        const auto budget = std::chrono::duration<float, std::milli>(_budget_ms);
+
+        while (true) {
+            auto processed = false;
+            for (auto &ring: _rings) {
+                if (run_one(ring)) {
+                    processed = true;
+                    break;
+                }
             }
 
-            if (const auto current_time = std::chrono::steady_clock::now();
-                std::chrono::duration_cast<std::chrono::milliseconds>(current_time - start_time).count() > 10) {
-                return;
+            if (!processed || std::chrono::steady_clock::now() - start_time >= budget) {
+                break;
             }
         }
+
+        _frame_time_ms.store(
+            std::chrono::duration<float, std::milli>(std::chrono::steady_clock::now() - start_time).count(),
+            std::memory_order::relaxed);
+    }
+
+    gpu_dispatch_stats gpu_dispatcher::stats() const {
+        gpu_dispatch_stats stats{};
+        for (auto i = 0u; i < GPU_PRIORITY_CLASSES; ++i) {
+            stats.queue_depth[i] = _rings[i].depth.load(std::memory_order::relaxed);
+            stats.stalls[i] = _rings[i].stalls.load(std::memory_order::relaxed);
+        }
+
+        stats.budget_ms = _published_budget_ms.load(std::memory_order::relaxed);
+        stats.frame_time_ms = _frame_time_ms.load(std::memory_order::relaxed);
+        return stats;
     }
 }
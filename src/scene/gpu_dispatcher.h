@@ -1,29 +1,177 @@
 #ifndef WOW_UNIX_GPU_DISPATCHER_H
 #define WOW_UNIX_GPU_DISPATCHER_H
 
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <deque>
 #include <functional>
 #include <memory>
 #include <mutex>
-#include <queue>
+#include <new>
+#include <type_traits>
+
+#include "gl/upload_context.h"
 
 namespace wow::scene {
+    enum class gpu_priority : uint32_t {
+        visible = 0,
+        offscreen = 1,
+        release = 2
+    };
+
+    inline constexpr uint32_t GPU_PRIORITY_CLASSES = 3;
+    inline constexpr size_t GPU_DISPATCH_RING_SIZE = 512;
+    inline constexpr size_t GPU_TASK_STORAGE = 128;
+    inline constexpr float GPU_DISPATCH_MIN_BUDGET_MS = 1.0f;
+    inline constexpr float GPU_DISPATCH_MAX_BUDGET_MS = 12.0f;
+
+    struct gpu_dispatch_stats {
+        std::array<uint32_t, GPU_PRIORITY_CLASSES> queue_depth{};
+        std::array<uint64_t, GPU_PRIORITY_CLASSES> stalls{};
+        float budget_ms = 0.0f;
+        float frame_time_ms = 0.0f;
+    };
+
     class gpu_dispatcher {
     public:
         using work_item_t = std::function<void()>;
 
     private:
-        std::queue<work_item_t> _work_queue{};
-        std::mutex _work_lock{};
-        std::atomic_bool _has_work{false};
+        static_assert((GPU_DISPATCH_RING_SIZE & (GPU_DISPATCH_RING_SIZE - 1)) == 0);
+
+        struct task_slot {
+            std::atomic<size_t> sequence{};
+            void (*run)(void *storage) = nullptr;
+            alignas(std::max_align_t) std::byte storage[GPU_TASK_STORAGE]{};
+        };
+
+        struct task_ring {
+            std::array<task_slot, GPU_DISPATCH_RING_SIZE> slots{};
+            alignas(64) std::atomic<size_t> enqueue_position{0};
+            alignas(64) size_t dequeue_position = 0;
+
+            std::atomic<uint32_t> depth{0};
+            std::atomic<uint64_t> stalls{0};
+
+            std::atomic_bool overflowing{false};
+            std::mutex overflow_lock{};
+            std::deque<work_item_t> overflow{};
+
+            task_ring();
+        };
+
+        std::array<task_ring, GPU_PRIORITY_CLASSES> _rings{};
+
+        float _available_ms = GPU_DISPATCH_MAX_BUDGET_MS;
+        float _budget_ms = GPU_DISPATCH_MAX_BUDGET_MS;
+        std::atomic<float> _published_budget_ms{GPU_DISPATCH_MAX_BUDGET_MS};
+        std::atomic<float> _frame_time_ms{0.0f};
+
+        static void push_overflow(task_ring &ring, work_item_t item);
+
+        static bool run_one(task_ring &ring);
+
+        void update_budget(std::chrono::steady_clock::duration headroom);
 
     public:
-        void dispatch(work_item_t item);
+        template<typename F>
+        void dispatch(F &&fn, const gpu_priority priority = gpu_priority::visible) {
+            using task_t = std::decay_t<F>;
+            static_assert(sizeof(task_t) <= GPU_TASK_STORAGE && alignof(task_t) <= alignof(std::max_align_t),
+                          "GPU task captures exceed the inline task storage");
+
+            auto &ring = _rings[static_cast<uint32_t>(priority)];
+            auto position = ring.enqueue_position.load(std::memory_order::relaxed);
+            while (!ring.overflowing.load(std::memory_order::acquire)) {
+                auto &slot = ring.slots[position & (GPU_DISPATCH_RING_SIZE - 1)];
+                const auto sequence = slot.sequence.load(std::memory_order::acquire);
+                const auto diff = static_cast<std::ptrdiff_t>(sequence) - static_cast<std::ptrdiff_t>(position);
+
+                if (diff == 0) {
+                    if (ring.enqueue_position.compare_exchange_weak(position, position + 1,
+                                                                    std::memory_order::relaxed)) {
+                        new(slot.storage) task_t(std::forward<F>(fn));
+                        slot.run = [](void *storage) {
+                            const auto task = std::launder(static_cast<task_t *>(storage));
+                            struct destroy_guard {
+                                task_t *task;
+
+                                ~destroy_guard() {
+                                    task->~task_t();
+                                }
+                            } guard{task};
+
+                            (*task)();
+                        };
+
+                        ring.depth.fetch_add(1, std::memory_order::relaxed);
+                        slot.sequence.store(position + 1, std::memory_order::release);
+                        return;
+                    }
+                } else if (diff < 0) {
+                    break;
+                } else {
+                    position = ring.enqueue_position.load(std::memory_order::relaxed);
+                }
+            }
+
+            push_overflow(ring, work_item_t{std::forward<F>(fn)});
+        }
+
+        template<typename U, typename C>
+        void upload(U &&upload_fn, C &&complete_fn, const gpu_priority priority = gpu_priority::visible) {
+            using result_t = std::invoke_result_t<std::decay_t<U> &>;
+
+            auto &context = gl::upload_context::instance();
+            if (!context.is_active()) {
+                dispatch([upload_fn = std::forward<U>(upload_fn), complete_fn = std::forward<C>(complete_fn)]() mutable {
+                    if constexpr (std::is_void_v<result_t>) {
+                        upload_fn();
+                        complete_fn();
+                    } else {
+                        complete_fn(upload_fn());
+                    }
+                }, priority);
+                return;
+            }
+
+            gl::upload_context::task_t task{
+                [this, upload_fn = std::forward<U>(upload_fn), complete_fn = std::forward<C>(complete_fn),
+                    priority]() mutable {
+                    if constexpr (std::is_void_v<result_t>) {
+                        upload_fn();
+                        auto fence = std::make_shared<gl::upload_fence>();
+                        dispatch([fence = std::move(fence), complete_fn = std::move(complete_fn)]() mutable {
+                            fence->wait();
+                            complete_fn();
+                        }, priority);
+                    } else {
+                        auto result = upload_fn();
+                        auto fence = std::make_shared<gl::upload_fence>();
+                        dispatch([fence = std::move(fence), complete_fn = std::move(complete_fn),
+                                     result = std::move(result)]() mutable {
+                            fence->wait();
+                            complete_fn(std::move(result));
+                        }, priority);
+                    }
+                }
+            };
+
+            if (!context.submit(std::move(task))) {
+                dispatch([task = std::move(task)] {
+                    task();
+                }, priority);
+            }
+        }
+
+        void process_one_frame(std::chrono::steady_clock::duration headroom = {});
 
-        void process_one_frame();
+        [[nodiscard]] gpu_dispatch_stats stats() const;
     };
 
     using gpu_dispatcher_ptr = std::shared_ptr<gpu_dispatcher>;
 }
 
-#endif //WOW_UNIX_GPU_DISPATCHER_H
\ No newline at end of file
+#endif //WOW_UNIX_GPU_DISPATCHER_H
@@ -8,13 +8,41 @@
 #include <unordered_set>
 
 namespace wow::scene {
-    void map_manager::async_load_tile(uint32_t x, uint32_t y, const utils::binary_reader_ptr &data) {
-        const auto adt = std::make_shared<io::terrain::adt_tile>(_active_wdt, x, y, data, _texture_manager);
-        adt->async_load();
+    bool map_manager::async_load_tile(const uint32_t x, const uint32_t y, const std::string &path) {
+        const auto content_key = _mpq_manager->content_key(path);
+        if (!content_key) {
+            return false;
+        }
+
+        const auto key = fmt::format("{}|wdt={:08x}", *content_key, _active_wdt->flags());
+        io::terrain::adt_tile_ptr adt{};
+        if (const auto cached = _asset_cache->load("adt", key)) {
+            adt = std::make_shared<io::terrain::adt_tile>(_active_wdt, x, y, nullptr, _texture_atlas);
+            if (adt->async_load_cached(*cached)) {
+                ++_cached_tile_loads;
+            } else {
+                adt.reset();
+            }
+        }
+
+        if (!adt) {
+            const auto file = _mpq_manager->open(path);
+            if (!file) {
+                return false;
+            }
+
+            adt = std::make_shared<io::terrain::adt_tile>(_active_wdt, x, y, file->to_binary_reader(),
+                                                          _texture_atlas);
+            adt->async_load(_tile_load_pool);
+            if (adt->is_async_loaded() && _asset_cache->is_enabled()) {
+                _asset_cache->store("adt", key, adt->serialize());
+            }
+        }
 
         std::lock_guard lock(_async_load_lock);
         _async_loaded_tiles.push_back(adt);
         add_load_progress();
+        return true;
     }
 
     void map_manager::initial_load_thread(const int32_t adt_x, const int32_t adt_y) {
@@ -26,36 +54,44 @@ namespace wow::scene {
         }
 
         _active_wdt = io::terrain::make_wdt(file->to_binary_reader());
+        _far_terrain->load(static_cast<uint32_t>(_map_id), _directory, _active_wdt);
 
         const auto radius = _config_manager->map().load_radius;
         std::vector<std::shared_future<void> > futures{};
 
         _initial_load_count = 0;
+        _cached_tile_loads = 0;
         _initial_total_load = (radius * 2 + 1) * (radius * 2 + 1) * 257;
 
+        const auto load_start = std::chrono::steady_clock::now();
         for (auto ty = adt_y - radius; ty <= adt_y + radius; ++ty) {
             for (auto tx = adt_x - radius; tx <= adt_x + radius; ++tx) {
                 const auto tile = fmt::format(R"(World\Maps\{}\{}_{}_{}.adt)", _directory, _directory, tx, ty);
-                const auto adt_file = _mpq_manager->open(tile);
-                if (!adt_file) {
-                    add_load_progress(257);
-                    SPDLOG_WARN("Not loading ADT tile {},{} for map {} - file not found", tx, ty, _directory);
-                    continue;
-                }
-
-                auto reader = adt_file->to_binary_reader();
-                futures.push_back(_tile_load_pool.submit([this, tx, ty, reader] { async_load_tile(tx, ty, reader); }));
+                futures.push_back(_tile_load_pool.submit([this, tx, ty, tile] {
+                    if (!async_load_tile(tx, ty, tile)) {
+                        add_load_progress(257);
+                        SPDLOG_WARN("Not loading ADT tile {},{} for map {} - file not found", tx, ty, _directory);
+                    }
+                }));
             }
         }
 
         std::ranges::for_each(futures, [](const auto &f) { f.get(); });
+        const auto load_time = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now() - load_start);
+        SPDLOG_INFO("Parsed {} ADT tiles for map {} in {}ms ({} from asset cache)", futures.size(), _directory,
+                    load_time.count(), _cached_tile_loads.load());
         _camera->enter_world(glm::vec3{_position.x, _position.y, 200.0f});
     }
 
     void map_manager::handle_load_tick() {
         if (!_async_loaded_tiles.empty()) {
             std::lock_guard lock(_async_load_lock);
-            _loaded_tiles.insert(_loaded_tiles.end(), _async_loaded_tiles.begin(), _async_loaded_tiles.end());
+            for (const auto &tile: _async_loaded_tiles) {
+                _tile_streamer.on_tile_visible(static_cast<int32_t>(tile->x()), static_cast<int32_t>(tile->y()));
+            }
+
+            _loaded_tiles.insert({_async_loaded_tiles.begin(), _async_loaded_tiles.end()});
             _async_loaded_tiles.clear();
         }
 
@@ -79,70 +115,67 @@ namespace wow::scene {
             _light_manager->enter_world(_map_id);
         }
 
-        _light_manager->on_update(_sky_sphere);
+        _light_manager->on_update(_sky_sphere, _far_terrain->view_distance());
+    }
+
+    bool map_manager::stream_tile(const int32_t x, const int32_t y) {
+        const auto tile = fmt::format(R"(World\Maps\{}\{}_{}_{}.adt)", _directory, _directory, x, y);
+        if (!_mpq_manager->exists(tile)) {
+            SPDLOG_DEBUG("Not loading ADT tile {},{} for map {} - file not found", x, y, _directory);
+            return false;
+        }
+
+        return async_load_tile(x, y, tile);
     }
 
     void map_manager::position_update_thread() {
         auto last_update = std::chrono::steady_clock::now();
 
         while (_is_running) {
-            if (!_is_initial_load_complete || !_position_changed) {
-                std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+            if (!_is_initial_load_complete) {
+                std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                last_update = std::chrono::steady_clock::now();
                 continue;
             }
 
+            const auto position_changed = _position_changed;
             _position_changed = false;
 
-            const auto tx = static_cast<int32_t>(_position.x / utils::TILE_SIZE);
-            const auto ty = static_cast<int32_t>(_position.y / utils::TILE_SIZE);
+            const auto position = _position;
+            const auto radius = _config_manager->map().load_radius;
+            const auto tx = static_cast<int32_t>(position.x / utils::TILE_SIZE);
+            const auto ty = static_cast<int32_t>(position.y / utils::TILE_SIZE);
 
-            const auto tmp = _loaded_tiles;
+            const auto tmp = _loaded_tiles.tiles();
 
-            std::unordered_set<int32_t> wanted_indices{};
-            for (auto x = tx - _config_manager->map().load_radius; x <= tx + _config_manager->map().load_radius; ++x) {
-                for (auto y = ty - _config_manager->map().load_radius; y <= ty + _config_manager->map().load_radius; ++
-                     y) {
-                    wanted_indices.insert(y * 64 + x);
-                }
+            std::unordered_set<int32_t> resident{};
+            for (const auto &tile: *tmp) {
+                resident.insert(static_cast<int32_t>(tile->y() * 64 + tile->x()));
             }
 
-            std::list<io::terrain::adt_tile_ptr> new_tiles{};
-            for (const auto &tile: tmp) {
-                const auto dx = tx - static_cast<int32_t>(tile->x());
-                // ReSharper disable once CppTooWideScopeInitStatement
-                const auto dy = ty - static_cast<int32_t>(tile->y());
-                if (dx > _config_manager->map().load_radius || dy > _config_manager->map().load_radius) {
-                    tile->async_unload();
-                    std::lock_guard lock(_sync_load_lock);
-                    _tiles_to_unload.push_back(tile);
-                    continue;
+            {
+                std::lock_guard lock(_async_load_lock);
+                for (const auto &tile: _async_loaded_tiles) {
+                    resident.insert(static_cast<int32_t>(tile->y() * 64 + tile->x()));
                 }
-
-                wanted_indices.erase(static_cast<int32_t>(tile->y() * 64 + tile->x()));
-                std::lock_guard lock(_sync_load_lock);
-                new_tiles.push_back(tile);
             }
 
-            {
-                std::lock_guard lock(_sync_load_lock);
-                _loaded_tiles = new_tiles;
-            }
+            const auto wanted = _tile_streamer.update(position, _camera->velocity(), radius, resident);
 
-            for (const auto &index: wanted_indices) {
-                const auto x = index % 64;
-                const auto y = index / 64;
-                const auto tile = fmt::format(R"(World\Maps\{}\{}_{}_{}.adt)", _directory, _directory, x, y);
-                const auto file = _mpq_manager->open(tile);
-                if (!file) {
-                    SPDLOG_DEBUG("Not loading ADT tile {},{} for map {} - file not found", x, y, _directory);
-                    continue;
+            const auto evicted = _tile_residency.select_evictions(*tmp, tx, ty, wanted);
+            if (!evicted.empty()) {
+                for (const auto &tile: evicted) {
+                    tile->async_unload();
                 }
 
-                const auto reader = file->to_binary_reader();
-                async_load_tile(x, y, reader);
+                _loaded_tiles.remove(evicted);
+                std::lock_guard lock(_sync_load_lock);
+                _tiles_to_unload.insert(_tiles_to_unload.end(), evicted.begin(), evicted.end());
             }
 
-            update_area_id();
+            if (position_changed) {
+                update_area_id();
+            }
 
             const auto now = std::chrono::steady_clock::now();
             if (const auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(now - last_update);
@@ -150,7 +183,7 @@ namespace wow::scene {
                 std::this_thread::sleep_for(std::chrono::milliseconds(100 - elapsed.count()));
             }
 
-            last_update = now;
+            last_update = std::chrono::steady_clock::now();
         }
     }
 
@@ -192,14 +225,18 @@ namespace wow::scene {
     map_manager::map_manager(io::dbc::dbc_manager_ptr dbc_manager,
                              config::config_manager_ptr config_manager,
                              io::mpq_manager_ptr mpq_manager,
-                             texture_manager_ptr texture_manager,
+                             io::asset_cache_ptr asset_cache,
+                             terrain_texture_atlas_ptr texture_atlas,
+                             far_terrain_ptr far_terrain,
                              camera_ptr camera,
                              sky::light_manager_ptr light_manager,
                              audio::zone_music_manager_ptr zone_music_manager) : _config_manager(
             std::move(config_manager)),
         _dbc_manager(std::move(dbc_manager)),
         _mpq_manager(std::move(mpq_manager)),
-        _texture_manager(std::move(texture_manager)),
+        _asset_cache(std::move(asset_cache)),
+        _texture_atlas(std::move(texture_atlas)),
+        _far_terrain(std::move(far_terrain)),
         _camera(std::move(camera)),
         _light_manager(std::move(light_manager)),
         _zone_music_manager(std::move(zone_music_manager)) {
@@ -227,6 +264,9 @@ namespace wow::scene {
         _map_name = rec.name.text;
 
         _position = glm::vec3(position, 0.0f);
+        _tile_streamer.clear();
+        _far_terrain->clear();
+        _camera->update_far_plane(std::max(2000.0f, _far_terrain->view_distance() + utils::TILE_SIZE));
 
         const auto start_adt = static_cast<int32_t>(position.x / utils::TILE_SIZE);
         const auto end_adt = static_cast<int32_t>(position.y / utils::TILE_SIZE);
@@ -288,23 +328,34 @@ namespace wow::scene {
         glEnable(GL_CULL_FACE);
         glFrontFace(GL_CW);
 
-        std::list<io::terrain::adt_tile_ptr> to_render{};
+        std::list<io::terrain::adt_tile_ptr> unloaded{};
         {
             std::lock_guard lock(_sync_load_lock);
-            to_render.insert(to_render.end(), _loaded_tiles.begin(), _loaded_tiles.end());
-            _tiles_to_unload.clear();
+            unloaded.swap(_tiles_to_unload);
         }
 
-        for (const auto &tile: to_render) {
+        for (const auto &tile: unloaded) {
+            tile->release_textures();
+        }
+
+        unloaded.clear();
+
+        _texture_atlas->on_frame();
+
+        const auto to_render = _loaded_tiles.tiles();
+        for (const auto &tile: *to_render) {
             tile->on_frame(scene_info);
         }
 
+        _far_terrain->on_frame(scene_info, to_render);
+
         glDisable(GL_CULL_FACE);
     }
 
     void map_manager::shutdown() {
         _is_running = false;
         _load_thread.join();
+        _tile_streamer.shutdown();
 
         _async_loaded_tiles.clear();
         _loaded_tiles.clear();
@@ -365,16 +416,8 @@ namespace wow::scene {
             return nullptr;
         }
 
-        std::list<io::terrain::adt_tile_ptr> tiles{};
-        {
-            std::lock_guard lock(_sync_load_lock);
-            tiles = _loaded_tiles;
-        }
-
-        for (const auto &tile: tiles) {
-            if (tile->x() == tx && tile->y() == ty) {
-                return tile->chunk(cx + cy * 16);
-            }
+        if (const auto tile = _loaded_tiles.at(tx, ty)) {
+            return tile->chunk(cx + cy * 16);
         }
 
         return nullptr;
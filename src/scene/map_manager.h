@@ -5,13 +5,18 @@
 
 #include "camera.h"
 #include "config/config_manager.h"
+#include "far_terrain.h"
 #include "glm/vec2.hpp"
 #include "glm/vec3.hpp"
+#include "io/asset_cache.h"
 #include "io/dbc/dbc_manager.h"
 #include "io/terrain/adt_tile.h"
 #include "utils/constants.h"
 #include "utils/work_pool.h"
 #include "scene_info.h"
+#include "tile_registry.h"
+#include "tile_residency.h"
+#include "tile_streamer.h"
 #include "audio/audio_manager.hpp"
 #include "audio/zone_music_manager.hpp"
 #include "sky/light_manager.hpp"
@@ -22,7 +27,9 @@ namespace wow::scene {
         config::config_manager_ptr _config_manager{};
         io::dbc::dbc_manager_ptr _dbc_manager{};
         io::mpq_manager_ptr _mpq_manager{};
-        texture_manager_ptr _texture_manager;
+        io::asset_cache_ptr _asset_cache{};
+        terrain_texture_atlas_ptr _texture_atlas;
+        far_terrain_ptr _far_terrain;
 
         camera_ptr _camera;
         int32_t _camera_position_uniform = -1;
@@ -42,8 +49,6 @@ namespace wow::scene {
         bool _is_running = true;
         int32_t _last_area_id = -1;
 
-        utils::work_pool _tile_load_pool{};
-
         sky::sky_sphere_ptr _sky_sphere = sky::make_sky_sphere();
         sky::light_manager_ptr _light_manager{};
 
@@ -53,14 +58,23 @@ namespace wow::scene {
         std::mutex _async_load_lock{};
         std::mutex _sync_load_lock{};
         std::list<io::terrain::adt_tile_ptr> _async_loaded_tiles{};
-        std::list<io::terrain::adt_tile_ptr> _loaded_tiles{};
+        tile_registry _loaded_tiles{};
+        tile_residency _tile_residency{_config_manager};
         std::list<io::terrain::adt_tile_ptr> _tiles_to_unload{};
 
         std::atomic_int _initial_load_count = 0;
+        std::atomic_int _cached_tile_loads = 0;
         int32_t _initial_total_load = 0;
         bool _is_initial_load_complete = false;
 
-        void async_load_tile(uint32_t x, uint32_t y, const utils::binary_reader_ptr& data);
+        utils::work_pool _tile_load_pool{};
+        tile_streamer _tile_streamer{_tile_load_pool, [this](const int32_t x, const int32_t y) {
+            return stream_tile(x, y);
+        }};
+
+        bool async_load_tile(uint32_t x, uint32_t y, const std::string &path);
+
+        bool stream_tile(int32_t x, int32_t y);
 
         void initial_load_thread(int32_t adt_x, int32_t adt_y);
 
@@ -75,7 +89,9 @@ namespace wow::scene {
             io::dbc::dbc_manager_ptr dbc_manager,
             config::config_manager_ptr config_manager,
             io::mpq_manager_ptr mpq_manager,
-            texture_manager_ptr texture_manager,
+            io::asset_cache_ptr asset_cache,
+            terrain_texture_atlas_ptr texture_atlas,
+            far_terrain_ptr far_terrain,
             camera_ptr camera,
             sky::light_manager_ptr light_manager,
             audio::zone_music_manager_ptr zone_music_manager
@@ -97,6 +113,14 @@ namespace wow::scene {
 
         float height(float x, float y);
 
+        tile_streamer_stats streaming_stats() {
+            return _tile_streamer.take_stats();
+        }
+
+        [[nodiscard]] tile_residency_usage residency_usage() const {
+            return _tile_residency.usage();
+        }
+
         io::terrain::adt_chunk_ptr chunk_at(float x, float y);
 
         void initialize() const;
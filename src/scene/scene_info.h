@@ -7,6 +7,8 @@ namespace wow::scene {
     struct scene_info {
         glm::vec3 camera_position{};
         float view_distance{};
+        float lod_distance{};
+        float pixels_per_unit{};
     };
 }
 
@@ -90,7 +90,7 @@ namespace wow::scene::sky {
         _time_of_day_ms = 0;
     }
 
-    void light_manager::on_update(const sky_sphere_ptr& sky_sphere) {
+    void light_manager::on_update(const sky_sphere_ptr& sky_sphere, const float min_fog_distance) {
         if (_current_map < 0 || _map_lights.empty()) {
             return;
         }
@@ -146,6 +146,8 @@ namespace wow::scene::sky {
             fog_distance = 2.0 * utils::TILE_SIZE;
         }
 
+        fog_distance = std::max(fog_distance, min_fog_distance);
+
         sky_sphere->update_gradient(
             top_color,
             middle_color,
@@ -163,6 +165,12 @@ namespace wow::scene::sky {
                 .apply_ambient_color(ambient_color)
                 .apply_fog_distance(fog_distance)
                 .apply_sun_direction(calculate_sun_direction(day_half_minutes));
+
+        gl::mesh::far_terrain_mesh().mesh->program()->use();
+
+        gl::mesh::far_terrain_mesh()
+                .apply_fog_color(fog_color)
+                .apply_fog_distance(fog_distance);
     }
 
     void light_manager::update_position(const glm::vec3 position) {
@@ -37,7 +37,7 @@ namespace wow::scene::sky {
 
         void enter_world(int32_t map_id);
 
-        void on_update(const sky::sky_sphere_ptr& sky_sphere);
+        void on_update(const sky::sky_sphere_ptr& sky_sphere, float min_fog_distance = 0.0f);
 
         void update_position(glm::vec3 position);
 
@@ -0,0 +1,432 @@
+#include "terrain_texture_atlas.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <optional>
+
+#include "spdlog/spdlog.h"
+#include "utils/string_utils.h"
+
+namespace wow::scene {
+    terrain_texture_atlas::terrain_texture_atlas(
+        io::mpq_manager_ptr mpq_manager,
+        gpu_dispatcher_ptr dispatcher,
+        config::config_manager_ptr config_manager
+    ) : _dispatcher(std::move(dispatcher)), _mpq_manager(std::move(mpq_manager)),
+        _config_manager(std::move(config_manager)) {
+    }
+
+    uint32_t terrain_texture_atlas::allocate_layer(const page_key &key, const uint32_t tail_level, uint32_t &layer) {
+        for (auto i = 0u; i < _pages.size(); ++i) {
+            if (auto &page = _pages[i]; page.key == key && !page.free_layers.empty()) {
+                if (!page.texture) {
+                    page.storage_level = page.tail_level;
+                    page.texture = gl::make_texture_array(key.width, key.height, key.levels, TERRAIN_ARRAY_LAYERS,
+                                                          key.format, page.tail_level);
+                }
+
+                layer = page.free_layers.back();
+                page.free_layers.pop_back();
+                return i;
+            }
+        }
+
+        texture_page page{
+            key,
+            tail_level,
+            tail_level,
+            gl::make_texture_array(key.width, key.height, key.levels, TERRAIN_ARRAY_LAYERS, key.format, tail_level),
+            {}
+        };
+
+        for (auto i = TERRAIN_ARRAY_LAYERS; i > 1; --i) {
+            page.free_layers.push_back(i - 1);
+        }
+
+        SPDLOG_INFO("Creating terrain texture array {} ({}x{}, {} levels)", _pages.size(), key.width, key.height,
+                    key.levels);
+
+        layer = 0;
+        _pages.emplace_back(std::move(page));
+        _resident_levels.resize(_pages.size() * TERRAIN_ARRAY_LAYERS, 0.0f);
+        return static_cast<uint32_t>(_pages.size() - 1);
+    }
+
+    void terrain_texture_atlas::release(const terrain_texture *texture, const std::string &name) {
+        {
+            std::lock_guard lock(_lock);
+            if (const auto itr = _textures.find(name); itr != _textures.end() && itr->second.expired()) {
+                _textures.erase(itr);
+            }
+
+            auto &page = _pages[texture->page()];
+            auto &residency = page.residency[texture->layer()];
+            set_resident_level(texture->page(), texture->layer(), residency.tail_level);
+            residency.blp.reset();
+            residency.streaming = false;
+            ++residency.generation;
+
+            page.free_layers.push_back(texture->layer());
+            if (page.free_layers.size() == TERRAIN_ARRAY_LAYERS && page.texture) {
+                SPDLOG_INFO("Releasing empty terrain texture array {}", texture->page());
+                _detail_bytes -= std::min(detail_size(page, page.storage_level), _detail_bytes);
+                page.storage_level = page.tail_level;
+                _dispatcher->dispatch([array = std::move(page.texture)] {
+                }, gpu_priority::release);
+            }
+        }
+
+        delete texture;
+    }
+
+    void terrain_texture_atlas::set_resident_level(const uint32_t page, const uint32_t layer, const uint32_t level) {
+        const auto levels = _pages[page].key.levels;
+        _pages[page].residency[layer].resident_level = level;
+        _resident_levels[page * TERRAIN_ARRAY_LAYERS + layer] = static_cast<float>(levels - std::min(level, levels));
+        _residency_dirty = true;
+    }
+
+    size_t terrain_texture_atlas::detail_size(const texture_page &page, const uint32_t level) {
+        if (!page.texture || level >= page.tail_level) {
+            return 0;
+        }
+
+        return page.texture->storage_size(level) - page.texture->storage_size(page.tail_level);
+    }
+
+    bool terrain_texture_atlas::trim_page(const float priority, const uint32_t keep_page) {
+        std::optional<uint32_t> victim{};
+        uint64_t victim_frame = 0;
+        auto victim_priority = 0.0f;
+
+        for (auto i = 0u; i < _pages.size(); ++i) {
+            const auto &page = _pages[i];
+            if (i == keep_page || !page.texture || page.storage_level >= page.tail_level) {
+                continue;
+            }
+
+            uint64_t last_use = 0;
+            auto use_priority = 0.0f;
+            auto pinned = false;
+            for (const auto &residency: page.residency) {
+                if (!residency.blp) {
+                    continue;
+                }
+
+                if (residency.streaming) {
+                    pinned = true;
+                    break;
+                }
+
+                if (residency.wanted_level > page.storage_level) {
+                    continue;
+                }
+
+                if (residency.request_frame == _frame) {
+                    if (residency.priority >= priority) {
+                        pinned = true;
+                        break;
+                    }
+
+                    use_priority = std::max(use_priority, residency.priority);
+                }
+
+                last_use = std::max(last_use, residency.request_frame);
+            }
+
+            if (pinned) {
+                continue;
+            }
+
+            if (!victim || last_use < victim_frame || (last_use == victim_frame && use_priority < victim_priority)) {
+                victim = i;
+                victim_frame = last_use;
+                victim_priority = use_priority;
+            }
+        }
+
+        if (!victim) {
+            return false;
+        }
+
+        auto &page = _pages[*victim];
+        const auto level = page.storage_level + 1;
+        _detail_bytes -= std::min(detail_size(page, page.storage_level) - detail_size(page, level), _detail_bytes);
+        page.storage_level = level;
+
+        for (auto i = 0u; i < TERRAIN_ARRAY_LAYERS; ++i) {
+            if (page.residency[i].blp && page.residency[i].resident_level < level) {
+                set_resident_level(*victim, i, level);
+            }
+        }
+
+        _dispatcher->upload([array = page.texture, level] {
+            array->set_first_level(level);
+        }, [array = page.texture] {
+            array->mark_ready();
+        }, gpu_priority::offscreen);
+
+        SPDLOG_DEBUG("Trimmed terrain texture array {} to level {} ({} detail bytes)", *victim, level, _detail_bytes);
+        return true;
+    }
+
+    bool terrain_texture_atlas::is_current(const uint32_t page, const uint32_t layer, const uint32_t generation) {
+        std::lock_guard lock(_lock);
+        return _pages[page].residency[layer].generation == generation;
+    }
+
+    void terrain_texture_atlas::stream_level(const stream_job &job) {
+        try {
+            static_cast<void>(job.blp->get_layer(job.level));
+        } catch (const std::exception &e) {
+            SPDLOG_WARN("Failed to stream terrain texture level {}: {}", job.level, e.what());
+            finish_stream(job, false);
+            return;
+        }
+
+        _dispatcher->upload([this, job] {
+            return is_current(job.page, job.layer, job.generation) &&
+                   job.texture->load_blp_level(job.layer, job.blp, job.level);
+        }, [this, job](const bool loaded) {
+            job.blp->release_layer(job.level);
+            job.texture->mark_ready();
+            finish_stream(job, loaded);
+        }, gpu_priority::offscreen);
+    }
+
+    void terrain_texture_atlas::finish_stream(const stream_job &job, const bool loaded) {
+        std::lock_guard lock(_lock);
+        --_in_flight;
+
+        auto &residency = _pages[job.page].residency[job.layer];
+        if (residency.generation != job.generation) {
+            return;
+        }
+
+        residency.streaming = false;
+        if (!loaded) {
+            residency.first_level = job.level + 1;
+            return;
+        }
+
+        if (job.level < residency.resident_level && job.level >= _pages[job.page].storage_level) {
+            set_resident_level(job.page, job.layer, job.level);
+        }
+    }
+
+    void terrain_texture_atlas::finish_tail(const uint32_t page, const uint32_t layer, const uint32_t generation) {
+        std::lock_guard lock(_lock);
+        if (auto &residency = _pages[page].residency[layer];
+            residency.generation == generation && residency.resident_level > residency.tail_level) {
+            set_resident_level(page, layer, residency.tail_level);
+        }
+    }
+
+    terrain_texture_ptr terrain_texture_atlas::load(const std::string &path) {
+        const auto name = utils::to_lower(path);
+        {
+            std::lock_guard lock(_lock);
+            if (const auto itr = _textures.find(name); itr != _textures.end()) {
+                if (auto texture = itr->second.lock()) {
+                    return texture;
+                }
+            }
+        }
+
+        const auto blp = _mpq_manager->open_blp(path);
+        if (!blp) {
+            SPDLOG_WARN("Terrain texture {} not found", path);
+            return nullptr;
+        }
+
+        if (blp->format() == io::blp::blp_format::unknown || blp->layer_count() == 0) {
+            SPDLOG_WARN("Terrain texture {} has an unsupported format", path);
+            return nullptr;
+        }
+
+        const page_key key{blp->width(), blp->height(), static_cast<uint32_t>(blp->layer_count()), blp->format()};
+        const auto tail_level = std::min(blp->layer_for_dimension(TERRAIN_MIP_TAIL_SIZE), key.levels - 1);
+        for (auto i = tail_level; i < key.levels; ++i) {
+            static_cast<void>(blp->get_layer(i));
+        }
+
+        terrain_texture_ptr texture{};
+        gl::texture_array_ptr array{};
+        uint32_t page_index = 0;
+        uint32_t layer = 0;
+        uint32_t generation = 0;
+        {
+            std::lock_guard lock(_lock);
+            if (const auto itr = _textures.find(name); itr != _textures.end()) {
+                if (auto existing = itr->second.lock()) {
+                    return existing;
+                }
+            }
+
+            const auto page = allocate_layer(key, tail_level, layer);
+            array = _pages[page].texture;
+
+            auto &residency = _pages[page].residency[layer];
+            residency.blp = blp;
+            residency.first_level = 0;
+            residency.tail_level = tail_level;
+            residency.wanted_level = tail_level;
+            residency.priority = 0.0f;
+            residency.request_frame = 0;
+            residency.streaming = false;
+            generation = ++residency.generation;
+            page_index = page;
+            set_resident_level(page, layer, key.levels);
+
+            texture = std::shared_ptr<const terrain_texture>(
+                new terrain_texture(page, layer),
+                [this, name](const terrain_texture *ptr) {
+                    release(ptr, name);
+                });
+            _textures[name] = texture;
+        }
+
+        _dispatcher->upload([this, array, page_index, layer, generation, blp, tail_level] {
+            if (is_current(page_index, layer, generation)) {
+                array->load_blp(layer, blp, tail_level);
+            }
+        }, [this, array, page_index, layer, generation, blp, tail_level] {
+            array->mark_ready();
+            for (auto i = tail_level; i < blp->layer_count(); ++i) {
+                blp->release_layer(i);
+            }
+
+            finish_tail(page_index, layer, generation);
+        });
+
+        return texture;
+    }
+
+    bool terrain_texture_atlas::is_resident(const terrain_texture &texture) {
+        std::lock_guard lock(_lock);
+        const auto &residency = _pages[texture.page()].residency[texture.layer()];
+        return residency.resident_level <= residency.tail_level;
+    }
+
+    void terrain_texture_atlas::request(const terrain_texture &texture, const float footprint) {
+        if (footprint <= 0.0f) {
+            return;
+        }
+
+        std::lock_guard lock(_lock);
+        auto &page = _pages[texture.page()];
+        auto &residency = page.residency[texture.layer()];
+        if (!residency.blp) {
+            return;
+        }
+
+        const auto texels = static_cast<float>(page.key.width) * footprint;
+        const auto level = std::clamp(texels > 1.0f ? static_cast<uint32_t>(std::log2(texels)) : 0u,
+                                      residency.first_level, residency.tail_level);
+        const auto priority = 1.0f / footprint;
+
+        if (residency.request_frame != _frame) {
+            residency.request_frame = _frame;
+            residency.wanted_level = level;
+            residency.priority = priority;
+        } else {
+            residency.wanted_level = std::min(residency.wanted_level, level);
+            residency.priority = std::max(residency.priority, priority);
+        }
+    }
+
+    void terrain_texture_atlas::on_frame() {
+        std::vector<stream_job> jobs{};
+        {
+            std::lock_guard lock(_lock);
+            const auto budget = static_cast<size_t>(std::max(_config_manager->map().texture_budget_mb, 0)) * 1024 *
+                                1024;
+
+            std::vector<std::pair<float, std::pair<uint32_t, uint32_t> > > candidates{};
+            for (auto i = 0u; i < _pages.size(); ++i) {
+                for (auto j = 0u; j < TERRAIN_ARRAY_LAYERS; ++j) {
+                    if (const auto &residency = _pages[i].residency[j];
+                        residency.blp && !residency.streaming && residency.request_frame == _frame &&
+                        residency.resident_level <= residency.tail_level &&
+                        residency.wanted_level < residency.resident_level) {
+                        candidates.emplace_back(residency.priority, std::make_pair(i, j));
+                    }
+                }
+            }
+
+            std::ranges::sort(candidates, [](const auto &a, const auto &b) { return a.first > b.first; });
+
+            for (const auto &[priority, index]: candidates) {
+                if (_in_flight >= TERRAIN_STREAM_IN_FLIGHT) {
+                    break;
+                }
+
+                const auto [page_index, layer] = index;
+                auto &page = _pages[page_index];
+                auto &residency = page.residency[layer];
+                const auto level = residency.resident_level - 1;
+                const auto growth = level < page.storage_level
+                                        ? detail_size(page, level) - detail_size(page, page.storage_level)
+                                        : 0;
+
+                auto fits = _detail_bytes + growth <= budget;
+                while (!fits && trim_page(priority, page_index)) {
+                    fits = _detail_bytes + growth <= budget;
+                }
+
+                if (!fits) {
+                    continue;
+                }
+
+                if (level < page.storage_level) {
+                    page.storage_level = level;
+                    _detail_bytes += growth;
+                }
+
+                residency.streaming = true;
+                ++_in_flight;
+                jobs.push_back({page_index, layer, residency.generation, level, residency.blp, page.texture});
+            }
+
+            while (_detail_bytes > budget &&
+                   trim_page(std::numeric_limits<float>::max(), std::numeric_limits<uint32_t>::max())) {
+            }
+
+            if (_residency_dirty && !_resident_levels.empty()) {
+                if (!_residency_buffer) {
+                    _residency_buffer = gl::make_storage_buffer();
+                }
+
+                _residency_buffer->set_data(_resident_levels.data(), _resident_levels.size() * sizeof(float));
+                _residency_dirty = false;
+            }
+
+            ++_frame;
+        }
+
+        for (const auto &job: jobs) {
+            _loader_pool.submit([this, job] {
+                stream_level(job);
+            });
+        }
+
+        if (_residency_buffer) {
+            _residency_buffer->bind_base(TERRAIN_RESIDENCY_BINDING);
+        }
+    }
+
+    gl::texture_array_ptr terrain_texture_atlas::page(const uint32_t index) {
+        std::lock_guard lock(_lock);
+        if (index >= _pages.size()) {
+            return nullptr;
+        }
+
+        return _pages[index].texture;
+    }
+
+    size_t terrain_texture_atlas::page_count() {
+        std::lock_guard lock(_lock);
+        return _pages.size();
+    }
+}
@@ -0,0 +1,147 @@
+#ifndef WOW_UNIX_TERRAIN_TEXTURE_ATLAS_H
+#define WOW_UNIX_TERRAIN_TEXTURE_ATLAS_H
+
+#include <array>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "gpu_dispatcher.h"
+#include "config/config_manager.h"
+#include "gl/storage_buffer.h"
+#include "gl/texture_array.h"
+#include "io/mpq_manager.h"
+#include "utils/work_pool.h"
+
+namespace wow::scene {
+    inline constexpr uint32_t TERRAIN_ARRAY_LAYERS = 64;
+    inline constexpr uint32_t TERRAIN_MIP_TAIL_SIZE = 32;
+    inline constexpr uint32_t TERRAIN_STREAM_IN_FLIGHT = 4;
+    inline constexpr uint32_t TERRAIN_RESIDENCY_BINDING = 1;
+
+    class terrain_texture {
+        uint32_t _page;
+        uint32_t _layer;
+
+    public:
+        terrain_texture(const uint32_t page, const uint32_t layer) : _page(page), _layer(layer) {
+        }
+
+        [[nodiscard]] uint32_t page() const {
+            return _page;
+        }
+
+        [[nodiscard]] uint32_t layer() const {
+            return _layer;
+        }
+
+        [[nodiscard]] uint32_t residency_index() const {
+            return _page * TERRAIN_ARRAY_LAYERS + _layer;
+        }
+    };
+
+    using terrain_texture_ptr = std::shared_ptr<const terrain_texture>;
+
+    class terrain_texture_atlas {
+        struct page_key {
+            uint32_t width;
+            uint32_t height;
+            uint32_t levels;
+            io::blp::blp_format format;
+
+            bool operator==(const page_key &other) const = default;
+        };
+
+        struct layer_residency {
+            io::blp::blp_file_ptr blp{};
+            uint32_t generation = 0;
+            uint32_t first_level = 0;
+            uint32_t tail_level = 0;
+            uint32_t resident_level = 0;
+            uint32_t wanted_level = 0;
+            float priority = 0.0f;
+            uint64_t request_frame = 0;
+            bool streaming = false;
+        };
+
+        struct texture_page {
+            page_key key;
+            uint32_t tail_level;
+            uint32_t storage_level;
+            gl::texture_array_ptr texture;
+            std::vector<uint32_t> free_layers;
+            std::array<layer_residency, TERRAIN_ARRAY_LAYERS> residency{};
+        };
+
+        struct stream_job {
+            uint32_t page;
+            uint32_t layer;
+            uint32_t generation;
+            uint32_t level;
+            io::blp::blp_file_ptr blp;
+            gl::texture_array_ptr texture;
+        };
+
+        std::mutex _lock{};
+        std::unordered_map<std::string, std::weak_ptr<const terrain_texture> > _textures{};
+        std::vector<texture_page> _pages{};
+        gl::texture_array_ptr _empty_page = gl::make_texture_array(1, 1, 1, 1, io::blp::blp_format::rgb);
+
+        std::vector<float> _resident_levels{};
+        gl::storage_buffer_ptr _residency_buffer{};
+        bool _residency_dirty = false;
+        size_t _detail_bytes = 0;
+        uint64_t _frame = 1;
+        uint32_t _in_flight = 0;
+
+        gpu_dispatcher_ptr _dispatcher{};
+        io::mpq_manager_ptr _mpq_manager{};
+        config::config_manager_ptr _config_manager{};
+
+        utils::work_pool _loader_pool{};
+
+        uint32_t allocate_layer(const page_key &key, uint32_t tail_level, uint32_t &layer);
+
+        void release(const terrain_texture *texture, const std::string &name);
+
+        void set_resident_level(uint32_t page, uint32_t layer, uint32_t level);
+
+        [[nodiscard]] static size_t detail_size(const texture_page &page, uint32_t level);
+
+        bool trim_page(float priority, uint32_t keep_page);
+
+        bool is_current(uint32_t page, uint32_t layer, uint32_t generation);
+
+        void stream_level(const stream_job &job);
+
+        void finish_stream(const stream_job &job, bool loaded);
+
+        void finish_tail(uint32_t page, uint32_t layer, uint32_t generation);
+
+    public:
+        terrain_texture_atlas(io::mpq_manager_ptr mpq_manager, gpu_dispatcher_ptr dispatcher,
+                              config::config_manager_ptr config_manager);
+
+        terrain_texture_ptr load(const std::string &path);
+
+        void request(const terrain_texture &texture, float footprint);
+
+        [[nodiscard]] bool is_resident(const terrain_texture &texture);
+
+        void on_frame();
+
+        gl::texture_array_ptr page(uint32_t index);
+
+        [[nodiscard]] gl::texture_array_ptr empty_page() const {
+            return _empty_page;
+        }
+
+        [[nodiscard]] size_t page_count();
+    };
+
+    using terrain_texture_atlas_ptr = std::shared_ptr<terrain_texture_atlas>;
+}
+
+#endif //WOW_UNIX_TERRAIN_TEXTURE_ATLAS_H
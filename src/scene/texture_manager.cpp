@@ -12,7 +12,7 @@ namespace wow::scene {
             if (native) {
                 _dispatcher->dispatch([native] {
                     glDeleteTextures(1, &native);
-                });
+                }, gpu_priority::release);
             }
             delete texture;
         }
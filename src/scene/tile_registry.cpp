@@ -0,0 +1,60 @@
+#include "tile_registry.h"
+
+#include <algorithm>
+
+namespace wow::scene {
+    io::terrain::adt_tile_ptr tile_registry::at(const int32_t x, const int32_t y) const {
+        if (x < 0 || y < 0 || x >= GRID_SIZE || y >= GRID_SIZE) {
+            return nullptr;
+        }
+
+        return _slots[y * GRID_SIZE + x].load(std::memory_order_acquire);
+    }
+
+    void tile_registry::insert(const std::vector<io::terrain::adt_tile_ptr> &tiles) {
+        std::lock_guard lock(_write_lock);
+        auto list = std::make_shared<tile_list>(*_tiles.load(std::memory_order_acquire));
+
+        for (const auto &tile: tiles) {
+            if (tile->x() >= GRID_SIZE || tile->y() >= GRID_SIZE) {
+                continue;
+            }
+
+            const auto previous = _slots[tile->y() * GRID_SIZE + tile->x()].exchange(tile, std::memory_order_acq_rel);
+            if (previous) {
+                std::erase(*list, previous);
+            }
+
+            list->push_back(tile);
+        }
+
+        _tiles.store(std::move(list), std::memory_order_release);
+    }
+
+    void tile_registry::remove(const std::unordered_set<io::terrain::adt_tile_ptr> &tiles) {
+        std::lock_guard lock(_write_lock);
+        auto list = std::make_shared<tile_list>(*_tiles.load(std::memory_order_acquire));
+
+        for (const auto &tile: tiles) {
+            if (tile->x() >= GRID_SIZE || tile->y() >= GRID_SIZE) {
+                continue;
+            }
+
+            auto &slot = _slots[tile->y() * GRID_SIZE + tile->x()];
+            auto expected = tile;
+            slot.compare_exchange_strong(expected, nullptr, std::memory_order_acq_rel);
+        }
+
+        std::erase_if(*list, [&tiles](const auto &tile) { return tiles.contains(tile); });
+        _tiles.store(std::move(list), std::memory_order_release);
+    }
+
+    void tile_registry::clear() {
+        std::lock_guard lock(_write_lock);
+        for (auto &slot: _slots) {
+            slot.store(nullptr, std::memory_order_release);
+        }
+
+        _tiles.store(std::make_shared<const tile_list>(), std::memory_order_release);
+    }
+}
@@ -0,0 +1,42 @@
+#ifndef WOW_UNIX_TILE_REGISTRY_H
+#define WOW_UNIX_TILE_REGISTRY_H
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <mutex>
+#include <unordered_set>
+#include <vector>
+
+#include "io/terrain/adt_tile.h"
+
+namespace wow::scene {
+    class tile_registry {
+    public:
+        using tile_list = std::vector<io::terrain::adt_tile_ptr>;
+        using tile_list_ptr = std::shared_ptr<const tile_list>;
+
+        static constexpr int32_t GRID_SIZE = 64;
+
+    private:
+        std::array<std::atomic<io::terrain::adt_tile_ptr>, GRID_SIZE * GRID_SIZE> _slots{};
+        std::atomic<tile_list_ptr> _tiles{std::make_shared<const tile_list>()};
+
+        std::mutex _write_lock{};
+
+    public:
+        [[nodiscard]] io::terrain::adt_tile_ptr at(int32_t x, int32_t y) const;
+
+        [[nodiscard]] tile_list_ptr tiles() const {
+            return _tiles.load(std::memory_order_acquire);
+        }
+
+        void insert(const std::vector<io::terrain::adt_tile_ptr> &tiles);
+
+        void remove(const std::unordered_set<io::terrain::adt_tile_ptr> &tiles);
+
+        void clear();
+    };
+}
+
+#endif //WOW_UNIX_TILE_REGISTRY_H
@@ -0,0 +1,86 @@
+#include "tile_residency.h"
+
+#include <algorithm>
+#include <cstdlib>
+
+#include "spdlog/spdlog.h"
+
+namespace wow::scene {
+    tile_residency::tile_residency(config::config_manager_ptr config_manager)
+        : _config_manager(std::move(config_manager)) {
+    }
+
+    std::unordered_set<io::terrain::adt_tile_ptr> tile_residency::select_evictions(
+        const tile_registry::tile_list &tiles,
+        const int32_t tx,
+        const int32_t ty,
+        const std::unordered_set<int32_t> &wanted) {
+        const auto &config = _config_manager->map();
+        const auto radius = config.load_radius;
+        const auto keep_radius = radius + std::max(0, config.eviction_hysteresis);
+        const auto cpu_budget = static_cast<size_t>(std::max(0, config.cpu_budget_mb)) * 1024 * 1024;
+        const auto gpu_budget = static_cast<size_t>(std::max(0, config.gpu_budget_mb)) * 1024 * 1024;
+
+        struct eviction_candidate {
+            io::terrain::adt_tile_ptr tile;
+            int32_t distance;
+        };
+
+        std::unordered_set<io::terrain::adt_tile_ptr> evicted{};
+        std::vector<eviction_candidate> candidates{};
+        tile_residency_usage usage{};
+
+        for (const auto &tile: tiles) {
+            const auto distance = std::max(std::abs(tx - static_cast<int32_t>(tile->x())),
+                                           std::abs(ty - static_cast<int32_t>(tile->y())));
+            const auto is_wanted = wanted.contains(static_cast<int32_t>(tile->y() * 64 + tile->x()));
+
+            if (!is_wanted && distance > keep_radius) {
+                evicted.insert(tile);
+                continue;
+            }
+
+            ++usage.tiles;
+            usage.cpu_bytes += tile->cpu_memory_usage();
+            usage.gpu_bytes += tile->gpu_memory_usage();
+
+            if (!is_wanted && distance > radius) {
+                candidates.push_back({tile, distance});
+            }
+        }
+
+        if (usage.cpu_bytes > cpu_budget || usage.gpu_bytes > gpu_budget) {
+            std::ranges::sort(candidates, [](const eviction_candidate &a, const eviction_candidate &b) {
+                if (a.tile->last_visible() != b.tile->last_visible()) {
+                    return a.tile->last_visible() < b.tile->last_visible();
+                }
+
+                return a.distance > b.distance;
+            });
+
+            for (const auto &[tile, distance]: candidates) {
+                if (usage.cpu_bytes <= cpu_budget && usage.gpu_bytes <= gpu_budget) {
+                    break;
+                }
+
+                evicted.insert(tile);
+                --usage.tiles;
+                usage.cpu_bytes -= tile->cpu_memory_usage();
+                usage.gpu_bytes -= tile->gpu_memory_usage();
+            }
+        }
+
+        const auto is_over_budget = usage.cpu_bytes > cpu_budget || usage.gpu_bytes > gpu_budget;
+        if (is_over_budget && !_is_over_budget) {
+            SPDLOG_WARN("Terrain working set exceeds memory budget: {} MB CPU / {} MB GPU for {} tiles",
+                        usage.cpu_bytes / (1024 * 1024), usage.gpu_bytes / (1024 * 1024), usage.tiles);
+        }
+
+        _is_over_budget = is_over_budget;
+        _resident_tiles = usage.tiles;
+        _resident_cpu_bytes = usage.cpu_bytes;
+        _resident_gpu_bytes = usage.gpu_bytes;
+        _resident_vertex_bytes = usage.tiles * io::terrain::adt_tile::vertex_memory_usage();
+        return evicted;
+    }
+}
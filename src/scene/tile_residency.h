@@ -0,0 +1,44 @@
+#ifndef WOW_UNIX_TILE_RESIDENCY_H
+#define WOW_UNIX_TILE_RESIDENCY_H
+
+#include <atomic>
+#include <unordered_set>
+
+#include "config/config_manager.h"
+#include "tile_registry.h"
+
+namespace wow::scene {
+    struct tile_residency_usage {
+        size_t tiles = 0;
+        size_t cpu_bytes = 0;
+        size_t gpu_bytes = 0;
+        size_t vertex_bytes = 0;
+    };
+
+    class tile_residency {
+        config::config_manager_ptr _config_manager{};
+
+        std::atomic<size_t> _resident_tiles = 0;
+        std::atomic<size_t> _resident_cpu_bytes = 0;
+        std::atomic<size_t> _resident_gpu_bytes = 0;
+        std::atomic<size_t> _resident_vertex_bytes = 0;
+
+        bool _is_over_budget = false;
+
+    public:
+        explicit tile_residency(config::config_manager_ptr config_manager);
+
+        std::unordered_set<io::terrain::adt_tile_ptr> select_evictions(const tile_registry::tile_list &tiles,
+                                                                       int32_t tx, int32_t ty,
+                                                                       const std::unordered_set<int32_t> &wanted);
+
+        [[nodiscard]] tile_residency_usage usage() const {
+            return {
+                _resident_tiles.load(), _resident_cpu_bytes.load(), _resident_gpu_bytes.load(),
+                _resident_vertex_bytes.load()
+            };
+        }
+    };
+}
+
+#endif //WOW_UNIX_TILE_RESIDENCY_H
@@ -0,0 +1,178 @@
+#include "tile_streamer.h"
+
+#include <algorithm>
+#include <thread>
+
+#include "glm/geometric.hpp"
+#include "utils/constants.h"
+
+namespace wow::scene {
+    tile_streamer::tile_streamer(utils::work_pool &pool, load_function loader)
+        : _pool(pool),
+          _loader(std::move(loader)),
+          _max_in_flight(std::max(2u, std::thread::hardware_concurrency() / 2)) {
+    }
+
+    std::unordered_set<int32_t> tile_streamer::update(const glm::vec3 &position, const glm::vec3 &velocity,
+                                                      const int32_t radius,
+                                                      const std::unordered_set<int32_t> &resident) {
+        const glm::vec2 current{position.x, position.y};
+        glm::vec2 offset = glm::vec2{velocity.x, velocity.y} * PREFETCH_LOOKAHEAD_SECONDS;
+        if (const auto max_offset = static_cast<float>(radius) * utils::TILE_SIZE; glm::length(offset) > max_offset) {
+            offset = glm::normalize(offset) * max_offset;
+        }
+
+        const auto predicted = current + offset;
+
+        const auto tx = static_cast<int32_t>(current.x / utils::TILE_SIZE);
+        const auto ty = static_cast<int32_t>(current.y / utils::TILE_SIZE);
+        const auto px = static_cast<int32_t>(predicted.x / utils::TILE_SIZE);
+        const auto py = static_cast<int32_t>(predicted.y / utils::TILE_SIZE);
+
+        std::unordered_set<int32_t> required{};
+        std::unordered_set<int32_t> wanted{};
+        const auto add_area = [radius](const int32_t cx, const int32_t cy, std::unordered_set<int32_t> &out) {
+            for (auto y = std::max(0, cy - radius); y <= std::min(63, cy + radius); ++y) {
+                for (auto x = std::max(0, cx - radius); x <= std::min(63, cx + radius); ++x) {
+                    out.insert(y * 64 + x);
+                }
+            }
+        };
+
+        add_area(tx, ty, required);
+        wanted = required;
+        add_area(px, py, wanted);
+
+        std::lock_guard lock(_lock);
+
+        const auto is_resident = [&](const int32_t index) {
+            return resident.contains(index) || _loaded.contains(index);
+        };
+
+        const auto count_hits = !_required.empty();
+        for (const auto index: required) {
+            if (!count_hits || _required.contains(index) || _missing.contains(index)) {
+                continue;
+            }
+
+            if (is_resident(index)) {
+                ++_stats.hits;
+            } else {
+                ++_stats.misses;
+            }
+        }
+
+        _required = required;
+
+        for (const auto &request: _queue) {
+            if (!wanted.contains(request.index)) {
+                _requested_at.erase(request.index);
+                ++_stats.cancelled;
+            }
+        }
+
+        _queue.clear();
+
+        const auto now = clock::now();
+        for (const auto index: wanted) {
+            if (is_resident(index) || _in_flight.contains(index) || _missing.contains(index)) {
+                continue;
+            }
+
+            const glm::vec2 center{
+                (static_cast<float>(index % 64) + 0.5f) * utils::TILE_SIZE,
+                (static_cast<float>(index / 64) + 0.5f) * utils::TILE_SIZE
+            };
+
+            const auto priority = glm::distance(center, current) + glm::distance(center, predicted);
+            _queue.push_back({index, priority});
+
+            if (_requested_at.try_emplace(index, now).second) {
+                ++_stats.requests;
+            }
+        }
+
+        std::ranges::sort(_queue, [](const tile_request &a, const tile_request &b) {
+            return a.priority > b.priority;
+        });
+
+        std::erase_if(_loaded, [&](const int32_t index) { return resident.contains(index); });
+
+        pump();
+        return wanted;
+    }
+
+    void tile_streamer::pump() {
+        while (!_stopped && !_queue.empty() && _in_flight.size() < _max_in_flight) {
+            const auto index = _queue.back().index;
+            _queue.pop_back();
+            _in_flight.insert(index);
+
+            _pool.submit([this, index] {
+                const auto loaded = _loader(index % 64, index / 64);
+                complete(index, loaded);
+            });
+        }
+    }
+
+    void tile_streamer::complete(const int32_t index, const bool loaded) {
+        std::lock_guard lock(_lock);
+        _in_flight.erase(index);
+        if (loaded) {
+            _loaded.insert(index);
+        } else {
+            _missing.insert(index);
+            _requested_at.erase(index);
+        }
+
+        if (_in_flight.empty()) {
+            _idle_cv.notify_all();
+        }
+
+        pump();
+    }
+
+    void tile_streamer::on_tile_visible(const int32_t x, const int32_t y) {
+        std::lock_guard lock(_lock);
+        const auto itr = _requested_at.find(y * 64 + x);
+        if (itr == _requested_at.end()) {
+            return;
+        }
+
+        const auto latency = std::chrono::duration<float, std::milli>(clock::now() - itr->second).count();
+        _requested_at.erase(itr);
+
+        _latency_sum_ms += latency;
+        ++_latency_count;
+        _stats.max_latency_ms = std::max(_stats.max_latency_ms, latency);
+    }
+
+    void tile_streamer::clear() {
+        std::lock_guard lock(_lock);
+        _queue.clear();
+        _loaded.clear();
+        _missing.clear();
+        _required.clear();
+        _requested_at.clear();
+    }
+
+    void tile_streamer::shutdown() {
+        std::unique_lock lock(_lock);
+        _stopped = true;
+        _queue.clear();
+        _idle_cv.wait(lock, [this] { return _in_flight.empty(); });
+    }
+
+    tile_streamer_stats tile_streamer::take_stats() {
+        std::lock_guard lock(_lock);
+        auto stats = _stats;
+        stats.queued = static_cast<uint32_t>(_queue.size());
+        stats.in_flight = static_cast<uint32_t>(_in_flight.size());
+        stats.average_latency_ms = _latency_count > 0 ? static_cast<float>(_latency_sum_ms / _latency_count) : 0.0f;
+
+        _latency_sum_ms = 0.0;
+        _latency_count = 0;
+        _stats.max_latency_ms = 0.0f;
+        return stats;
+    }
+}
@@ -0,0 +1,81 @@
+#ifndef WOW_UNIX_TILE_STREAMER_H
+#define WOW_UNIX_TILE_STREAMER_H
+
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include "glm/vec2.hpp"
+#include "glm/vec3.hpp"
+#include "utils/work_pool.h"
+
+namespace wow::scene {
+    struct tile_streamer_stats {
+        uint64_t requests = 0;
+        uint64_t hits = 0;
+        uint64_t misses = 0;
+        uint64_t cancelled = 0;
+        uint32_t queued = 0;
+        uint32_t in_flight = 0;
+        float average_latency_ms = 0.0f;
+        float max_latency_ms = 0.0f;
+    };
+
+    class tile_streamer {
+    public:
+        using load_function = std::function<bool(int32_t x, int32_t y)>;
+
+    private:
+        using clock = std::chrono::steady_clock;
+
+        struct tile_request {
+            int32_t index;
+            float priority;
+        };
+
+        utils::work_pool &_pool;
+        load_function _loader;
+        size_t _max_in_flight;
+
+        std::mutex _lock{};
+        std::condition_variable _idle_cv{};
+        bool _stopped = false;
+        std::vector<tile_request> _queue{};
+        std::unordered_set<int32_t> _in_flight{};
+        std::unordered_set<int32_t> _loaded{};
+        std::unordered_set<int32_t> _missing{};
+        std::unordered_set<int32_t> _required{};
+        std::unordered_map<int32_t, clock::time_point> _requested_at{};
+
+        tile_streamer_stats _stats{};
+        double _latency_sum_ms = 0.0;
+        uint64_t _latency_count = 0;
+
+        void pump();
+
+        void complete(int32_t index, bool loaded);
+
+    public:
+        static constexpr float PREFETCH_LOOKAHEAD_SECONDS = 2.0f;
+
+        tile_streamer(utils::work_pool &pool, load_function loader);
+
+        std::unordered_set<int32_t> update(const glm::vec3 &position, const glm::vec3 &velocity, int32_t radius,
+                                           const std::unordered_set<int32_t> &resident);
+
+        void on_tile_visible(int32_t x, int32_t y);
+
+        void clear();
+
+        void shutdown();
+
+        tile_streamer_stats take_stats();
+    };
+}
+
+#endif //WOW_UNIX_TILE_STREAMER_H
@@ -1,5 +1,7 @@
 #include "world_frame.h"
 
+#include "gl/render_stats.h"
+#include "io/terrain/terrain_lod.h"
 #include "utils/di.h"
 #include "utils/system_stats.h"
 
@@ -37,6 +39,50 @@ namespace wow::scene {
             ev.fps_update_event_data.fps = static_cast<int32_t>(fps);
             ev.fps_update_event_data.time_of_day = _map_manager->time_of_day();
             utils::app_module->ui_event_system()->event_manager()->submit(ev);
+
+            const auto stats = _map_manager->streaming_stats();
+            web::event::js_event stats_ev = {};
+            stats_ev.type = web::event::js_event_type::streaming_stats_event;
+            stats_ev.streaming_stats_event_data.requests = static_cast<int64_t>(stats.requests);
+            stats_ev.streaming_stats_event_data.hits = static_cast<int64_t>(stats.hits);
+            stats_ev.streaming_stats_event_data.misses = static_cast<int64_t>(stats.misses);
+            stats_ev.streaming_stats_event_data.cancelled = static_cast<int64_t>(stats.cancelled);
+            stats_ev.streaming_stats_event_data.queued = static_cast<int32_t>(stats.queued);
+            stats_ev.streaming_stats_event_data.in_flight = static_cast<int32_t>(stats.in_flight);
+            stats_ev.streaming_stats_event_data.average_latency_ms = stats.average_latency_ms;
+            stats_ev.streaming_stats_event_data.max_latency_ms = stats.max_latency_ms;
+
+            const auto [resident_tiles, resident_cpu_bytes, resident_gpu_bytes, resident_vertex_bytes] =
+                    _map_manager->residency_usage();
+            stats_ev.streaming_stats_event_data.resident_tiles = static_cast<int32_t>(resident_tiles);
+            stats_ev.streaming_stats_event_data.resident_cpu_bytes = static_cast<int64_t>(resident_cpu_bytes);
+            stats_ev.streaming_stats_event_data.resident_gpu_bytes = static_cast<int64_t>(resident_gpu_bytes);
+            stats_ev.streaming_stats_event_data.resident_vertex_bytes = static_cast<int64_t>(resident_vertex_bytes);
+            utils::app_module->ui_event_system()->event_manager()->submit(stats_ev);
+
+            const auto &render = gl::render_stats::last_frame();
+            web::event::js_event render_ev = {};
+            render_ev.type = web::event::js_event_type::render_stats_event;
+            render_ev.render_stats_event_data.draw_calls = static_cast<int32_t>(render.draw_calls);
+            render_ev.render_stats_event_data.texture_binds = static_cast<int32_t>(render.texture_binds);
+            render_ev.render_stats_event_data.buffer_binds = static_cast<int32_t>(render.buffer_binds);
+            render_ev.render_stats_event_data.visible_chunks = static_cast<int32_t>(render.visible_chunks);
+            render_ev.render_stats_event_data.culled_chunks = static_cast<int32_t>(render.culled_chunks);
+            render_ev.render_stats_event_data.cull_time_ms =
+                    std::chrono::duration<float, std::milli>(render.cull_time).count();
+            for (const auto triangles: render.lod_triangles) {
+                render_ev.render_stats_event_data.lod_triangles.push_back(static_cast<int32_t>(triangles));
+            }
+
+            const auto dispatch = _dispatcher->stats();
+            render_ev.render_stats_event_data.dispatch_time_ms = dispatch.frame_time_ms;
+            render_ev.render_stats_event_data.dispatch_budget_ms = dispatch.budget_ms;
+            for (auto i = 0u; i < GPU_PRIORITY_CLASSES; ++i) {
+                render_ev.render_stats_event_data.dispatch_queue_depth.push_back(
+                    static_cast<int32_t>(dispatch.queue_depth[i]));
+                render_ev.render_stats_event_data.dispatch_stalls.push_back(static_cast<int64_t>(dispatch.stalls[i]));
+            }
+            utils::app_module->ui_event_system()->event_manager()->submit(render_ev);
         }
     }
 
@@ -71,13 +117,21 @@ namespace wow::scene {
             _map_manager->update(_camera->position());
         }
 
-        _dispatcher->process_one_frame();
+        _dispatcher->process_one_frame(utils::app_module->window()->swap_wait());
 
         _scene_info.camera_position = _camera->position();
         _scene_info.view_distance = 2.0f * utils::TILE_SIZE;
 
+        const auto [width, height] = utils::app_module->window()->size();
+        _scene_info.pixels_per_unit = _camera->projection()[1][1] * static_cast<float>(height) * 0.5f;
+        _scene_info.lod_distance = io::terrain::terrain_lod_distance(
+            static_cast<float>(utils::app_module->config_manager()->map().lod_pixel_error),
+            static_cast<float>(height),
+            _camera->projection()[1][1]);
+
         _map_manager->on_frame(_scene_info);
 
         handle_fps_update();
+        gl::render_stats::end_frame();
     }
 }
@@ -1,6 +1,7 @@
 #include "di.h"
 
 #include "gl/window.h"
+#include "io/asset_cache.h"
 #include "io/mpq_manager.h"
 #include "io/dbc/dbc_manager.h"
 #include "io/minimap/minimap_provider.h"
@@ -24,12 +25,14 @@ namespace wow::utils {
             di::bind<web::event::event_manager>().in(di::singleton),
             di::bind<io::mpq_manager>().in(di::singleton),
             di::bind<io::dbc::dbc_manager>().in(di::singleton),
+            di::bind<io::asset_cache>().in(di::singleton),
             di::bind<web::event::ui_event_system>().in(di::singleton),
             di::bind<io::minimap::minimap_provider>().in(di::singleton),
             di::bind<scene::world_frame>().in(di::singleton),
             di::bind<config::config_manager>().in(di::singleton),
             di::bind<scene::gpu_dispatcher>().in(di::singleton),
             di::bind<scene::camera>().in(di::singleton),
+            di::bind<scene::far_terrain>().in(di::singleton),
             di::bind<audio::audio_manager>().in(di::singleton),
             di::bind<audio::zone_music_manager>().in(di::singleton)
         ).create<std::shared_ptr<application_module> >();
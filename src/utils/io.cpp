@@ -6,7 +6,14 @@
 #include <stdexcept>
 
 namespace wow::utils {
-    binary_reader::binary_reader(std::vector<uint8_t> data) : _data(std::move(data)) {
+    binary_reader::binary_reader(std::vector<uint8_t> data) {
+        const auto buffer = std::make_shared<const std::vector<uint8_t> >(std::move(data));
+        _data = *buffer;
+        _owner = buffer;
+    }
+
+    binary_reader::binary_reader(const std::span<const uint8_t> data, std::shared_ptr<const void> owner)
+        : _owner(std::move(owner)), _data(data) {
     }
 
     void binary_reader::read(void *data, const size_t size) {
@@ -18,6 +25,28 @@ namespace wow::utils {
         _offset += size;
     }
 
+    std::string binary_reader::read_string() {
+        const auto length = read<uint32_t>();
+        if (_offset + length > _data.size()) {
+            throw std::runtime_error("binary reader read out of bounds");
+        }
+
+        std::string value{reinterpret_cast<const char *>(_data.data() + _offset), length};
+        _offset += length;
+        return value;
+    }
+
+    void binary_writer::write(const void *data, const size_t size) {
+        const auto bytes = static_cast<const uint8_t *>(data);
+        _data.insert(_data.end(), bytes, bytes + size);
+    }
+
+    binary_writer &binary_writer::write_string(const std::string &value) {
+        write(static_cast<uint32_t>(value.size()));
+        write(value.data(), value.size());
+        return *this;
+    }
+
     void write_to_vector(void *context, void *data, const int size) {
         const auto v = static_cast<std::vector<uint8_t> *>(context);
         v->insert(v->end(), static_cast<uint8_t *>(data), static_cast<uint8_t *>(data) + size);
@@ -1,19 +1,25 @@
 #ifndef WOW_UNIX_IO_H
 #define WOW_UNIX_IO_H
 
+#include <array>
 #include <vector>
 #include <cstdint>
 #include <memory>
+#include <span>
 #include <string>
+#include <type_traits>
 
 namespace wow::utils {
     class binary_reader {
-        std::vector<uint8_t> _data{};
+        std::shared_ptr<const void> _owner{};
+        std::span<const uint8_t> _data{};
         size_t _offset = 0;
 
     public:
         explicit binary_reader(std::vector<uint8_t> data);
 
+        explicit binary_reader(std::span<const uint8_t> data, std::shared_ptr<const void> owner = {});
+
         void read(void *data, size_t size);
 
         binary_reader &seek_mod(const ssize_t diff) {
@@ -57,6 +63,8 @@ namespace wow::utils {
             return *this;
         }
 
+        std::string read_string();
+
         [[nodiscard]] bool eof() const {
             return _offset >= _data.size();
         }
@@ -64,10 +72,45 @@ namespace wow::utils {
         [[nodiscard]] std::size_t size() const {
             return _data.size();
         }
+
+        [[nodiscard]] std::size_t position() const {
+            return _offset;
+        }
+
+        [[nodiscard]] std::span<const uint8_t> data() const {
+            return _data;
+        }
     };
 
     using binary_reader_ptr = std::shared_ptr<binary_reader>;
 
+    class binary_writer {
+        std::vector<uint8_t> _data{};
+
+    public:
+        void write(const void *data, size_t size);
+
+        template<typename T>
+        binary_writer &write(const T &value) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            write(&value, sizeof(T));
+            return *this;
+        }
+
+        template<typename T>
+        binary_writer &write(const std::vector<T> &data) {
+            static_assert(std::is_trivially_copyable_v<T>);
+            write(data.data(), data.size() * sizeof(T));
+            return *this;
+        }
+
+        binary_writer &write_string(const std::string &value);
+
+        [[nodiscard]] const std::vector<uint8_t> &data() const {
+            return _data;
+        }
+    };
+
     std::vector<uint8_t> to_png(const std::vector<uint8_t> &data, uint32_t w, uint32_t h);
 
     inline binary_reader_ptr make_binary_reader(const std::vector<uint8_t> &data) {
@@ -0,0 +1,89 @@
+#include "mapped_file.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#else
+#include <windows.h>
+#endif
+
+#include "spdlog/spdlog.h"
+
+namespace wow::utils {
+    mapped_file::mapped_file(const std::string &path) {
+#ifndef _WIN32
+        const auto fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            SPDLOG_WARN("Cannot open {} for mapping", path);
+            return;
+        }
+
+        struct stat file_stat{};
+        if (fstat(fd, &file_stat) != 0 || file_stat.st_size <= 0) {
+            close(fd);
+            return;
+        }
+
+        const auto size = static_cast<size_t>(file_stat.st_size);
+        const auto ptr = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+        close(fd);
+
+        if (ptr == MAP_FAILED) {
+            SPDLOG_WARN("Cannot map {} into memory", path);
+            return;
+        }
+
+        _data = static_cast<const uint8_t *>(ptr);
+        _size = size;
+#else
+        const auto file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                      FILE_ATTRIBUTE_NORMAL, nullptr);
+        if (file == INVALID_HANDLE_VALUE) {
+            SPDLOG_WARN("Cannot open {} for mapping", path);
+            return;
+        }
+
+        LARGE_INTEGER size{};
+        if (!GetFileSizeEx(file, &size) || size.QuadPart <= 0) {
+            CloseHandle(file);
+            return;
+        }
+
+        const auto mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        if (!mapping) {
+            CloseHandle(file);
+            SPDLOG_WARN("Cannot map {} into memory", path);
+            return;
+        }
+
+        const auto ptr = MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+        if (!ptr) {
+            CloseHandle(mapping);
+            CloseHandle(file);
+            SPDLOG_WARN("Cannot map {} into memory", path);
+            return;
+        }
+
+        _file_handle = file;
+        _mapping_handle = mapping;
+        _data = static_cast<const uint8_t *>(ptr);
+        _size = static_cast<size_t>(size.QuadPart);
+#endif
+    }
+
+    mapped_file::~mapped_file() {
+        if (!_data) {
+            return;
+        }
+
+#ifndef _WIN32
+        munmap(const_cast<uint8_t *>(_data), _size);
+#else
+        UnmapViewOfFile(_data);
+        CloseHandle(_mapping_handle);
+        CloseHandle(_file_handle);
+#endif
+    }
+}
@@ -0,0 +1,57 @@
+#ifndef WOW_UNIX_MAPPED_FILE_H
+#define WOW_UNIX_MAPPED_FILE_H
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string>
+
+namespace wow::utils {
+    class mapped_file {
+        const uint8_t *_data{};
+        size_t _size{};
+
+#ifdef _WIN32
+        void *_file_handle{};
+        void *_mapping_handle{};
+#endif
+
+    public:
+        explicit mapped_file(const std::string &path);
+
+        ~mapped_file();
+
+        mapped_file(const mapped_file &) = delete;
+
+        mapped_file &operator=(const mapped_file &) = delete;
+
+        [[nodiscard]] bool is_valid() const {
+            return _data != nullptr;
+        }
+
+        [[nodiscard]] const uint8_t *data() const {
+            return _data;
+        }
+
+        [[nodiscard]] size_t size() const {
+            return _size;
+        }
+
+        [[nodiscard]] std::span<const uint8_t> view(const uint64_t offset, const size_t size) const {
+            if (!_data || offset > _size || size > _size - offset) {
+                return {};
+            }
+
+            return {_data + offset, size};
+        }
+    };
+
+    using mapped_file_ptr = std::shared_ptr<mapped_file>;
+
+    inline mapped_file_ptr make_mapped_file(const std::string &path) {
+        auto file = std::make_shared<mapped_file>(path);
+        return file->is_valid() ? file : nullptr;
+    }
+}
+
+#endif //WOW_UNIX_MAPPED_FILE_H
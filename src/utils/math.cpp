@@ -1,5 +1,8 @@
 #include "./math.h" // avoid linter warning that it should be cmath if #include "math.h" is used
 
+#include <algorithm>
+#include <cmath>
+
 namespace wow::utils {
     bool bounding_box::intersects_sphere(const glm::vec3 &center, const float radius) const {
         const auto r_squared = radius * radius;
@@ -14,4 +17,35 @@ namespace wow::utils {
 
         return d_min <= r_squared;
     }
+
+    bool bounding_box::inside_sphere(const glm::vec3 &center, const float radius) const {
+        auto d_max = 0.0f;
+        for (auto i = 0; i < 3; ++i) {
+            const auto d = std::max(std::abs(center[i] - _min[i]), std::abs(center[i] - _max[i]));
+            d_max += d * d;
+        }
+
+        return d_max <= radius * radius;
+    }
+
+    void bounding_box_set::reserve(const size_t count) {
+        for (auto *values: {&_min_x, &_min_y, &_min_z, &_max_x, &_max_y, &_max_z}) {
+            values->reserve(count);
+        }
+    }
+
+    void bounding_box_set::clear() {
+        for (auto *values: {&_min_x, &_min_y, &_min_z, &_max_x, &_max_y, &_max_z}) {
+            values->clear();
+        }
+    }
+
+    void bounding_box_set::push_back(const bounding_box &box) {
+        _min_x.push_back(box.min().x);
+        _min_y.push_back(box.min().y);
+        _min_z.push_back(box.min().z);
+        _max_x.push_back(box.max().x);
+        _max_y.push_back(box.max().y);
+        _max_z.push_back(box.max().z);
+    }
 }
@@ -1,6 +1,8 @@
 #ifndef WOW_UNIX_MATH_H
 #define WOW_UNIX_MATH_H
 
+#include <vector>
+
 #include "glm/vec3.hpp"
 #include "glm/vec4.hpp"
 #include "glm/geometric.hpp"
@@ -52,6 +54,38 @@ namespace wow::utils {
         }
 
         [[nodiscard]] bool intersects_sphere(const glm::vec3 &center, const float radius) const;
+
+        [[nodiscard]] bool inside_sphere(const glm::vec3 &center, float radius) const;
+    };
+
+    class bounding_box_set {
+        std::vector<float> _min_x{}, _min_y{}, _min_z{};
+        std::vector<float> _max_x{}, _max_y{}, _max_z{};
+
+    public:
+        void reserve(size_t count);
+
+        void clear();
+
+        void push_back(const bounding_box &box);
+
+        [[nodiscard]] bounding_box at(size_t index) const {
+            return {
+                {_min_x[index], _min_y[index], _min_z[index]},
+                {_max_x[index], _max_y[index], _max_z[index]}
+            };
+        }
+
+        [[nodiscard]] size_t size() const { return _min_x.size(); }
+
+        [[nodiscard]] bool empty() const { return _min_x.empty(); }
+
+        [[nodiscard]] const float *min_x() const { return _min_x.data(); }
+        [[nodiscard]] const float *min_y() const { return _min_y.data(); }
+        [[nodiscard]] const float *min_z() const { return _min_z.data(); }
+        [[nodiscard]] const float *max_x() const { return _max_x.data(); }
+        [[nodiscard]] const float *max_y() const { return _max_y.data(); }
+        [[nodiscard]] const float *max_z() const { return _max_z.data(); }
     };
 
     class plane {
@@ -1,5 +1,7 @@
 #include "work_pool.h"
 
+#include <atomic>
+
 namespace wow::utils {
     void work_pool::worker_function() {
         while (_running) {
@@ -24,7 +26,7 @@ namespace wow::utils {
 
     work_pool::work_pool() {
         const auto num_threads = std::max(1u, std::thread::hardware_concurrency());
-        for (auto i = 0; i < num_threads; ++i) {
+        for (auto i = 0u; i < num_threads; ++i) {
             _worker_threads.emplace_back(
                 [this] {
                     worker_function();
@@ -50,4 +52,57 @@ namespace wow::utils {
         _work_cv.notify_one();
         return work_item->get_future();
     }
-}
\ No newline at end of file
+
+    void work_pool::parallel_for(const size_t count, const std::function<void(size_t)> &task) {
+        struct parallel_state {
+            std::function<void(size_t)> task;
+            size_t count;
+            std::atomic_size_t next{0};
+            std::atomic_size_t remaining;
+            std::exception_ptr error{};
+            std::mutex lock{};
+            std::condition_variable done_cv{};
+
+            parallel_state(const std::function<void(size_t)> &task, const size_t count) : task(task),
+                count(count),
+                remaining(count) {
+            }
+
+            void run() {
+                for (auto index = next++; index < count; index = next++) {
+                    try {
+                        task(index);
+                    } catch (...) {
+                        std::lock_guard guard(lock);
+                        if (!error) {
+                            error = std::current_exception();
+                        }
+                    }
+
+                    if (--remaining == 0) {
+                        std::lock_guard guard(lock);
+                        done_cv.notify_all();
+                    }
+                }
+            }
+        };
+
+        if (count == 0) {
+            return;
+        }
+
+        const auto state = std::make_shared<parallel_state>(task, count);
+        const auto helpers = std::min(count - 1, _worker_threads.size());
+        for (size_t i = 0; i < helpers; ++i) {
+            submit([state] { state->run(); });
+        }
+
+        state->run();
+
+        std::unique_lock lock(state->lock);
+        state->done_cv.wait(lock, [&state] { return state->remaining == 0; });
+        if (state->error) {
+            std::rethrow_exception(state->error);
+        }
+    }
+}
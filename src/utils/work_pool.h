@@ -25,6 +25,12 @@ namespace wow::utils {
         ~work_pool();
 
         std::shared_future<void> submit(const std::function<void()> &task);
+
+        void parallel_for(size_t count, const std::function<void(size_t)> &task);
+
+        [[nodiscard]] size_t size() const {
+            return _worker_threads.size();
+        }
     };
 
     using work_pool_ptr = std::shared_ptr<work_pool>;
@@ -50,7 +50,9 @@ namespace wow::web::event {
         system_update_event,
         fetch_game_time_request,
         fetch_game_time_response,
-        sound_update_event
+        sound_update_event,
+        streaming_stats_event,
+        render_stats_event
     };
 
     struct initialize_request {
@@ -166,6 +168,35 @@ namespace wow::web::event {
         std::string sound_name{};
     };
 
+    struct streaming_stats_event {
+        int64_t requests = 0;
+        int64_t hits = 0;
+        int64_t misses = 0;
+        int64_t cancelled = 0;
+        int32_t queued = 0;
+        int32_t in_flight = 0;
+        float average_latency_ms = 0.0f;
+        float max_latency_ms = 0.0f;
+        int32_t resident_tiles = 0;
+        int64_t resident_cpu_bytes = 0;
+        int64_t resident_gpu_bytes = 0;
+        int64_t resident_vertex_bytes = 0;
+    };
+
+    struct render_stats_event {
+        int32_t draw_calls = 0;
+        int32_t texture_binds = 0;
+        int32_t buffer_binds = 0;
+        int32_t visible_chunks = 0;
+        int32_t culled_chunks = 0;
+        float cull_time_ms = 0.0f;
+        std::vector<int32_t> lod_triangles{};
+        float dispatch_time_ms = 0.0f;
+        float dispatch_budget_ms = 0.0f;
+        std::vector<int32_t> dispatch_queue_depth{};
+        std::vector<int64_t> dispatch_stalls{};
+    };
+
     struct js_event {
         js_event_type type = js_event_type::none;
         initialize_request initialize_request_data;
@@ -189,6 +220,8 @@ namespace wow::web::event {
         fetch_game_time_request fetch_game_time_request_data;
         fetch_game_time_response fetch_game_time_response_data;
         sound_update_event sound_update_event_data;
+        streaming_stats_event streaming_stats_event_data;
+        render_stats_event render_stats_event_data;
     };
 }
 
@@ -14,14 +14,13 @@ namespace wow::web::schemes {
                 const auto mpq_manager = utils::app_module->mpq_manager();
                 const auto path = request->GetURL().ToString();
                 const auto file_name = path.substr(prefix.length());
-                const auto file = mpq_manager->open(utils::replace_all(file_name, "/", "\\"));
-                if (!file) {
+                const auto blp_file = mpq_manager->open_blp(utils::replace_all(file_name, "/", "\\"));
+                if (!blp_file) {
                     callback->Continue();
                     return;
                 }
 
-                const io::blp::blp_file blp_file{file};
-                _data = blp_file.convert_to_png();
+                _data = blp_file->convert_to_png();
                 _found = true;
 
                 callback->Continue();
@@ -1,6 +1,7 @@
 #include "web_core.h"
 
 #include "include/cef_browser.h"
+#include <cstring>
 #include <filesystem>
 #include <utility>
 
@@ -256,8 +257,21 @@ namespace wow::web {
 
     void web_core::on_paint(const int32_t width, const int32_t height, const void *data) {
         std::lock_guard lock{_image_lock};
-        const auto ptr = static_cast<const uint8_t *>(data);
-        _image_data.assign(ptr, ptr + width * height * 4);
+        auto &ring = gl::upload_ring::instance();
+        if (_pending_upload) {
+            ring.release(*_pending_upload);
+            _pending_upload.reset();
+        }
+
+        const auto size = static_cast<size_t>(width) * height * 4;
+        if (const auto allocation = ring.allocate(size, gl::UPLOAD_RING_ALIGNMENT, false)) {
+            std::memcpy(allocation->data, data, size);
+            _pending_upload = allocation;
+        } else {
+            const auto ptr = static_cast<const uint8_t *>(data);
+            _image_data.assign(ptr, ptr + size);
+        }
+
         _width = width;
         _height = height;
         _is_dirty = true;
@@ -512,7 +526,15 @@ namespace wow::web {
         }
 
         std::lock_guard lock{_image_lock};
-        _texture->bgra_image(_width, _height, _image_data.data());
+        if (_pending_upload) {
+            gl::upload_ring::instance().unpack(*_pending_upload, [this](const void *offset) {
+                _texture->bgra_image(_width, _height, offset);
+            });
+            _pending_upload.reset();
+        } else {
+            _texture->bgra_image(_width, _height, _image_data.data());
+        }
+
         _is_dirty = false;
         _has_loaded = true;
     }
@@ -9,6 +9,7 @@
 #include "event/event_manager.h"
 #include "gl/mesh.h"
 #include "gl/texture.h"
+#include "gl/upload_ring.h"
 #include "gl/window.h"
 
 namespace wow::web {
@@ -31,6 +32,7 @@ namespace wow::web {
         gl::texture_ptr _texture{};
         int32_t _texture_uniform = -1;
         std::vector<uint8_t> _image_data{};
+        std::optional<gl::upload_allocation> _pending_upload{};
         int32_t _width = 0, _height = 0;
 
         double _mouse_x = 0, _mouse_y = 0;
@@ -0,0 +1,278 @@
+#include "test.h"
+
+#include <algorithm>
+#include <array>
+#include <random>
+#include <string>
+
+#include "io/terrain/alpha_map.h"
+
+using namespace wow::io::terrain;
+
+namespace {
+    using alpha_plane = std::array<uint8_t, ALPHA_MAP_TEXELS>;
+    using shadow_plane = std::array<uint8_t, ALPHA_MAP_TEXELS / 8>;
+    using packed_texels = std::array<uint32_t, ALPHA_MAP_TEXELS>;
+
+    std::vector<alpha_kernel> supported_kernels() {
+        std::vector<alpha_kernel> kernels{};
+        for (const auto kernel: {alpha_kernel::scalar, alpha_kernel::sse2, alpha_kernel::avx2}) {
+            if (is_alpha_kernel_supported(kernel)) {
+                kernels.push_back(kernel);
+            }
+        }
+
+        return kernels;
+    }
+
+    std::vector<uint8_t> random_bytes(std::mt19937 &rng, const size_t count) {
+        std::uniform_int_distribution<int> distribution{0, 255};
+        std::vector<uint8_t> bytes(count);
+        std::ranges::generate(bytes, [&] { return static_cast<uint8_t>(distribution(rng)); });
+        return bytes;
+    }
+
+    std::vector<uint8_t> encode_rle(const alpha_plane &plane) {
+        std::vector<uint8_t> encoded{};
+        size_t i = 0;
+        while (i < plane.size()) {
+            auto run = 1u;
+            while (i + run < plane.size() && run < 0x7F && plane[i + run] == plane[i]) {
+                ++run;
+            }
+
+            if (run > 2) {
+                encoded.push_back(static_cast<uint8_t>(0x80 | run));
+                encoded.push_back(plane[i]);
+                i += run;
+                continue;
+            }
+
+            auto count = 0u;
+            while (i + count < plane.size() && count < 0x7F &&
+                   (i + count + 2 >= plane.size() || plane[i + count] != plane[i + count + 1] ||
+                    plane[i + count] != plane[i + count + 2])) {
+                ++count;
+            }
+
+            count = std::max(count, 1u);
+            encoded.push_back(static_cast<uint8_t>(count));
+            encoded.insert(encoded.end(), plane.begin() + static_cast<ptrdiff_t>(i),
+                           plane.begin() + static_cast<ptrdiff_t>(i + count));
+            i += count;
+        }
+
+        return encoded;
+    }
+
+    alpha_plane runs_plane(std::mt19937 &rng) {
+        std::uniform_int_distribution<int> length{1, 300};
+        std::uniform_int_distribution<int> value{0, 255};
+        std::bernoulli_distribution noisy{0.3};
+
+        alpha_plane plane{};
+        size_t i = 0;
+        while (i < plane.size()) {
+            const auto run = std::min<size_t>(length(rng), plane.size() - i);
+            const auto fill = static_cast<uint8_t>(value(rng));
+            const auto noise = noisy(rng);
+            for (size_t j = 0; j < run; ++j) {
+                plane[i + j] = noise ? static_cast<uint8_t>(value(rng)) : fill;
+            }
+
+            i += run;
+        }
+
+        return plane;
+    }
+
+    packed_texels pack(const alpha_kernel kernel, const alpha_shadow_source &source) {
+        packed_texels texels{};
+        texels.fill(0xCDCDCDCDu);
+        pack_alpha_shadow(kernel, source, texels.data());
+        return texels;
+    }
+
+    void check_pack_matches_scalar(const alpha_shadow_source &source, const std::string &label) {
+        const auto expected = pack(alpha_kernel::scalar, source);
+        for (const auto kernel: supported_kernels()) {
+            WOW_CHECK_MESSAGE(pack(kernel, source) == expected,
+                              label + ": " + std::string(alpha_kernel_name(kernel)) + " pack differs from scalar");
+        }
+    }
+}
+
+WOW_TEST(alpha_scalar_nibbles_scale_to_full_range) {
+    std::array<uint8_t, 256> src{};
+    for (auto i = 0u; i < src.size(); ++i) {
+        src[i] = static_cast<uint8_t>(i);
+    }
+
+    std::array<uint8_t, 512> dst{};
+    expand_alpha_nibbles(alpha_kernel::scalar, src.data(), dst.data(), src.size());
+    for (auto i = 0u; i < src.size(); ++i) {
+        WOW_CHECK(dst[i * 2] == (i & 0x0F) * 17);
+        WOW_CHECK(dst[i * 2 + 1] == (i >> 4) * 17);
+    }
+}
+
+WOW_TEST(alpha_nibble_kernels_match_scalar) {
+    std::mt19937 rng{0x4D43414C};
+    for (const size_t count: {0u, 1u, 15u, 16u, 17u, 31u, 32u, 33u, 63u, 64u, 100u, 2016u, 2048u}) {
+        const auto src = random_bytes(rng, count);
+        std::vector<uint8_t> expected(count * 2 + 1, 0xAB);
+        expand_alpha_nibbles(alpha_kernel::scalar, src.data(), expected.data(), count);
+
+        for (const auto kernel: supported_kernels()) {
+            std::vector<uint8_t> actual(count * 2 + 1, 0xAB);
+            expand_alpha_nibbles(kernel, src.data(), actual.data(), count);
+            WOW_CHECK_MESSAGE(actual == expected,
+                              std::string(alpha_kernel_name(kernel)) + " nibbles differ from scalar for " +
+                              std::to_string(count) + " bytes");
+        }
+    }
+}
+
+WOW_TEST(alpha_4bit_decode_matches_scalar) {
+    std::mt19937 rng{0x34424954};
+    for (const auto full_alpha: {false, true}) {
+        const auto data = random_bytes(rng, 64 * 32);
+        alpha_plane expected{};
+        const auto expected_result = decode_alpha_4bit(alpha_kernel::scalar, data, full_alpha, expected.data());
+        WOW_CHECK(expected_result.complete);
+        WOW_CHECK(expected_result.consumed == (full_alpha ? 64u : 63u) * 32);
+
+        for (const auto kernel: supported_kernels()) {
+            alpha_plane actual{};
+            const auto result = decode_alpha_4bit(kernel, data, full_alpha, actual.data());
+            WOW_CHECK(result.complete && result.consumed == expected_result.consumed);
+            WOW_CHECK_MESSAGE(actual == expected,
+                              std::string(alpha_kernel_name(kernel)) + " 4-bit decode differs from scalar" +
+                              (full_alpha ? " (full alpha)" : " (fixed up)"));
+        }
+    }
+}
+
+WOW_TEST(alpha_4bit_fix_up_repeats_last_row_and_column) {
+    std::mt19937 rng{0x3633FF};
+    const auto data = random_bytes(rng, 63 * 32);
+    for (const auto kernel: supported_kernels()) {
+        alpha_plane alpha{};
+        decode_alpha_4bit(kernel, data, false, alpha.data());
+        for (auto row = 0u; row < 64; ++row) {
+            WOW_CHECK(alpha[row * 64 + 63] == alpha[row * 64 + 62]);
+        }
+
+        WOW_CHECK(std::equal(alpha.begin() + 62 * 64, alpha.begin() + 63 * 64, alpha.begin() + 63 * 64));
+        WOW_CHECK(alpha[0] == (data[0] & 0x0F) * 17);
+        WOW_CHECK(alpha[62 * 64 + 61] == (data[62 * 32 + 30] >> 4) * 17);
+    }
+}
+
+WOW_TEST(alpha_4bit_rejects_truncated_data) {
+    const std::vector<uint8_t> data(63 * 32 - 1, 0xFF);
+    for (const auto kernel: supported_kernels()) {
+        alpha_plane alpha{};
+        const auto result = decode_alpha_4bit(kernel, data, false, alpha.data());
+        WOW_CHECK(!result.complete && result.consumed == 0);
+        WOW_CHECK(std::ranges::all_of(alpha, [](const uint8_t value) { return value == 0; }));
+    }
+}
+
+WOW_TEST(alpha_rle_round_trips_and_packs_like_scalar) {
+    std::mt19937 rng{0x524C45};
+    for (auto iteration = 0; iteration < 16; ++iteration) {
+        const auto plane = runs_plane(rng);
+        auto encoded = encode_rle(plane);
+        encoded.push_back(0xAA);
+
+        alpha_plane decoded{};
+        const auto result = decode_alpha_rle(encoded, decoded.data());
+        WOW_CHECK(result.complete);
+        WOW_CHECK(result.consumed == encoded.size() - 1);
+        WOW_CHECK(decoded == plane);
+
+        alpha_shadow_source source{};
+        source.alpha[0] = decoded.data();
+        source.alpha[1] = opaque_alpha_plane();
+        check_pack_matches_scalar(source, "rle iteration " + std::to_string(iteration));
+    }
+}
+
+WOW_TEST(alpha_rle_clamps_truncated_and_overrunning_runs) {
+    alpha_plane decoded{};
+    const std::vector<uint8_t> truncated{0x85, 0x10, 0x03, 0x01, 0x02};
+    const auto partial = decode_alpha_rle(truncated, decoded.data());
+    WOW_CHECK(!partial.complete);
+    WOW_CHECK(partial.consumed == truncated.size());
+    WOW_CHECK(std::all_of(decoded.begin(), decoded.begin() + 5, [](const uint8_t value) { return value == 0x10; }));
+    WOW_CHECK(decoded[5] == 0x01 && decoded[6] == 0x02);
+
+    std::vector<uint8_t> overrun{};
+    for (auto i = 0u; i < ALPHA_MAP_TEXELS / 0x7F + 1; ++i) {
+        overrun.push_back(0xFF);
+        overrun.push_back(static_cast<uint8_t>(i));
+    }
+
+    decoded.fill(0);
+    const auto clamped = decode_alpha_rle(overrun, decoded.data());
+    WOW_CHECK(clamped.complete);
+    WOW_CHECK(clamped.consumed == overrun.size());
+    WOW_CHECK(decoded.back() == ALPHA_MAP_TEXELS / 0x7F);
+
+    const std::vector<uint8_t> dangling{0x80 | 0x10};
+    const auto missing_value = decode_alpha_rle(dangling, decoded.data());
+    WOW_CHECK(!missing_value.complete);
+    WOW_CHECK(missing_value.consumed == dangling.size());
+}
+
+WOW_TEST(alpha_pack_kernels_match_scalar) {
+    std::mt19937 rng{0x5348414D};
+    for (auto iteration = 0; iteration < 8; ++iteration) {
+        std::array<alpha_plane, 3> planes{};
+        for (auto &plane: planes) {
+            const auto bytes = random_bytes(rng, plane.size());
+            std::ranges::copy(bytes, plane.begin());
+        }
+
+        shadow_plane shadow{};
+        std::ranges::copy(random_bytes(rng, shadow.size()), shadow.begin());
+
+        alpha_shadow_source source{};
+        for (auto i = 0u; i < planes.size(); ++i) {
+            source.alpha[i] = planes[i].data();
+        }
+
+        source.shadow = shadow.data();
+        check_pack_matches_scalar(source, "random iteration " + std::to_string(iteration));
+
+        const auto texels = pack(alpha_kernel::scalar, source);
+        for (const auto index: {0u, 7u, 8u, 1000u, 4095u}) {
+            const auto shadowed = (shadow[index / 8] >> (index % 8) & 1) != 0;
+            WOW_CHECK(texels[index] == (planes[0][index] | planes[1][index] << 8 | planes[2][index] << 16 |
+                                        (shadowed ? 0xFF000000u : 0u)));
+        }
+    }
+}
+
+WOW_TEST(alpha_pack_kernels_match_scalar_on_edge_shadows) {
+    shadow_plane all_set{};
+    all_set.fill(0xFF);
+    shadow_plane alternating{};
+    alternating.fill(0x55);
+    shadow_plane high_bits{};
+    high_bits.fill(0x80);
+
+    const std::array<const uint8_t *, 4> shadows{all_set.data(), alternating.data(), high_bits.data(), nullptr};
+    for (const auto shadow: shadows) {
+        alpha_shadow_source source{};
+        source.alpha[2] = opaque_alpha_plane();
+        source.shadow = shadow;
+        check_pack_matches_scalar(source, "edge shadow");
+    }
+
+    alpha_shadow_source empty{};
+    const auto texels = pack(alpha_kernel::scalar, empty);
+    WOW_CHECK(std::ranges::all_of(texels, [](const uint32_t texel) { return texel == 0; }));
+    check_pack_matches_scalar(empty, "empty source");
+}
@@ -0,0 +1,170 @@
+#include "test.h"
+
+#include <array>
+#include <cstdint>
+#include <stdexcept>
+#include <vector>
+
+#include "io/blp/bc_decoder.h"
+
+using namespace wow::io::blp;
+
+namespace {
+    using rgba = std::array<uint8_t, 4>;
+    using block_pixels = std::array<rgba, 16>;
+
+    constexpr std::array<uint8_t, 4> ramp_indices{0xE4, 0x1B, 0x00, 0xFF};
+    constexpr std::array<uint32_t, 16> ramp_pattern{0, 1, 2, 3, 3, 2, 1, 0, 0, 0, 0, 0, 3, 3, 3, 3};
+
+    block_pixels decode_block(void (*decoder)(std::span<const uint8_t>, uint32_t, uint32_t, uint8_t *),
+                              const std::vector<uint8_t> &block) {
+        std::array<uint8_t, 64> output{};
+        decoder(block, 4, 4, output.data());
+
+        block_pixels pixels{};
+        for (auto i = 0u; i < pixels.size(); ++i) {
+            pixels[i] = {output[i * 4], output[i * 4 + 1], output[i * 4 + 2], output[i * 4 + 3]};
+        }
+
+        return pixels;
+    }
+
+    block_pixels from_palette(const std::array<rgba, 4> &palette) {
+        block_pixels pixels{};
+        for (auto i = 0u; i < pixels.size(); ++i) {
+            pixels[i] = palette[ramp_pattern[i]];
+        }
+
+        return pixels;
+    }
+
+    std::vector<uint8_t> color_block(const uint16_t color0, const uint16_t color1,
+                                     const std::array<uint8_t, 4> &indices) {
+        return {
+            static_cast<uint8_t>(color0 & 0xFF), static_cast<uint8_t>(color0 >> 8),
+            static_cast<uint8_t>(color1 & 0xFF), static_cast<uint8_t>(color1 >> 8),
+            indices[0], indices[1], indices[2], indices[3]
+        };
+    }
+}
+
+WOW_TEST(bc1_four_color_block) {
+    const auto pixels = decode_block(decode_bc1, color_block(0xF800, 0x001F, ramp_indices));
+    WOW_CHECK(pixels == from_palette({
+        rgba{255, 0, 0, 255},
+        rgba{0, 0, 255, 255},
+        rgba{170, 0, 85, 255},
+        rgba{85, 0, 170, 255}
+        }));
+}
+
+WOW_TEST(bc1_three_color_punch_through_block) {
+    const auto pixels = decode_block(decode_bc1, color_block(0x001F, 0xF800, ramp_indices));
+    WOW_CHECK(pixels == from_palette({
+        rgba{0, 0, 255, 255},
+        rgba{255, 0, 0, 255},
+        rgba{127, 0, 127, 255},
+        rgba{0, 0, 0, 0}
+        }));
+}
+
+WOW_TEST(bc1_expands_565_channels) {
+    const auto pixels = decode_block(decode_bc1, color_block(0x8410, 0x0000, {0, 0, 0, 0}));
+    for (const auto &pixel: pixels) {
+        WOW_CHECK((pixel == rgba{132, 130, 132, 255}));
+    }
+
+    const auto green = decode_block(decode_bc1, color_block(0x07E0, 0x0000, {0, 0, 0, 0}));
+    WOW_CHECK((green[0] == rgba{0, 255, 0, 255}));
+}
+
+WOW_TEST(bc2_explicit_alpha_keeps_four_colors) {
+    std::vector<uint8_t> block{0x10, 0x32, 0x54, 0x76, 0x98, 0xBA, 0xDC, 0xFE};
+    const auto colors = color_block(0x001F, 0xF800, ramp_indices);
+    block.insert(block.end(), colors.begin(), colors.end());
+
+    const auto pixels = decode_block(decode_bc2, block);
+    const std::array<rgba, 4> palette{
+        rgba{0, 0, 255, 0},
+        rgba{255, 0, 0, 0},
+        rgba{85, 0, 170, 0},
+        rgba{170, 0, 85, 0}
+    };
+
+    for (auto i = 0u; i < pixels.size(); ++i) {
+        auto expected = palette[ramp_pattern[i]];
+        expected[3] = static_cast<uint8_t>(i * 17);
+        WOW_CHECK(pixels[i] == expected);
+    }
+}
+
+WOW_TEST(bc3_eight_alpha_mode) {
+    std::vector<uint8_t> block{255, 0, 0x88, 0xC6, 0xFA, 0x88, 0xC6, 0xFA};
+    const auto colors = color_block(0xFFFF, 0x0000, {0, 0, 0, 0});
+    block.insert(block.end(), colors.begin(), colors.end());
+
+    const auto pixels = decode_block(decode_bc3, block);
+    constexpr std::array<uint8_t, 8> alpha{255, 0, 218, 182, 145, 109, 72, 36};
+    for (auto i = 0u; i < pixels.size(); ++i) {
+        WOW_CHECK((pixels[i] == rgba{255, 255, 255, alpha[i % 8]}));
+    }
+}
+
+WOW_TEST(bc3_six_alpha_mode) {
+    std::vector<uint8_t> block{0, 255, 0x88, 0xC6, 0xFA, 0x88, 0xC6, 0xFA};
+    const auto colors = color_block(0xF800, 0x001F, ramp_indices);
+    block.insert(block.end(), colors.begin(), colors.end());
+
+    const auto pixels = decode_block(decode_bc3, block);
+    constexpr std::array<uint8_t, 8> alpha{0, 255, 51, 102, 153, 204, 0, 255};
+    const std::array<rgba, 4> palette{
+        rgba{255, 0, 0, 0},
+        rgba{0, 0, 255, 0},
+        rgba{170, 0, 85, 0},
+        rgba{85, 0, 170, 0}
+    };
+
+    for (auto i = 0u; i < pixels.size(); ++i) {
+        auto expected = palette[ramp_pattern[i]];
+        expected[3] = alpha[i % 8];
+        WOW_CHECK(pixels[i] == expected);
+    }
+}
+
+WOW_TEST(bc_partial_blocks_crop_to_image) {
+    std::vector<uint8_t> blocks{};
+    for (const uint16_t color: {0xF800, 0x07E0, 0x001F, 0xFFFF}) {
+        const auto block = color_block(color, 0x0000, ramp_indices);
+        blocks.insert(blocks.end(), block.begin(), block.end());
+    }
+
+    std::vector<uint8_t> full(8 * 8 * 4);
+    decode_bc1(blocks, 8, 8, full.data());
+
+    std::vector<uint8_t> cropped(5 * 6 * 4, 0xCD);
+    decode_bc1(blocks, 5, 6, cropped.data());
+
+    for (auto y = 0u; y < 6; ++y) {
+        for (auto x = 0u; x < 5; ++x) {
+            for (auto c = 0u; c < 4; ++c) {
+                WOW_CHECK(cropped[(y * 5 + x) * 4 + c] == full[(y * 8 + x) * 4 + c]);
+            }
+        }
+    }
+
+    WOW_CHECK((rgba{full[0], full[1], full[2], full[3]} == rgba{255, 0, 0, 255}));
+    WOW_CHECK((rgba{full[16], full[17], full[18], full[19]} == rgba{0, 255, 0, 255}));
+}
+
+WOW_TEST(bc_rejects_short_input) {
+    const std::vector<uint8_t> blocks(8 * 3);
+    std::vector<uint8_t> output(8 * 8 * 4);
+    auto threw = false;
+    try {
+        decode_bc1(blocks, 8, 8, output.data());
+    } catch (const std::runtime_error &) {
+        threw = true;
+    }
+
+    WOW_CHECK(threw);
+}
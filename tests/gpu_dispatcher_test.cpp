@@ -0,0 +1,92 @@
+#include "test.h"
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "scene/gpu_dispatcher.h"
+
+using namespace wow::scene;
+
+namespace {
+    void drain(gpu_dispatcher &dispatcher) {
+        while (true) {
+            const auto stats = dispatcher.stats();
+            if (stats.queue_depth[0] == 0 && stats.queue_depth[1] == 0 && stats.queue_depth[2] == 0) {
+                return;
+            }
+
+            dispatcher.process_one_frame(std::chrono::milliseconds{16});
+        }
+    }
+}
+
+WOW_TEST(gpu_dispatch_keeps_fifo_across_overflow) {
+    gpu_dispatcher dispatcher{};
+    std::vector<uint32_t> order{};
+
+    constexpr auto count = static_cast<uint32_t>(GPU_DISPATCH_RING_SIZE * 3);
+    for (auto i = 0u; i < count / 2; ++i) {
+        dispatcher.dispatch([&order, i] { order.push_back(i); }, gpu_priority::offscreen);
+    }
+
+    dispatcher.process_one_frame(std::chrono::milliseconds{16});
+
+    for (auto i = count / 2; i < count; ++i) {
+        dispatcher.dispatch([&order, i] { order.push_back(i); }, gpu_priority::offscreen);
+    }
+
+    WOW_CHECK(dispatcher.stats().stalls[1] > 0);
+    drain(dispatcher);
+
+    WOW_CHECK(order.size() == count);
+    for (auto i = 0u; i < order.size(); ++i) {
+        if (order[i] != i) {
+            WOW_CHECK_MESSAGE(false, "task " + std::to_string(order[i]) + " ran at position " + std::to_string(i));
+            break;
+        }
+    }
+}
+
+WOW_TEST(gpu_dispatch_keeps_per_producer_order_under_contention) {
+    gpu_dispatcher dispatcher{};
+    constexpr auto producers = 4u;
+    constexpr auto tasks = 20000u;
+
+    std::vector<uint32_t> last(producers, 0);
+    std::atomic_uint32_t violations = 0;
+    std::atomic_uint32_t finished = 0;
+
+    std::vector<std::thread> threads{};
+    for (auto p = 0u; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (auto i = 1u; i <= tasks; ++i) {
+                dispatcher.dispatch([&last, &violations, p, i] {
+                    if (last[p] + 1 != i) {
+                        ++violations;
+                    }
+
+                    last[p] = i;
+                }, gpu_priority::visible);
+            }
+
+            ++finished;
+        });
+    }
+
+    while (finished.load() < producers) {
+        dispatcher.process_one_frame(std::chrono::milliseconds{1});
+    }
+
+    for (auto &thread: threads) {
+        thread.join();
+    }
+
+    drain(dispatcher);
+
+    WOW_CHECK(violations.load() == 0);
+    for (auto p = 0u; p < producers; ++p) {
+        WOW_CHECK(last[p] == tasks);
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef WOW_UNIX_TEST_H
+#define WOW_UNIX_TEST_H
+
+#include <functional>
+#include <string>
+#include <vector>
+
+namespace wow::test {
+    struct test_case {
+        std::string name{};
+        std::function<void()> body{};
+    };
+
+    std::vector<test_case> &registry();
+
+    void report_failure(const char *file, int line, const std::string &message);
+
+    struct test_registrar {
+        test_registrar(const std::string &name, std::function<void()> body) {
+            registry().push_back({name, std::move(body)});
+        }
+    };
+}
+
+#define WOW_TEST(name) \
+    static void name(); \
+    static const wow::test::test_registrar name##_registrar{#name, name}; \
+    static void name()
+
+#define WOW_CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            wow::test::report_failure(__FILE__, __LINE__, #condition); \
+        } \
+    } while (false)
+
+#define WOW_CHECK_MESSAGE(condition, message) \
+    do { \
+        if (!(condition)) { \
+            wow::test::report_failure(__FILE__, __LINE__, message); \
+        } \
+    } while (false)
+
+#endif //WOW_UNIX_TEST_H
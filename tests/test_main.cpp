@@ -0,0 +1,38 @@
+#include "test.h"
+
+#include <iostream>
+
+namespace wow::test {
+    namespace {
+        size_t failures = 0;
+    }
+
+    std::vector<test_case> &registry() {
+        static std::vector<test_case> tests{};
+        return tests;
+    }
+
+    void report_failure(const char *file, const int line, const std::string &message) {
+        ++failures;
+        std::cerr << file << ":" << line << ": check failed: " << message << std::endl;
+    }
+}
+
+int main() {
+    using namespace wow::test;
+
+    size_t failed_tests = 0;
+    for (const auto &[name, body]: registry()) {
+        const auto before = failures;
+        body();
+        const auto passed = failures == before;
+        if (!passed) {
+            ++failed_tests;
+        }
+
+        std::cout << (passed ? "[  OK  ] " : "[ FAIL ] ") << name << std::endl;
+    }
+
+    std::cout << registry().size() - failed_tests << "/" << registry().size() << " tests passed" << std::endl;
+    return failed_tests == 0 ? 0 : 1;
+}
@@ -0,0 +1,74 @@
+#include "test.h"
+
+#include <array>
+#include <future>
+#include <iostream>
+#include <numeric>
+
+#include "gl/egl_context.h"
+#include "gl/upload_context.h"
+
+using namespace wow::gl;
+
+namespace {
+    constexpr size_t BUFFER_VALUES = 4096;
+}
+
+WOW_TEST(upload_fence_hands_buffer_to_render_context) {
+    const auto context = egl_context::create_headless();
+    if (!context || !context->make_current() || !egl_context::load_gl()) {
+        std::cout << "no surfaceless EGL context, skipping fence handoff" << std::endl;
+        return;
+    }
+
+    {
+        upload_context uploads{};
+        WOW_CHECK(uploads.initialize(context->create_shared()));
+        WOW_CHECK(uploads.is_active());
+
+        GLuint buffer = 0;
+        glGenBuffers(1, &buffer);
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glBufferData(GL_COPY_WRITE_BUFFER, BUFFER_VALUES * sizeof(uint32_t), nullptr, GL_STATIC_DRAW);
+        glFinish();
+
+        std::promise<upload_fence_ptr> handoff{};
+        auto fence_future = handoff.get_future();
+        WOW_CHECK(uploads.submit([buffer, &handoff] {
+            std::array<uint32_t, BUFFER_VALUES> values{};
+            std::iota(values.begin(), values.end(), 1u);
+            glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+            glBufferSubData(GL_COPY_WRITE_BUFFER, 0, sizeof(values), values.data());
+            handoff.set_value(std::make_shared<upload_fence>());
+        }));
+
+        const auto fence = fence_future.get();
+        fence->wait();
+
+        std::array<uint32_t, BUFFER_VALUES> read_back{};
+        glBindBuffer(GL_COPY_WRITE_BUFFER, buffer);
+        glGetBufferSubData(GL_COPY_WRITE_BUFFER, 0, sizeof(read_back), read_back.data());
+
+        auto mismatches = 0u;
+        for (auto i = 0u; i < read_back.size(); ++i) {
+            mismatches += read_back[i] == i + 1 ? 0 : 1;
+        }
+
+        WOW_CHECK_MESSAGE(mismatches == 0, std::to_string(mismatches) + " values not visible after the fence");
+
+        uploads.shutdown();
+        WOW_CHECK(!uploads.is_active());
+        glDeleteBuffers(1, &buffer);
+    }
+
+    context->release_current();
+}
+
+WOW_TEST(upload_context_rejects_tasks_after_shutdown) {
+    upload_context uploads{};
+    uploads.shutdown();
+
+    auto ran = false;
+    WOW_CHECK(!uploads.submit([&ran] { ran = true; }));
+    WOW_CHECK(!ran);
+}
@@ -20,7 +20,9 @@ export enum JsEventType {
     SystemUpdateEvent = 18,
     FetchGameTimeRequest = 19,
     FetchGameTimeResponse = 20,
-    SoundUpdateEvent = 21
+    SoundUpdateEvent = 21,
+    StreamingStatsEvent = 22,
+    RenderStatsEvent = 23
 }
 
 export interface InitializeRequest {}
@@ -46,6 +48,8 @@ export interface SystemUpdateEvent { memory_usage: number; cpu_usage: number; gp
 export interface FetchGameTimeRequest {}
 export interface FetchGameTimeResponse { time_of_day: number; }
 export interface SoundUpdateEvent { sound_name: string; }
+export interface StreamingStatsEvent { requests: number; hits: number; misses: number; cancelled: number; queued: number; in_flight: number; average_latency_ms: number; max_latency_ms: number; resident_tiles: number; resident_cpu_bytes: number; resident_gpu_bytes: number; resident_vertex_bytes: number; }
+export interface RenderStatsEvent { draw_calls: number; texture_binds: number; buffer_binds: number; visible_chunks: number; culled_chunks: number; cull_time_ms: number; lod_triangles: number[]; dispatch_time_ms: number; dispatch_budget_ms: number; dispatch_queue_depth: number[]; dispatch_stalls: number[]; }
 
 export type JsEvent =
     | { type: JsEventType.None }
@@ -69,4 +73,6 @@ export type JsEvent =
     | { type: JsEventType.SystemUpdateEvent; system_update_event_data: SystemUpdateEvent }
     | { type: JsEventType.FetchGameTimeRequest; fetch_game_time_request_data: FetchGameTimeRequest }
     | { type: JsEventType.FetchGameTimeResponse; fetch_game_time_response_data: FetchGameTimeResponse }
-    | { type: JsEventType.SoundUpdateEvent; sound_update_event_data: SoundUpdateEvent };
\ No newline at end of file
+    | { type: JsEventType.SoundUpdateEvent; sound_update_event_data: SoundUpdateEvent }
+    | { type: JsEventType.StreamingStatsEvent; streaming_stats_event_data: StreamingStatsEvent }
+    | { type: JsEventType.RenderStatsEvent; render_stats_event_data: RenderStatsEvent };
\ No newline at end of file
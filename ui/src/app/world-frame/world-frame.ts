@@ -29,6 +29,32 @@ interface SystemStats {
     gpuMemTotal: number;
 }
 
+interface StreamingStats {
+    hits: number;
+    misses: number;
+    queued: number;
+    averageLatency: number;
+    maxLatency: number;
+    residentTiles: number;
+    residentCpu: number;
+    residentGpu: number;
+    residentVertex: number;
+}
+
+interface RenderStats {
+    drawCalls: number;
+    textureBinds: number;
+    bufferBinds: number;
+    visibleChunks: number;
+    culledChunks: number;
+    cullTime: number;
+    lodTriangles: number[];
+    dispatchTime: number;
+    dispatchBudget: number;
+    dispatchQueueDepth: number[];
+    dispatchStalls: number[];
+}
+
 @Component({
     selector: 'app-world-frame',
     imports: [CommonModule, LocaleNumberPipe],
@@ -43,6 +69,8 @@ export class WorldFrame implements OnInit, AfterViewInit, OnDestroy {
     protected timeOfDay$ = new BehaviorSubject<string>('00:00');
     protected currentStats$ = new BehaviorSubject<SystemStats | null>(null);
     protected currentSound$ = new BehaviorSubject<string | null>(null);
+    protected streamingStats$ = new BehaviorSubject<StreamingStats | null>(null);
+    protected renderStats$ = new BehaviorSubject<RenderStats | null>(null);
 
     @ViewChild('canvas', {static: true}) canvas!: ElementRef<HTMLCanvasElement>;
 
@@ -114,6 +142,40 @@ export class WorldFrame implements OnInit, AfterViewInit, OnDestroy {
                 this.currentSound$.next(event.sound_update_event_data.sound_name || null);
             }
         });
+
+        this.eventService.listenForEvent(JsEventType.StreamingStatsEvent, (event: JsEvent) => {
+            if (event.type === JsEventType.StreamingStatsEvent) {
+                this.streamingStats$.next({
+                    hits: Number(event.streaming_stats_event_data.hits) || 0,
+                    misses: Number(event.streaming_stats_event_data.misses) || 0,
+                    queued: Number(event.streaming_stats_event_data.queued) || 0,
+                    averageLatency: Number(event.streaming_stats_event_data.average_latency_ms) || 0,
+                    maxLatency: Number(event.streaming_stats_event_data.max_latency_ms) || 0,
+                    residentTiles: Number(event.streaming_stats_event_data.resident_tiles) || 0,
+                    residentCpu: Number(event.streaming_stats_event_data.resident_cpu_bytes) || 0,
+                    residentGpu: Number(event.streaming_stats_event_data.resident_gpu_bytes) || 0,
+                    residentVertex: Number(event.streaming_stats_event_data.resident_vertex_bytes) || 0
+                });
+            }
+        });
+
+        this.eventService.listenForEvent(JsEventType.RenderStatsEvent, (event: JsEvent) => {
+            if (event.type === JsEventType.RenderStatsEvent) {
+                this.renderStats$.next({
+                    drawCalls: Number(event.render_stats_event_data.draw_calls) || 0,
+                    textureBinds: Number(event.render_stats_event_data.texture_binds) || 0,
+                    bufferBinds: Number(event.render_stats_event_data.buffer_binds) || 0,
+                    visibleChunks: Number(event.render_stats_event_data.visible_chunks) || 0,
+                    culledChunks: Number(event.render_stats_event_data.culled_chunks) || 0,
+                    cullTime: Number(event.render_stats_event_data.cull_time_ms) || 0,
+                    lodTriangles: (event.render_stats_event_data.lod_triangles ?? []).map(count => Number(count) || 0),
+                    dispatchTime: Number(event.render_stats_event_data.dispatch_time_ms) || 0,
+                    dispatchBudget: Number(event.render_stats_event_data.dispatch_budget_ms) || 0,
+                    dispatchQueueDepth: (event.render_stats_event_data.dispatch_queue_depth ?? []).map(depth => Number(depth) || 0),
+                    dispatchStalls: (event.render_stats_event_data.dispatch_stalls ?? []).map(stalls => Number(stalls) || 0)
+                });
+            }
+        });
     }
 
     ngOnDestroy(): void {